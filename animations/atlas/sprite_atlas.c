@@ -0,0 +1,411 @@
+// Generated by python_scripts/pack_sprites.py - do not edit.
+// Run-length encoded sprites, decoded by bongo-cat-esp32/src/sprite_rle.cpp
+
+#ifdef __has_include
+    #if __has_include("lvgl.h")
+        #ifndef LV_LVGL_H_INCLUDE_SIMPLE
+            #define LV_LVGL_H_INCLUDE_SIMPLE
+        #endif
+    #endif
+#endif
+
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+    #include "lvgl.h"
+#else
+    #include "lvgl/lvgl.h"
+#endif
+
+#ifndef LV_ATTRIBUTE_MEM_ALIGN
+#define LV_ATTRIBUTE_MEM_ALIGN
+#endif
+
+// bodyeartwitch
+#ifndef LV_ATTRIBUTE_IMG_BODYEARTWITCH
+#define LV_ATTRIBUTE_IMG_BODYEARTWITCH
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_BODYEARTWITCH uint8_t bodyeartwitch_map[] = {
+  0x52, 0x02, 0x08, 0x0e, 0x37, 0x2b, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x01, 0x1d, 0x01, 0x00,
+  0x03, 0x1c, 0x01, 0x00, 0x1d, 0x01, 0x01, 0x1e, 0x01, 0x00, 0x03, 0x1b, 0x01, 0x00, 0x1c, 0x03,
+  0x01, 0x1f, 0x01, 0x00, 0x03, 0x19, 0x02, 0x00, 0x1b, 0x05, 0x01, 0x20, 0x01, 0x00, 0x03, 0x17,
+  0x02, 0x00, 0x19, 0x08, 0x01, 0x21, 0x02, 0x00, 0x03, 0x15, 0x02, 0x00, 0x17, 0x0c, 0x01, 0x23,
+  0x02, 0x00, 0x03, 0x13, 0x02, 0x00, 0x15, 0x10, 0x01, 0x25, 0x03, 0x00, 0x03, 0x12, 0x01, 0x00,
+  0x13, 0x15, 0x01, 0x28, 0x03, 0x00, 0x04, 0x11, 0x01, 0x00, 0x12, 0x19, 0x01, 0x2b, 0x02, 0x00,
+  0x31, 0x03, 0x00, 0x05, 0x10, 0x01, 0x00, 0x11, 0x1c, 0x01, 0x2d, 0x05, 0x00, 0x32, 0x02, 0x01,
+  0x34, 0x01, 0x00, 0x05, 0x0f, 0x01, 0x00, 0x10, 0x21, 0x01, 0x31, 0x01, 0x00, 0x32, 0x03, 0x01,
+  0x35, 0x01, 0x00, 0x05, 0x0e, 0x01, 0x00, 0x0f, 0x22, 0x01, 0x31, 0x01, 0x00, 0x32, 0x01, 0x01,
+  0x33, 0x03, 0x00, 0x05, 0x0d, 0x01, 0x00, 0x0e, 0x23, 0x01, 0x31, 0x02, 0x00, 0x33, 0x02, 0x01,
+  0x35, 0x01, 0x00, 0x03, 0x0c, 0x01, 0x00, 0x0d, 0x28, 0x01, 0x35, 0x01, 0x00, 0x03, 0x0c, 0x01,
+  0x00, 0x0d, 0x28, 0x01, 0x35, 0x01, 0x00, 0x03, 0x0b, 0x01, 0x00, 0x0c, 0x28, 0x01, 0x34, 0x01,
+  0x00, 0x03, 0x0a, 0x02, 0x00, 0x0c, 0x28, 0x01, 0x34, 0x01, 0x00, 0x03, 0x0a, 0x01, 0x00, 0x0b,
+  0x28, 0x01, 0x33, 0x01, 0x00, 0x03, 0x08, 0x05, 0x00, 0x0d, 0x27, 0x01, 0x34, 0x01, 0x00, 0x03,
+  0x0d, 0x04, 0x00, 0x11, 0x23, 0x01, 0x34, 0x01, 0x00, 0x03, 0x11, 0x04, 0x00, 0x15, 0x20, 0x01,
+  0x35, 0x01, 0x00, 0x03, 0x15, 0x04, 0x00, 0x19, 0x1c, 0x01, 0x35, 0x01, 0x00, 0x03, 0x19, 0x04,
+  0x00, 0x1d, 0x19, 0x01, 0x36, 0x01, 0x00, 0x03, 0x1d, 0x04, 0x00, 0x21, 0x15, 0x01, 0x36, 0x01,
+  0x00, 0x03, 0x21, 0x04, 0x00, 0x25, 0x11, 0x01, 0x36, 0x01, 0x00, 0x03, 0x25, 0x04, 0x00, 0x29,
+  0x0d, 0x01, 0x36, 0x01, 0x00, 0x03, 0x29, 0x04, 0x00, 0x2d, 0x0a, 0x01, 0x37, 0x01, 0x00, 0x03,
+  0x2d, 0x04, 0x00, 0x31, 0x06, 0x01, 0x37, 0x01, 0x00, 0x03, 0x31, 0x04, 0x00, 0x35, 0x02, 0x01,
+  0x37, 0x01, 0x00, 0x01, 0x35, 0x03, 0x00,
+};
+
+const lv_img_dsc_t bodyeartwitch = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  327,
+  bodyeartwitch_map,
+};
+
+// standardbody1
+#ifndef LV_ATTRIBUTE_IMG_STANDARDBODY1
+#define LV_ATTRIBUTE_IMG_STANDARDBODY1
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_STANDARDBODY1 uint8_t standardbody1_map[] = {
+  0x52, 0x02, 0x08, 0x0e, 0x37, 0x2b, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x01, 0x1d, 0x01, 0x00,
+  0x03, 0x1c, 0x01, 0x00, 0x1d, 0x01, 0x01, 0x1e, 0x01, 0x00, 0x03, 0x1b, 0x01, 0x00, 0x1c, 0x03,
+  0x01, 0x1f, 0x01, 0x00, 0x03, 0x19, 0x02, 0x00, 0x1b, 0x05, 0x01, 0x20, 0x01, 0x00, 0x03, 0x17,
+  0x02, 0x00, 0x19, 0x08, 0x01, 0x21, 0x02, 0x00, 0x03, 0x15, 0x02, 0x00, 0x17, 0x0c, 0x01, 0x23,
+  0x02, 0x00, 0x03, 0x13, 0x02, 0x00, 0x15, 0x10, 0x01, 0x25, 0x03, 0x00, 0x04, 0x12, 0x01, 0x00,
+  0x13, 0x15, 0x01, 0x28, 0x03, 0x00, 0x33, 0x03, 0x00, 0x06, 0x11, 0x01, 0x00, 0x12, 0x19, 0x01,
+  0x2b, 0x02, 0x00, 0x31, 0x02, 0x00, 0x33, 0x02, 0x01, 0x35, 0x01, 0x00, 0x05, 0x10, 0x01, 0x00,
+  0x11, 0x1c, 0x01, 0x2d, 0x04, 0x00, 0x31, 0x04, 0x01, 0x35, 0x01, 0x00, 0x03, 0x0f, 0x01, 0x00,
+  0x10, 0x25, 0x01, 0x35, 0x01, 0x00, 0x03, 0x0e, 0x01, 0x00, 0x0f, 0x26, 0x01, 0x35, 0x01, 0x00,
+  0x03, 0x0d, 0x01, 0x00, 0x0e, 0x27, 0x01, 0x35, 0x01, 0x00, 0x03, 0x0c, 0x01, 0x00, 0x0d, 0x28,
+  0x01, 0x35, 0x01, 0x00, 0x03, 0x0c, 0x01, 0x00, 0x0d, 0x28, 0x01, 0x35, 0x01, 0x00, 0x03, 0x0b,
+  0x01, 0x00, 0x0c, 0x28, 0x01, 0x34, 0x01, 0x00, 0x03, 0x0a, 0x02, 0x00, 0x0c, 0x28, 0x01, 0x34,
+  0x01, 0x00, 0x03, 0x0a, 0x01, 0x00, 0x0b, 0x28, 0x01, 0x33, 0x01, 0x00, 0x03, 0x08, 0x05, 0x00,
+  0x0d, 0x27, 0x01, 0x34, 0x01, 0x00, 0x03, 0x0d, 0x04, 0x00, 0x11, 0x23, 0x01, 0x34, 0x01, 0x00,
+  0x03, 0x11, 0x04, 0x00, 0x15, 0x20, 0x01, 0x35, 0x01, 0x00, 0x03, 0x15, 0x04, 0x00, 0x19, 0x1c,
+  0x01, 0x35, 0x01, 0x00, 0x03, 0x19, 0x04, 0x00, 0x1d, 0x19, 0x01, 0x36, 0x01, 0x00, 0x03, 0x1d,
+  0x04, 0x00, 0x21, 0x15, 0x01, 0x36, 0x01, 0x00, 0x03, 0x21, 0x04, 0x00, 0x25, 0x11, 0x01, 0x36,
+  0x01, 0x00, 0x03, 0x25, 0x04, 0x00, 0x29, 0x0d, 0x01, 0x36, 0x01, 0x00, 0x03, 0x29, 0x04, 0x00,
+  0x2d, 0x0a, 0x01, 0x37, 0x01, 0x00, 0x03, 0x2d, 0x04, 0x00, 0x31, 0x06, 0x01, 0x37, 0x01, 0x00,
+  0x03, 0x31, 0x04, 0x00, 0x35, 0x02, 0x01, 0x37, 0x01, 0x00, 0x01, 0x35, 0x03, 0x00,
+};
+
+const lv_img_dsc_t standardbody1 = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  318,
+  standardbody1_map,
+};
+
+// blink_face
+#ifndef LV_ATTRIBUTE_IMG_BLINK_FACE
+#define LV_ATTRIBUTE_IMG_BLINK_FACE
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_BLINK_FACE uint8_t blink_face_map[] = {
+  0x52, 0x01, 0x14, 0x1a, 0x26, 0x20, 0x00, 0x00, 0xff, 0x01, 0x14, 0x04, 0x00, 0x02, 0x15, 0x03,
+  0x00, 0x1a, 0x01, 0x00, 0x02, 0x1a, 0x01, 0x00, 0x1d, 0x01, 0x00, 0x02, 0x1b, 0x03, 0x00, 0x20,
+  0x01, 0x00, 0x01, 0x1e, 0x03, 0x00, 0x01, 0x23, 0x04, 0x00, 0x01, 0x24, 0x03, 0x00,
+};
+
+const lv_img_dsc_t blink_face = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  46,
+  blink_face_map,
+};
+
+// happy_face
+#ifndef LV_ATTRIBUTE_IMG_HAPPY_FACE
+#define LV_ATTRIBUTE_IMG_HAPPY_FACE
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_HAPPY_FACE uint8_t happy_face_map[] = {
+  0x52, 0x02, 0x14, 0x18, 0x26, 0x20, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x01, 0x15, 0x03, 0x00,
+  0x03, 0x14, 0x02, 0x00, 0x16, 0x01, 0x01, 0x17, 0x01, 0x00, 0x01, 0x14, 0x04, 0x00, 0x02, 0x15,
+  0x03, 0x00, 0x1a, 0x01, 0x00, 0x02, 0x1a, 0x01, 0x00, 0x1d, 0x01, 0x00, 0x03, 0x1b, 0x03, 0x00,
+  0x20, 0x01, 0x00, 0x24, 0x03, 0x00, 0x05, 0x1b, 0x01, 0x00, 0x1e, 0x03, 0x00, 0x23, 0x02, 0x00,
+  0x25, 0x01, 0x01, 0x26, 0x01, 0x00, 0x03, 0x1b, 0x01, 0x00, 0x1d, 0x02, 0x00, 0x23, 0x04, 0x00,
+  0x02, 0x1c, 0x02, 0x00, 0x24, 0x03, 0x00,
+};
+
+const lv_img_dsc_t happy_face = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  87,
+  happy_face_map,
+};
+
+// sleepy_face
+#ifndef LV_ATTRIBUTE_IMG_SLEEPY_FACE
+#define LV_ATTRIBUTE_IMG_SLEEPY_FACE
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_SLEEPY_FACE uint8_t sleepy_face_map[] = {
+  0x52, 0x01, 0x14, 0x1a, 0x27, 0x1f, 0x00, 0x00, 0xff, 0x02, 0x14, 0x01, 0x00, 0x18, 0x01, 0x00,
+  0x02, 0x14, 0x05, 0x00, 0x1a, 0x01, 0x00, 0x02, 0x1a, 0x01, 0x00, 0x1d, 0x01, 0x00, 0x02, 0x1b,
+  0x03, 0x00, 0x20, 0x01, 0x00, 0x03, 0x1e, 0x03, 0x00, 0x23, 0x01, 0x00, 0x27, 0x01, 0x00, 0x01,
+  0x23, 0x05, 0x00,
+};
+
+const lv_img_dsc_t sleepy_face = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  51,
+  sleepy_face_map,
+};
+
+// stock_face
+#ifndef LV_ATTRIBUTE_IMG_STOCK_FACE
+#define LV_ATTRIBUTE_IMG_STOCK_FACE
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_STOCK_FACE uint8_t stock_face_map[] = {
+  0x52, 0x02, 0x14, 0x18, 0x26, 0x20, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x01, 0x15, 0x03, 0x00,
+  0x03, 0x14, 0x02, 0x00, 0x16, 0x01, 0x01, 0x17, 0x01, 0x00, 0x01, 0x14, 0x04, 0x00, 0x02, 0x15,
+  0x03, 0x00, 0x1a, 0x01, 0x00, 0x02, 0x1a, 0x01, 0x00, 0x1d, 0x01, 0x00, 0x03, 0x1b, 0x03, 0x00,
+  0x20, 0x01, 0x00, 0x24, 0x03, 0x00, 0x04, 0x1e, 0x03, 0x00, 0x23, 0x02, 0x00, 0x25, 0x01, 0x01,
+  0x26, 0x01, 0x00, 0x01, 0x23, 0x04, 0x00, 0x01, 0x24, 0x03, 0x00,
+};
+
+const lv_img_dsc_t stock_face = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  75,
+  stock_face_map,
+};
+
+// table1
+#ifndef LV_ATTRIBUTE_IMG_TABLE1
+#define LV_ATTRIBUTE_IMG_TABLE1
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_TABLE1 uint8_t table1_map[] = {
+  0x52, 0x02, 0x00, 0x1e, 0x3f, 0x37, 0x00, 0x00, 0xff, 0x14, 0xa5, 0xff, 0x01, 0x00, 0x04, 0x00,
+  0x01, 0x04, 0x04, 0x00, 0x01, 0x08, 0x05, 0x00, 0x02, 0x03, 0x03, 0x00, 0x0d, 0x04, 0x00, 0x04,
+  0x03, 0x02, 0x00, 0x05, 0x01, 0x01, 0x06, 0x04, 0x00, 0x11, 0x04, 0x00, 0x04, 0x02, 0x02, 0x00,
+  0x04, 0x05, 0x01, 0x09, 0x05, 0x00, 0x15, 0x04, 0x00, 0x08, 0x02, 0x04, 0x00, 0x06, 0x02, 0x01,
+  0x08, 0x01, 0x00, 0x09, 0x03, 0x01, 0x0c, 0x01, 0x00, 0x0d, 0x01, 0x01, 0x0e, 0x03, 0x00, 0x19,
+  0x04, 0x00, 0x08, 0x01, 0x02, 0x00, 0x03, 0x03, 0x01, 0x06, 0x04, 0x00, 0x0a, 0x02, 0x01, 0x0c,
+  0x01, 0x00, 0x0d, 0x03, 0x01, 0x10, 0x05, 0x00, 0x1d, 0x04, 0x00, 0x0a, 0x01, 0x02, 0x00, 0x03,
+  0x04, 0x01, 0x07, 0x01, 0x00, 0x08, 0x02, 0x01, 0x0a, 0x04, 0x00, 0x0e, 0x01, 0x01, 0x0f, 0x03,
+  0x00, 0x12, 0x02, 0x01, 0x14, 0x05, 0x00, 0x21, 0x04, 0x00, 0x0a, 0x00, 0x04, 0x00, 0x04, 0x02,
+  0x01, 0x06, 0x01, 0x00, 0x07, 0x03, 0x01, 0x0a, 0x01, 0x00, 0x0b, 0x03, 0x01, 0x0e, 0x03, 0x00,
+  0x11, 0x08, 0x01, 0x19, 0x04, 0x00, 0x25, 0x04, 0x00, 0x0c, 0x00, 0x02, 0x00, 0x02, 0x02, 0x01,
+  0x04, 0x04, 0x00, 0x08, 0x02, 0x01, 0x0a, 0x01, 0x00, 0x0b, 0x03, 0x01, 0x0e, 0x01, 0x00, 0x0f,
+  0x02, 0x01, 0x11, 0x03, 0x00, 0x14, 0x08, 0x01, 0x1c, 0x04, 0x00, 0x29, 0x04, 0x00, 0x0e, 0x00,
+  0x01, 0x00, 0x01, 0x04, 0x01, 0x05, 0x01, 0x00, 0x06, 0x02, 0x01, 0x08, 0x04, 0x00, 0x0c, 0x02,
+  0x01, 0x0e, 0x01, 0x00, 0x0f, 0x03, 0x01, 0x12, 0x01, 0x00, 0x13, 0x01, 0x01, 0x14, 0x05, 0x00,
+  0x19, 0x07, 0x01, 0x20, 0x04, 0x00, 0x2d, 0x04, 0x00, 0x0e, 0x00, 0x02, 0x00, 0x02, 0x02, 0x01,
+  0x04, 0x01, 0x00, 0x05, 0x04, 0x01, 0x09, 0x01, 0x00, 0x0a, 0x02, 0x01, 0x0c, 0x03, 0x00, 0x0f,
+  0x03, 0x01, 0x12, 0x01, 0x00, 0x13, 0x04, 0x01, 0x17, 0x05, 0x00, 0x1c, 0x08, 0x01, 0x24, 0x04,
+  0x00, 0x31, 0x04, 0x00, 0x10, 0x00, 0x06, 0x00, 0x06, 0x02, 0x01, 0x08, 0x01, 0x00, 0x09, 0x04,
+  0x01, 0x0d, 0x01, 0x00, 0x0e, 0x01, 0x01, 0x0f, 0x04, 0x00, 0x13, 0x03, 0x01, 0x16, 0x01, 0x00,
+  0x17, 0x04, 0x01, 0x1b, 0x05, 0x00, 0x20, 0x03, 0x01, 0x23, 0x02, 0x00, 0x25, 0x03, 0x01, 0x28,
+  0x03, 0x00, 0x35, 0x04, 0x00, 0x10, 0x02, 0x08, 0x00, 0x0a, 0x02, 0x01, 0x0c, 0x01, 0x00, 0x0d,
+  0x04, 0x01, 0x11, 0x01, 0x00, 0x12, 0x01, 0x01, 0x13, 0x04, 0x00, 0x17, 0x03, 0x01, 0x1a, 0x01,
+  0x00, 0x1b, 0x04, 0x01, 0x1f, 0x05, 0x00, 0x24, 0x04, 0x01, 0x28, 0x01, 0x00, 0x29, 0x02, 0x01,
+  0x2b, 0x04, 0x00, 0x39, 0x04, 0x00, 0x0e, 0x06, 0x08, 0x00, 0x0e, 0x02, 0x01, 0x10, 0x01, 0x00,
+  0x11, 0x04, 0x01, 0x15, 0x06, 0x00, 0x1b, 0x03, 0x01, 0x1e, 0x01, 0x00, 0x1f, 0x04, 0x01, 0x23,
+  0x05, 0x00, 0x28, 0x04, 0x01, 0x2c, 0x01, 0x00, 0x2d, 0x02, 0x01, 0x2f, 0x04, 0x00, 0x3d, 0x03,
+  0x00, 0x0f, 0x0a, 0x08, 0x00, 0x12, 0x03, 0x01, 0x15, 0x01, 0x00, 0x16, 0x04, 0x01, 0x1a, 0x05,
+  0x00, 0x1f, 0x03, 0x01, 0x22, 0x01, 0x00, 0x23, 0x04, 0x01, 0x27, 0x03, 0x00, 0x2a, 0x02, 0x01,
+  0x2c, 0x01, 0x00, 0x2d, 0x03, 0x01, 0x30, 0x01, 0x00, 0x31, 0x02, 0x01, 0x33, 0x03, 0x00, 0x0f,
+  0x0e, 0x08, 0x00, 0x16, 0x03, 0x01, 0x19, 0x01, 0x00, 0x1a, 0x04, 0x01, 0x1e, 0x03, 0x00, 0x21,
+  0x01, 0x01, 0x22, 0x01, 0x00, 0x23, 0x03, 0x01, 0x26, 0x01, 0x00, 0x27, 0x03, 0x01, 0x2a, 0x04,
+  0x00, 0x2e, 0x02, 0x01, 0x30, 0x01, 0x00, 0x31, 0x03, 0x01, 0x34, 0x02, 0x00, 0x0d, 0x12, 0x08,
+  0x00, 0x1a, 0x03, 0x01, 0x1d, 0x01, 0x00, 0x1e, 0x03, 0x01, 0x21, 0x04, 0x00, 0x25, 0x01, 0x01,
+  0x26, 0x01, 0x00, 0x27, 0x03, 0x01, 0x2a, 0x01, 0x00, 0x2b, 0x03, 0x01, 0x2e, 0x04, 0x00, 0x32,
+  0x01, 0x01, 0x33, 0x02, 0x00, 0x0b, 0x16, 0x08, 0x00, 0x1e, 0x03, 0x01, 0x21, 0x01, 0x00, 0x22,
+  0x03, 0x01, 0x25, 0x03, 0x00, 0x28, 0x02, 0x01, 0x2a, 0x01, 0x00, 0x2b, 0x03, 0x01, 0x2e, 0x01,
+  0x00, 0x2f, 0x03, 0x01, 0x32, 0x03, 0x00, 0x09, 0x1a, 0x08, 0x00, 0x22, 0x03, 0x01, 0x25, 0x01,
+  0x00, 0x26, 0x02, 0x01, 0x28, 0x04, 0x00, 0x2c, 0x02, 0x01, 0x2e, 0x01, 0x00, 0x2f, 0x03, 0x01,
+  0x32, 0x02, 0x00, 0x07, 0x1e, 0x08, 0x00, 0x26, 0x03, 0x01, 0x29, 0x01, 0x00, 0x2a, 0x02, 0x01,
+  0x2c, 0x04, 0x00, 0x30, 0x02, 0x01, 0x32, 0x02, 0x00, 0x05, 0x22, 0x08, 0x00, 0x2a, 0x03, 0x01,
+  0x2d, 0x01, 0x00, 0x2e, 0x02, 0x01, 0x30, 0x03, 0x00, 0x03, 0x26, 0x08, 0x00, 0x2e, 0x03, 0x01,
+  0x31, 0x02, 0x00, 0x01, 0x2a, 0x09, 0x00, 0x01, 0x2e, 0x04, 0x00,
+};
+
+const lv_img_dsc_t table1 = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  683,
+  table1_map,
+};
+
+// leftpawdown
+#ifndef LV_ATTRIBUTE_IMG_LEFTPAWDOWN
+#define LV_ATTRIBUTE_IMG_LEFTPAWDOWN
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_LEFTPAWDOWN uint8_t leftpawdown_map[] = {
+  0x52, 0x03, 0x08, 0x16, 0x31, 0x31, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x15, 0xfc, 0xff, 0x01,
+  0x0b, 0x03, 0x00, 0x03, 0x0a, 0x01, 0x00, 0x0b, 0x03, 0x01, 0x0e, 0x01, 0x00, 0x05, 0x09, 0x01,
+  0x00, 0x0a, 0x01, 0x01, 0x0b, 0x01, 0x02, 0x0c, 0x03, 0x01, 0x0f, 0x01, 0x00, 0x05, 0x08, 0x01,
+  0x00, 0x09, 0x04, 0x01, 0x0d, 0x01, 0x02, 0x0e, 0x01, 0x01, 0x0f, 0x01, 0x00, 0x04, 0x08, 0x01,
+  0x00, 0x09, 0x01, 0x02, 0x0a, 0x06, 0x01, 0x10, 0x01, 0x00, 0x05, 0x08, 0x01, 0x00, 0x09, 0x02,
+  0x01, 0x0b, 0x02, 0x02, 0x0d, 0x03, 0x01, 0x10, 0x01, 0x00, 0x04, 0x08, 0x01, 0x00, 0x09, 0x02,
+  0x01, 0x0b, 0x02, 0x02, 0x0d, 0x04, 0x01, 0x02, 0x08, 0x01, 0x00, 0x09, 0x08, 0x01, 0x02, 0x08,
+  0x01, 0x00, 0x09, 0x08, 0x01, 0x02, 0x08, 0x01, 0x00, 0x09, 0x08, 0x01, 0x02, 0x08, 0x05, 0x00,
+  0x0d, 0x04, 0x01, 0x01, 0x0d, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x29, 0x08, 0x01, 0x02,
+  0x27, 0x02, 0x00, 0x29, 0x08, 0x01, 0x02, 0x27, 0x02, 0x00, 0x29, 0x09, 0x01, 0x02, 0x27, 0x01,
+  0x00, 0x28, 0x0a, 0x01, 0x03, 0x26, 0x02, 0x00, 0x28, 0x08, 0x01, 0x30, 0x02, 0x00, 0x03, 0x26,
+  0x01, 0x00, 0x27, 0x08, 0x01, 0x2f, 0x02, 0x00, 0x03, 0x25, 0x02, 0x00, 0x27, 0x07, 0x01, 0x2e,
+  0x02, 0x00, 0x03, 0x25, 0x01, 0x00, 0x26, 0x08, 0x01, 0x2e, 0x01, 0x00, 0x03, 0x25, 0x01, 0x00,
+  0x26, 0x07, 0x01, 0x2d, 0x02, 0x00, 0x03, 0x24, 0x02, 0x00, 0x26, 0x06, 0x01, 0x2c, 0x02, 0x00,
+  0x03, 0x24, 0x02, 0x00, 0x26, 0x05, 0x01, 0x2b, 0x02, 0x00, 0x01, 0x25, 0x06, 0x00,
+};
+
+const lv_img_dsc_t leftpawdown = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  238,
+  leftpawdown_map,
+};
+
+// rightpawdown
+#ifndef LV_ATTRIBUTE_IMG_RIGHTPAWDOWN
+#define LV_ATTRIBUTE_IMG_RIGHTPAWDOWN
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_RIGHTPAWDOWN uint8_t rightpawdown_map[] = {
+  0x52, 0x03, 0x04, 0x1b, 0x30, 0x29, 0xff, 0xff, 0xff, 0x00, 0x00, 0xff, 0x15, 0xfc, 0xff, 0x01,
+  0x0d, 0x01, 0x00, 0x01, 0x0d, 0x01, 0x00, 0x03, 0x0a, 0x02, 0x01, 0x0c, 0x03, 0x00, 0x2b, 0x03,
+  0x01, 0x05, 0x09, 0x02, 0x01, 0x0b, 0x05, 0x00, 0x2a, 0x01, 0x01, 0x2b, 0x03, 0x00, 0x2e, 0x01,
+  0x01, 0x07, 0x08, 0x02, 0x01, 0x0a, 0x07, 0x00, 0x29, 0x01, 0x01, 0x2a, 0x01, 0x00, 0x2b, 0x01,
+  0x02, 0x2c, 0x03, 0x00, 0x2f, 0x01, 0x01, 0x07, 0x07, 0x02, 0x01, 0x09, 0x09, 0x00, 0x28, 0x01,
+  0x01, 0x29, 0x04, 0x00, 0x2d, 0x01, 0x02, 0x2e, 0x01, 0x00, 0x2f, 0x01, 0x01, 0x06, 0x06, 0x02,
+  0x01, 0x08, 0x0a, 0x00, 0x28, 0x01, 0x01, 0x29, 0x01, 0x02, 0x2a, 0x06, 0x00, 0x30, 0x01, 0x01,
+  0x07, 0x06, 0x01, 0x01, 0x07, 0x0a, 0x00, 0x28, 0x01, 0x01, 0x29, 0x02, 0x00, 0x2b, 0x02, 0x02,
+  0x2d, 0x03, 0x00, 0x30, 0x01, 0x01, 0x07, 0x05, 0x02, 0x01, 0x07, 0x08, 0x00, 0x0f, 0x02, 0x01,
+  0x28, 0x01, 0x01, 0x29, 0x02, 0x00, 0x2b, 0x02, 0x02, 0x2d, 0x04, 0x00, 0x05, 0x05, 0x01, 0x01,
+  0x06, 0x09, 0x00, 0x0f, 0x01, 0x01, 0x28, 0x01, 0x01, 0x29, 0x08, 0x00, 0x05, 0x04, 0x01, 0x01,
+  0x05, 0x09, 0x00, 0x0e, 0x01, 0x01, 0x28, 0x01, 0x01, 0x29, 0x08, 0x00, 0x05, 0x04, 0x01, 0x01,
+  0x05, 0x08, 0x00, 0x0d, 0x02, 0x01, 0x28, 0x01, 0x01, 0x29, 0x08, 0x00, 0x05, 0x04, 0x02, 0x01,
+  0x06, 0x06, 0x00, 0x0c, 0x02, 0x01, 0x28, 0x01, 0x01, 0x29, 0x08, 0x00, 0x05, 0x05, 0x02, 0x01,
+  0x07, 0x04, 0x00, 0x0b, 0x02, 0x01, 0x29, 0x04, 0x01, 0x2d, 0x04, 0x00, 0x02, 0x07, 0x05, 0x01,
+  0x2d, 0x04, 0x01,
+};
+
+const lv_img_dsc_t rightpawdown = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  243,
+  rightpawdown_map,
+};
+
+// twopawsup
+#ifndef LV_ATTRIBUTE_IMG_TWOPAWSUP
+#define LV_ATTRIBUTE_IMG_TWOPAWSUP
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_TWOPAWSUP uint8_t twopawsup_map[] = {
+  0x52, 0x03, 0x08, 0x16, 0x30, 0x29, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x15, 0xfc, 0xff, 0x01,
+  0x0b, 0x03, 0x00, 0x03, 0x0a, 0x01, 0x00, 0x0b, 0x03, 0x01, 0x0e, 0x01, 0x00, 0x05, 0x09, 0x01,
+  0x00, 0x0a, 0x01, 0x01, 0x0b, 0x01, 0x02, 0x0c, 0x03, 0x01, 0x0f, 0x01, 0x00, 0x05, 0x08, 0x01,
+  0x00, 0x09, 0x04, 0x01, 0x0d, 0x01, 0x02, 0x0e, 0x01, 0x01, 0x0f, 0x01, 0x00, 0x04, 0x08, 0x01,
+  0x00, 0x09, 0x01, 0x02, 0x0a, 0x06, 0x01, 0x10, 0x01, 0x00, 0x05, 0x08, 0x01, 0x00, 0x09, 0x02,
+  0x01, 0x0b, 0x02, 0x02, 0x0d, 0x03, 0x01, 0x10, 0x01, 0x00, 0x04, 0x08, 0x01, 0x00, 0x09, 0x02,
+  0x01, 0x0b, 0x02, 0x02, 0x0d, 0x04, 0x01, 0x03, 0x08, 0x01, 0x00, 0x09, 0x08, 0x01, 0x2b, 0x03,
+  0x00, 0x05, 0x08, 0x01, 0x00, 0x09, 0x08, 0x01, 0x2a, 0x01, 0x00, 0x2b, 0x03, 0x01, 0x2e, 0x01,
+  0x00, 0x07, 0x08, 0x01, 0x00, 0x09, 0x08, 0x01, 0x29, 0x01, 0x00, 0x2a, 0x01, 0x01, 0x2b, 0x01,
+  0x02, 0x2c, 0x03, 0x01, 0x2f, 0x01, 0x00, 0x07, 0x08, 0x05, 0x00, 0x0d, 0x04, 0x01, 0x28, 0x01,
+  0x00, 0x29, 0x04, 0x01, 0x2d, 0x01, 0x02, 0x2e, 0x01, 0x01, 0x2f, 0x01, 0x00, 0x05, 0x0d, 0x04,
+  0x00, 0x28, 0x01, 0x00, 0x29, 0x01, 0x02, 0x2a, 0x06, 0x01, 0x30, 0x01, 0x00, 0x05, 0x28, 0x01,
+  0x00, 0x29, 0x02, 0x01, 0x2b, 0x02, 0x02, 0x2d, 0x03, 0x01, 0x30, 0x01, 0x00, 0x04, 0x28, 0x01,
+  0x00, 0x29, 0x02, 0x01, 0x2b, 0x02, 0x02, 0x2d, 0x04, 0x01, 0x02, 0x28, 0x01, 0x00, 0x29, 0x08,
+  0x01, 0x02, 0x28, 0x01, 0x00, 0x29, 0x08, 0x01, 0x02, 0x28, 0x01, 0x00, 0x29, 0x08, 0x01, 0x02,
+  0x28, 0x01, 0x00, 0x29, 0x08, 0x01, 0x02, 0x29, 0x04, 0x00, 0x2d, 0x04, 0x01, 0x01, 0x2d, 0x04,
+  0x00,
+};
+
+const lv_img_dsc_t twopawsup = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  257,
+  twopawsup_map,
+};
+
+// left_click_effect
+#ifndef LV_ATTRIBUTE_IMG_LEFT_CLICK_EFFECT
+#define LV_ATTRIBUTE_IMG_LEFT_CLICK_EFFECT
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_LEFT_CLICK_EFFECT uint8_t left_click_effect_map[] = {
+  0x52, 0x01, 0x1d, 0x29, 0x34, 0x38, 0x15, 0xfc, 0xff, 0x01, 0x1f, 0x01, 0x00, 0x01, 0x20, 0x02,
+  0x00, 0x01, 0x22, 0x03, 0x00, 0x00, 0x00, 0x01, 0x1e, 0x06, 0x00, 0x02, 0x1d, 0x01, 0x00, 0x2f,
+  0x06, 0x00, 0x00, 0x00, 0x02, 0x23, 0x02, 0x00, 0x2d, 0x01, 0x00, 0x03, 0x23, 0x01, 0x00, 0x29,
+  0x01, 0x00, 0x2e, 0x02, 0x00, 0x03, 0x22, 0x01, 0x00, 0x29, 0x01, 0x00, 0x2f, 0x03, 0x00, 0x02,
+  0x21, 0x02, 0x00, 0x29, 0x01, 0x00, 0x02, 0x21, 0x01, 0x00, 0x29, 0x01, 0x00, 0x01, 0x29, 0x01,
+  0x00, 0x01, 0x29, 0x01, 0x00,
+};
+
+const lv_img_dsc_t left_click_effect = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  85,
+  left_click_effect_map,
+};
+
+// right_click_effect
+#ifndef LV_ATTRIBUTE_IMG_RIGHT_CLICK_EFFECT
+#define LV_ATTRIBUTE_IMG_RIGHT_CLICK_EFFECT
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_RIGHT_CLICK_EFFECT uint8_t right_click_effect_map[] = {
+  0x52, 0x01, 0x00, 0x20, 0x13, 0x30, 0x15, 0xfc, 0xff, 0x01, 0x01, 0x02, 0x00, 0x01, 0x02, 0x02,
+  0x00, 0x01, 0x03, 0x02, 0x00, 0x01, 0x04, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00, 0x01,
+  0x0f, 0x05, 0x00, 0x00, 0x01, 0x03, 0x02, 0x00, 0x02, 0x02, 0x02, 0x00, 0x0c, 0x02, 0x00, 0x03,
+  0x02, 0x01, 0x00, 0x08, 0x01, 0x00, 0x0d, 0x03, 0x00, 0x03, 0x01, 0x01, 0x00, 0x08, 0x01, 0x00,
+  0x10, 0x02, 0x00, 0x02, 0x01, 0x01, 0x00, 0x08, 0x01, 0x00, 0x01, 0x08, 0x01, 0x00, 0x01, 0x08,
+  0x01, 0x00, 0x01, 0x08, 0x01, 0x00,
+};
+
+const lv_img_dsc_t right_click_effect = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  86,
+  right_click_effect_map,
+};
+
+// sleepy1
+#ifndef LV_ATTRIBUTE_IMG_SLEEPY1
+#define LV_ATTRIBUTE_IMG_SLEEPY1
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_SLEEPY1 uint8_t sleepy1_map[] = {
+  0x52, 0x01, 0x25, 0x01, 0x3b, 0x11, 0xca, 0xfd, 0xff, 0x01, 0x33, 0x08, 0x00, 0x01, 0x38, 0x01,
+  0x00, 0x01, 0x37, 0x02, 0x00, 0x01, 0x36, 0x02, 0x00, 0x01, 0x36, 0x01, 0x00, 0x01, 0x35, 0x01,
+  0x00, 0x02, 0x2c, 0x08, 0x00, 0x35, 0x07, 0x00, 0x01, 0x32, 0x02, 0x00, 0x01, 0x31, 0x02, 0x00,
+  0x01, 0x30, 0x02, 0x00, 0x01, 0x30, 0x01, 0x00, 0x02, 0x25, 0x08, 0x00, 0x2f, 0x07, 0x00, 0x03,
+  0x25, 0x01, 0x00, 0x2b, 0x02, 0x00, 0x2f, 0x03, 0x00, 0x01, 0x2a, 0x01, 0x00, 0x01, 0x28, 0x02,
+  0x00, 0x01, 0x27, 0x02, 0x00, 0x01, 0x26, 0x09, 0x00,
+};
+
+const lv_img_dsc_t sleepy1 = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  89,
+  sleepy1_map,
+};
+
+// sleepy2
+#ifndef LV_ATTRIBUTE_IMG_SLEEPY2
+#define LV_ATTRIBUTE_IMG_SLEEPY2
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_SLEEPY2 uint8_t sleepy2_map[] = {
+  0x52, 0x01, 0x26, 0x01, 0x3d, 0x11, 0xca, 0xfd, 0xff, 0x01, 0x34, 0x08, 0x00, 0x01, 0x39, 0x01,
+  0x00, 0x01, 0x38, 0x02, 0x00, 0x01, 0x37, 0x02, 0x00, 0x01, 0x36, 0x08, 0x00, 0x01, 0x36, 0x03,
+  0x00, 0x01, 0x2d, 0x08, 0x00, 0x01, 0x33, 0x02, 0x00, 0x01, 0x32, 0x02, 0x00, 0x01, 0x31, 0x02,
+  0x00, 0x01, 0x31, 0x01, 0x00, 0x02, 0x26, 0x08, 0x00, 0x30, 0x07, 0x00, 0x03, 0x26, 0x01, 0x00,
+  0x2c, 0x02, 0x00, 0x30, 0x03, 0x00, 0x01, 0x2b, 0x01, 0x00, 0x01, 0x29, 0x02, 0x00, 0x01, 0x28,
+  0x02, 0x00, 0x01, 0x27, 0x09, 0x00,
+};
+
+const lv_img_dsc_t sleepy2 = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  86,
+  sleepy2_map,
+};
+
+// sleepy3
+#ifndef LV_ATTRIBUTE_IMG_SLEEPY3
+#define LV_ATTRIBUTE_IMG_SLEEPY3
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_SLEEPY3 uint8_t sleepy3_map[] = {
+  0x52, 0x01, 0x26, 0x00, 0x3d, 0x10, 0xca, 0xfd, 0xff, 0x01, 0x34, 0x08, 0x00, 0x01, 0x39, 0x01,
+  0x00, 0x01, 0x38, 0x02, 0x00, 0x01, 0x37, 0x02, 0x00, 0x01, 0x36, 0x08, 0x00, 0x01, 0x36, 0x03,
+  0x00, 0x01, 0x2d, 0x08, 0x00, 0x01, 0x33, 0x02, 0x00, 0x01, 0x32, 0x02, 0x00, 0x01, 0x31, 0x02,
+  0x00, 0x01, 0x31, 0x01, 0x00, 0x02, 0x26, 0x08, 0x00, 0x30, 0x07, 0x00, 0x03, 0x26, 0x01, 0x00,
+  0x2c, 0x02, 0x00, 0x30, 0x03, 0x00, 0x01, 0x2b, 0x01, 0x00, 0x01, 0x29, 0x02, 0x00, 0x01, 0x28,
+  0x02, 0x00, 0x01, 0x27, 0x09, 0x00,
+};
+
+const lv_img_dsc_t sleepy3 = {
+  {LV_IMG_CF_USER_ENCODED_0, 0, 0, 64, 64},  // header: {cf, always_zero, reserved, w, h}
+  86,
+  sleepy3_map,
+};
+
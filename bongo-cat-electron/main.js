@@ -25,6 +25,16 @@ let keyboardMonitor;
 // Monitoring state
 let monitoringActive = false;
 
+// Stats to the ESP32: every second while typing (keeps SPEED fresh on the
+// device), right away on a typing edge or a CPU/RAM change beyond the
+// monitor's deadband, and otherwise only as a keepalive. The keepalive must
+// stay well under the firmware's PYTHON_TIMEOUT_MS (animation_table.h): if
+// the device hears nothing for that long it drops host control and turns
+// auto idle progression back on, which STOP had switched off.
+const STATS_TYPING_INTERVAL = 1000;
+const ESP32_PYTHON_TIMEOUT_MS = 5000;
+const STATS_KEEPALIVE_INTERVAL = ESP32_PYTHON_TIMEOUT_MS / 2;
+
 // Development mode indicator
 if (isDev) {
   console.log('Running in development mode');
@@ -163,14 +173,26 @@ function setupEventForwarding() {
   // Combined stats handler for ESP32 protocol
   let lastSystemStats = { cpu: 0, memory: 0 };
   let lastTypingStats = { wpm: 0, isActive: false };
+  let statsTimer = null;
+  
+  const sendStats = () => {
+    if (statsTimer) {
+      clearTimeout(statsTimer);
+    }
+    if (esp32SerialManager && esp32SerialManager.isConnected) {
+      esp32SerialManager.sendCombinedStats(lastSystemStats, lastTypingStats);
+    }
+    statsTimer = setTimeout(sendStats, lastTypingStats.isActive ? STATS_TYPING_INTERVAL : STATS_KEEPALIVE_INTERVAL);
+  };
   
   eventEmitter.on('system-stats', (stats) => {
     if (mainWindow && !mainWindow.isDestroyed()) {
       mainWindow.webContents.send('system-stats', stats);
     }
     
-    // Cache system stats for combined sending
+    // Only emitted when CPU/RAM moved beyond the deadband
     lastSystemStats = stats;
+    sendStats();
   });
   
   eventEmitter.on('typing-stats', (stats) => {
@@ -182,7 +204,22 @@ function setupEventForwarding() {
     }
     
     // Cache typing stats for combined sending
+    const typingEdge = Boolean(stats.isActive) !== Boolean(lastTypingStats.isActive);
     lastTypingStats = stats;
+    if (systemMonitor) {
+      systemMonitor.setTypingActive(Boolean(stats.isActive));
+    }
+    if (typingEdge) {
+      // Start / stop the paws now, not at the next tick
+      sendStats();
+    }
+  });
+  
+  // Per-key paw strikes (only sent to cats that negotiated PROTO:KEYS)
+  eventEmitter.on('key-down', (event) => {
+    if (esp32SerialManager) {
+      esp32SerialManager.sendKeyEvent(event);
+    }
   });
   
   // Handle keyboard fallback notifications
@@ -193,21 +230,21 @@ function setupEventForwarding() {
     }
   });
   
-  // FAST STATS SENDING - Responsive like Python app
-  setInterval(() => {
-    if (esp32SerialManager && esp32SerialManager.getConnectionStatus().isConnected) {
-      // Send stats more frequently during active typing (like Python app)
-      const isTypingActive = lastTypingStats && lastTypingStats.isActive;
-      esp32SerialManager.sendCombinedStats(lastSystemStats, lastTypingStats);
+  // Sampled once, the same tick goes to every connected cat
+  eventEmitter.on('connection-change', (data) => {
+    if (data.connected) {
+      sendStats();
     }
-  }, 1000); // 1 second for responsive animations (was 2000ms)
+  });
+  sendStats();
   
   // Auto-start monitoring when app is ready
   setTimeout(async () => {
     try {
       console.log('🚀 Auto-starting system monitoring...');
       if (systemMonitor) {
-        await systemMonitor.startMonitoring(2000); // 2-second intervals
+        systemMonitor.setDeadband(settingsManager.getStatsDeadband());
+        await systemMonitor.startMonitoring(settingsManager.getUpdateInterval());
         console.log('✅ System monitoring started automatically');
       }
       
@@ -320,12 +357,13 @@ ipcMain.handle('connect-to-device', async (event, port) => {
   }
 });
 
-ipcMain.handle('disconnect-device', async () => {
+ipcMain.handle('disconnect-device', async (event, port) => {
   try {
     if (!esp32SerialManager) {
       throw new Error('Serial manager not initialized');
     }
-    return await esp32SerialManager.disconnect();
+    // One port, or every connected cat without one
+    return await esp32SerialManager.disconnect(port || null);
   } catch (error) {
     console.error('Disconnect device error:', error);
     throw error;
@@ -345,6 +383,20 @@ ipcMain.handle('send-serial-data', async (event, data) => {
   }
 });
 
+ipcMain.handle('get-serial-queue-stats', async (event, reset) => {
+  if (!esp32SerialManager) {
+    throw new Error('Serial manager not initialized');
+  }
+  return esp32SerialManager.getQueueStats(Boolean(reset));
+});
+
+ipcMain.handle('get-sensor-history', async () => {
+  if (!esp32SerialManager) {
+    throw new Error('Serial manager not initialized');
+  }
+  return await esp32SerialManager.readSensorHistory();
+});
+
 // System Monitoring Handlers
 ipcMain.handle('get-system-stats', async () => {
   try {
@@ -451,6 +503,30 @@ ipcMain.handle('get-settings', async () => {
   }
 });
 
+// Idle sample interval and stats deadband of the system monitor
+function applyMonitoringSettings(settings) {
+  if (!systemMonitor) {
+    return;
+  }
+  
+  if (settings.updateInterval && systemMonitor.isActive()) {
+    try {
+      systemMonitor.updateInterval(settings.updateInterval);
+    } catch (error) {
+      console.error('Failed to update monitoring interval:', error);
+      // Don't throw - this shouldn't prevent other settings from applying
+    }
+  }
+  
+  if (settings.statsDeadband !== undefined) {
+    try {
+      systemMonitor.setDeadband(settings.statsDeadband);
+    } catch (error) {
+      console.error('Failed to update stats deadband:', error);
+    }
+  }
+}
+
 ipcMain.handle('apply-settings', async (event, settings) => {
   try {
     console.log('Applying settings temporarily (not saving to disk):', settings);
@@ -468,14 +544,7 @@ ipcMain.handle('apply-settings', async (event, settings) => {
     });
     
     // Apply settings that affect monitoring without saving to disk
-    if (settings.updateInterval && systemMonitor && systemMonitor.isActive()) {
-      try {
-        systemMonitor.updateInterval(settings.updateInterval);
-      } catch (error) {
-        console.error('Failed to update monitoring interval:', error);
-        // Don't throw - this shouldn't prevent other settings from applying
-      }
-    }
+    applyMonitoringSettings(settings);
     
     // Send settings to ESP32 device if connected
     if (esp32SerialManager && esp32SerialManager.isConnected) {
@@ -506,14 +575,7 @@ ipcMain.handle('save-settings', async (event, settings) => {
     const success = settingsManager.updateSettings(settings);
     
     // Apply settings that affect monitoring
-    if (settings.updateInterval && systemMonitor && systemMonitor.isActive()) {
-      try {
-        systemMonitor.updateInterval(settings.updateInterval);
-      } catch (error) {
-        console.error('Failed to update monitoring interval:', error);
-        // Don't throw - this shouldn't prevent other settings from applying
-      }
-    }
+    applyMonitoringSettings(settings);
     
     // Send settings to ESP32 device if connected
     if (esp32SerialManager && esp32SerialManager.isConnected) {
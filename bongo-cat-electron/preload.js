@@ -10,8 +10,10 @@ contextBridge.exposeInMainWorld('electronAPI', {
   // Serial communication (to be implemented)
   getSerialPorts: () => ipcRenderer.invoke('get-serial-ports'),
   connectToDevice: (port) => ipcRenderer.invoke('connect-to-device', port),
-  disconnectDevice: () => ipcRenderer.invoke('disconnect-device'),
+  disconnectDevice: (port) => ipcRenderer.invoke('disconnect-device', port),
   sendSerialData: (data) => ipcRenderer.invoke('send-serial-data', data),
+  getSerialQueueStats: (reset) => ipcRenderer.invoke('get-serial-queue-stats', reset),
+  getSensorHistory: () => ipcRenderer.invoke('get-sensor-history'),
 
   // System monitoring (to be implemented)
   getSystemStats: () => ipcRenderer.invoke('get-system-stats'),
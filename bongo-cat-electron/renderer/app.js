@@ -29,7 +29,7 @@ const sleepTimeout = document.getElementById('sleepTimeout');
 
 // Application state
 let isConnected = false;
-let currentPort = null;
+let connectedPorts = [];   // Every cat currently connected
 
 // Initialize the application
 async function initializeApp() {
@@ -65,6 +65,7 @@ function setupEventListeners() {
     // Connection controls
     connectBtn.addEventListener('click', toggleConnection);
     refreshBtn.addEventListener('click', refreshSerialPorts);
+    portSelect.addEventListener('change', updateConnectButton);
     
 
     
@@ -84,7 +85,7 @@ function setupEventListeners() {
     
     // Electron API event listeners
     window.electronAPI.onConnectionChange((event, data) => {
-        updateConnectionStatus(data.connected, data.port);
+        updateConnectionStatus(data.connected, data.ports || (data.port ? [data.port] : []));
     });
     
     window.electronAPI.onSystemStats((event, stats) => {
@@ -126,6 +127,7 @@ async function refreshSerialPorts() {
             option.textContent = `${port.path} - ${port.manufacturer || 'Unknown'}`;
             portSelect.appendChild(option);
         });
+        updateConnectButton();
         
 
         
@@ -135,30 +137,24 @@ async function refreshSerialPorts() {
     }
 }
 
-// Toggle device connection
+// Toggle the selected port: connect another cat or disconnect this one
+// (with no port selected, disconnect all)
 async function toggleConnection() {
     try {
-        if (isConnected) {
+        const selectedPort = portSelect.value;
+        if (connectedPorts.includes(selectedPort) || (!selectedPort && isConnected)) {
             // Disconnect
-            await window.electronAPI.disconnectDevice();
+            await window.electronAPI.disconnectDevice(selectedPort || null);
 
         } else {
             // Connect
-            const selectedPort = portSelect.value;
             if (!selectedPort) {
 
                 return;
             }
             
 
-            const result = await window.electronAPI.connectToDevice(selectedPort);
-            
-            if (result.success) {
-                currentPort = selectedPort;
-
-            } else {
-
-            }
+            await window.electronAPI.connectToDevice(selectedPort);
         }
     } catch (error) {
         console.error('Connection error:', error);
@@ -167,25 +163,34 @@ async function toggleConnection() {
 }
 
 // Update connection status UI
-function updateConnectionStatus(connected, port) {
+function updateConnectionStatus(connected, ports) {
     isConnected = connected;
-    currentPort = port;
+    connectedPorts = ports;
     
     const statusDot = connectionStatus.querySelector('.status-dot');
     const statusText = connectionStatus.querySelector('.status-text');
     
     if (connected) {
         statusDot.className = 'status-dot connected';
-        statusText.textContent = `Connected to ${port}`;
-        connectBtn.textContent = 'Disconnect';
-        connectBtn.className = 'btn btn-danger';
-        connectionInfo.innerHTML = `<p>Connected to ESP32 on port ${port}</p>`;
+        statusText.textContent = ports.length > 1 ? `Connected to ${ports.length} devices` : `Connected to ${ports[0]}`;
+        connectionInfo.innerHTML = `<p>Connected to ESP32 on port ${ports.join(', ')}</p>`;
     } else {
         statusDot.className = 'status-dot disconnected';
         statusText.textContent = 'Disconnected';
+        connectionInfo.innerHTML = '<p>Select a port and click Connect to start monitoring</p>';
+    }
+    updateConnectButton();
+}
+
+// Connect for a new port, Disconnect for a connected one
+function updateConnectButton() {
+    const selectedPort = portSelect.value;
+    if (connectedPorts.includes(selectedPort) || (!selectedPort && isConnected)) {
+        connectBtn.textContent = 'Disconnect';
+        connectBtn.className = 'btn btn-danger';
+    } else {
         connectBtn.textContent = 'Connect';
         connectBtn.className = 'btn btn-primary';
-        connectionInfo.innerHTML = '<p>Select a port and click Connect to start monitoring</p>';
     }
 }
 
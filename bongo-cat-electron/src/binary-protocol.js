@@ -0,0 +1,174 @@
+/**
+ * Binary framing shared with the ESP32 firmware
+ * (keep in sync with bongo-cat-esp32/include/binary_protocol.h)
+ *
+ *   [0xA5] [len] [type] [payload: len bytes] [crc16 lo] [crc16 hi]
+ *
+ * CRC-16/CCITT-FALSE over len, type and payload. Multi-byte fields are
+ * little endian. Negotiated with PROTO:BIN -> PROTO:BIN_OK, KEYS frames
+ * additionally with PROTO:KEYS -> PROTO:KEYS_OK.
+ */
+
+const FRAME_START = 0xA5;
+const MAX_PAYLOAD = 32;
+
+const FRAME_TYPE = {
+    STATS: 0x01,
+    KEYS: 0x02
+};
+
+const STATS_FLAGS = {
+    TYPING: 0x01,
+    STREAK: 0x02
+};
+
+// KEYS payload: one byte per key-down, oldest first - ms since the previous
+// key in the frame (0 for the first) plus KEY_RIGHT for the right paw
+const KEYS_MAX = 16;
+const KEY_RIGHT = 0x80;
+const KEY_GAP_MASK = 0x7F;
+
+/**
+ * CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ */
+function crc16(buffer, crc = 0xFFFF) {
+    for (const byte of buffer) {
+        crc ^= byte << 8;
+        for (let bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+            crc &= 0xFFFF;
+        }
+    }
+    return crc;
+}
+
+/**
+ * Build a complete frame around a payload
+ */
+function encodeFrame(type, payload) {
+    if (payload.length > MAX_PAYLOAD) {
+        throw new Error(`Payload too large: ${payload.length} > ${MAX_PAYLOAD}`);
+    }
+
+    const frame = Buffer.alloc(payload.length + 5);
+    frame[0] = FRAME_START;
+    frame[1] = payload.length;
+    frame[2] = type;
+    payload.copy(frame, 3);
+
+    const crc = crc16(frame.subarray(1, 3 + payload.length));
+    frame.writeUInt16LE(crc, 3 + payload.length);
+    return frame;
+}
+
+const clampByte = (value) => Math.max(0, Math.min(255, Math.round(value || 0)));
+const clampWord = (value) => Math.max(0, Math.min(0xFFFF, Math.round(value || 0)));
+
+/**
+ * One STATS frame replaces the STATS, SPEED and STREAK_* lines
+ */
+function encodeStatsFrame({ cpu, ram, wpm, speed, typing, streak }) {
+    const payload = Buffer.alloc(7);
+    payload[0] = clampByte(cpu);
+    payload[1] = clampByte(ram);
+    payload.writeUInt16LE(clampWord(wpm), 2);
+    payload.writeUInt16LE(clampWord(speed), 4);
+    payload[6] = (typing ? STATS_FLAGS.TYPING : 0) | (streak ? STATS_FLAGS.STREAK : 0);
+    return encodeFrame(FRAME_TYPE.STATS, payload);
+}
+
+/**
+ * Key-down events ({ timestamp, right }, oldest first, at most KEYS_MAX)
+ */
+function encodeKeysFrame(events) {
+    if (events.length === 0 || events.length > KEYS_MAX) {
+        throw new Error(`Key batch must hold 1-${KEYS_MAX} events, got ${events.length}`);
+    }
+
+    const payload = Buffer.alloc(events.length);
+    events.forEach((event, i) => {
+        const gap = i === 0 ? 0 : event.timestamp - events[i - 1].timestamp;
+        payload[i] = Math.max(0, Math.min(KEY_GAP_MASK, Math.round(gap))) | (event.right ? KEY_RIGHT : 0);
+    });
+    return encodeFrame(FRAME_TYPE.KEYS, payload);
+}
+
+// SENSOR_DUMP blob (bongo-cat-esp32/include/sensor_history.h)
+const SENSOR_HISTORY_MAGIC = 0x48; // 'H'
+const SENSOR_HISTORY_VERSION = 1;
+const SENSOR_HISTORY_HEADER_SIZE = 9;
+const SENSOR_HISTORY_RAW_SIZE = 8;
+const SENSOR_HISTORY_BUCKET_SIZE = 18;
+
+function decodeSensorBucket(blob, offset) {
+    return {
+        start: blob.readUInt32LE(offset),           // s since boot
+        readings: blob.readUInt16LE(offset + 4),
+        temperature: {
+            min: blob.readInt16LE(offset + 6) / 100,
+            max: blob.readInt16LE(offset + 8) / 100,
+            mean: blob.readInt16LE(offset + 10) / 100
+        },
+        humidity: {
+            min: blob.readUInt16LE(offset + 12) / 100,
+            max: blob.readUInt16LE(offset + 14) / 100,
+            mean: blob.readUInt16LE(offset + 16) / 100
+        }
+    };
+}
+
+/**
+ * Decode the blob the SENSOR_DATA lines of a SENSOR_DUMP carry.
+ * Times are seconds since the device booted (uptime is "now").
+ */
+function decodeSensorHistory(blob) {
+    if (blob.length < SENSOR_HISTORY_HEADER_SIZE || blob[0] !== SENSOR_HISTORY_MAGIC || blob[1] !== SENSOR_HISTORY_VERSION) {
+        throw new Error('Not a sensor history blob');
+    }
+
+    const rawCount = blob[6];
+    const minuteCount = blob[7];
+    const hourCount = blob[8];
+    const size = SENSOR_HISTORY_HEADER_SIZE + rawCount * SENSOR_HISTORY_RAW_SIZE +
+        (minuteCount + hourCount) * SENSOR_HISTORY_BUCKET_SIZE;
+    if (blob.length !== size) {
+        throw new Error(`Sensor history is ${blob.length} bytes, header says ${size}`);
+    }
+
+    let offset = SENSOR_HISTORY_HEADER_SIZE;
+    const raw = [];
+    for (let i = 0; i < rawCount; i++, offset += SENSOR_HISTORY_RAW_SIZE) {
+        raw.push({
+            time: blob.readUInt32LE(offset),
+            temperature: blob.readInt16LE(offset + 4) / 100,
+            humidity: blob.readUInt16LE(offset + 6) / 100
+        });
+    }
+
+    const readBuckets = (count) => {
+        const buckets = [];
+        for (let i = 0; i < count; i++, offset += SENSOR_HISTORY_BUCKET_SIZE) {
+            buckets.push(decodeSensorBucket(blob, offset));
+        }
+        return buckets;
+    };
+    const minutes = readBuckets(minuteCount);
+    const hours = readBuckets(hourCount);
+
+    return { uptime: blob.readUInt32LE(2), raw, minutes, hours };
+}
+
+module.exports = {
+    FRAME_START,
+    MAX_PAYLOAD,
+    FRAME_TYPE,
+    STATS_FLAGS,
+    KEYS_MAX,
+    KEY_RIGHT,
+    KEY_GAP_MASK,
+    crc16,
+    encodeFrame,
+    encodeStatsFrame,
+    encodeKeysFrame,
+    decodeSensorHistory
+};
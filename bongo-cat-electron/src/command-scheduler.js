@@ -0,0 +1,216 @@
+/**
+ * Latest-value-wins command scheduler for the ESP32 link
+ *
+ * Commands that describe state (stats, animation speed, streak, time) carry
+ * a coalescing key: a newer command with the same key replaces the pending
+ * one in place instead of queueing behind it, so a slow link only ever
+ * delivers the newest state. Everything else (PING, PROTO:BIN, settings,
+ * SAVE_SETTINGS) keeps its own slot in FIFO order.
+ *
+ * Pending commands are written by priority class, oldest first within a
+ * class: key events first (they also skip the rate limit, see isUrgent),
+ * then animation-critical commands, stats, and finally TIME: and settings.
+ *
+ * A command may be a function returning the Buffer/string to write (or null
+ * to skip it); it is called at write time, which lets key events batch up
+ * until their frame actually goes out.
+ */
+
+const PRIORITY = {
+    URGENT: 0,      // Key event batches
+    ANIMATION: 1,   // SPEED / STOP / STREAK_* / binary STATS frames / control
+    STATS: 2,       // STATS, CPU, RAM, WPM
+    BACKGROUND: 3   // TIME and settings
+};
+
+// Latency samples kept for the percentile
+const LATENCY_WINDOW = 64;
+
+/**
+ * Coalescing key and priority of a command (key null = never coalesced)
+ */
+function classifyCommand(command) {
+    if (typeof command === 'function') {
+        // Key event batch, built when it is written
+        return { key: 'keys', priority: PRIORITY.URGENT };
+    }
+
+    if (Buffer.isBuffer(command)) {
+        // Binary STATS frame: stats, speed and flags in one
+        return { key: 'frame', priority: PRIORITY.ANIMATION };
+    }
+
+    const verb = command.split(':', 1)[0];
+    switch (verb) {
+        case 'SPEED':
+        case 'STOP':
+            // STOP after a pending SPEED (or the reverse) leaves only the newest
+            return { key: 'motion', priority: PRIORITY.ANIMATION };
+        case 'STREAK_ON':
+        case 'STREAK_OFF':
+            return { key: 'streak', priority: PRIORITY.ANIMATION };
+        case 'STATS':
+        case 'CPU':
+        case 'RAM':
+        case 'WPM':
+            return { key: verb, priority: PRIORITY.STATS };
+        case 'TIME':
+            return { key: verb, priority: PRIORITY.BACKGROUND };
+        case 'PING':
+        case 'PROTO':
+        case 'HEARTBEAT':
+        case 'IDLE':
+        case 'IDLE_START':
+            return { key: null, priority: PRIORITY.ANIMATION };
+        default:
+            // Settings: order matters (SAVE_SETTINGS after the values)
+            return { key: null, priority: PRIORITY.BACKGROUND };
+    }
+}
+
+class CommandScheduler {
+    constructor() {
+        this.queues = [[], [], [], []];   // Indexed by PRIORITY
+        this.pendingByKey = new Map();
+        this.resetStats();
+    }
+
+    /**
+     * Queue a command; a pending command with the same key is replaced.
+     * Returns the entry the command ended up in.
+     */
+    enqueue(command, resolve, reject) {
+        const now = Date.now();
+        const { key, priority } = classifyCommand(command);
+
+        this.stats.enqueued++;
+
+        const existing = key !== null ? this.pendingByKey.get(key) : null;
+        if (existing) {
+            // Keep the slot (and its place in line), take the newer value;
+            // callers of the replaced command are settled when it is written
+            existing.command = command;
+            existing.submittedAt = now;
+            existing.waiters.push({ resolve, reject });
+            this.stats.coalesced++;
+            return existing;
+        }
+
+        const entry = {
+            command,
+            key,
+            priority,
+            submittedAt: now,
+            waiters: [{ resolve, reject }]
+        };
+        this.queues[priority].push(entry);
+        if (key !== null) {
+            this.pendingByKey.set(key, entry);
+        }
+
+        const depth = this.getDepth();
+        if (depth > this.stats.maxDepth) {
+            this.stats.maxDepth = depth;
+        }
+        return entry;
+    }
+
+    /**
+     * Remove and return the next command to write (null if none)
+     */
+    next() {
+        for (const queue of this.queues) {
+            if (queue.length > 0) {
+                const entry = queue.shift();
+                if (entry.key !== null) {
+                    this.pendingByKey.delete(entry.key);
+                }
+                return entry;
+            }
+        }
+        return null;
+    }
+
+    /**
+     * Settle an entry returned by next() once its write finished
+     */
+    complete(entry, error) {
+        if (error) {
+            this.stats.failed++;
+            entry.waiters.forEach(({ reject }) => reject(error));
+            return;
+        }
+
+        // Time from the newest value being submitted to it being on the wire
+        const latency = Date.now() - entry.submittedAt;
+        this.latencies[this.stats.sent % LATENCY_WINDOW] = latency;
+        this.stats.sent++;
+        this.stats.totalLatency += latency;
+        if (latency > this.stats.maxLatency) {
+            this.stats.maxLatency = latency;
+        }
+
+        entry.waiters.forEach(({ resolve }) => resolve());
+    }
+
+    /**
+     * Reject everything still pending (disconnect)
+     */
+    clear(error) {
+        for (const queue of this.queues) {
+            queue.forEach(entry => entry.waiters.forEach(({ reject }) => reject(error)));
+            queue.length = 0;
+        }
+        this.pendingByKey.clear();
+    }
+
+    getDepth() {
+        return this.queues.reduce((total, queue) => total + queue.length, 0);
+    }
+
+    /**
+     * True while a command that should not wait for the rate limit is pending
+     */
+    isUrgent() {
+        return this.queues[PRIORITY.URGENT].length > 0;
+    }
+
+    resetStats() {
+        this.stats = {
+            enqueued: 0,
+            coalesced: 0,
+            sent: 0,
+            failed: 0,
+            maxDepth: 0,
+            totalLatency: 0,
+            maxLatency: 0
+        };
+        this.latencies = [];
+    }
+
+    /**
+     * Queue depth and latency (ms) since the last reset
+     */
+    getStats() {
+        const window = this.latencies.slice().sort((a, b) => a - b);
+        const p95 = window.length > 0 ? window[Math.ceil(window.length * 0.95) - 1] : 0;
+
+        return {
+            depth: this.getDepth(),
+            maxDepth: this.stats.maxDepth,
+            enqueued: this.stats.enqueued,
+            coalesced: this.stats.coalesced,
+            sent: this.stats.sent,
+            failed: this.stats.failed,
+            avgLatencyMs: this.stats.sent > 0 ? Math.round(this.stats.totalLatency / this.stats.sent) : 0,
+            p95LatencyMs: p95,
+            maxLatencyMs: this.stats.maxLatency
+        };
+    }
+}
+
+module.exports = {
+    CommandScheduler,
+    PRIORITY,
+    classifyCommand
+};
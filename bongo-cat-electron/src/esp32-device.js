@@ -0,0 +1,699 @@
+const fs = require('fs');
+const { SerialPort } = require('serialport');
+const { ReadlineParser } = require('@serialport/parser-readline');
+const { encodeKeysFrame, KEYS_MAX, crc16, decodeSensorHistory } = require('./binary-protocol');
+const { CommandScheduler } = require('./command-scheduler');
+
+/**
+ * One ESP32 on one serial port
+ *
+ * Owns the port, its command queue, the negotiated protocol, the animation
+ * edge state (streak / idle) and the reconnect attempts. The serial manager
+ * keeps one per connected cat and hands each the same pre-encoded stats.
+ *
+ * hooks.onConnectionChange(device, error) - connected or lost the port
+ * hooks.onData(device, line) - a line printed by the firmware
+ */
+class ESP32Device {
+    constructor(portPath, hooks) {
+        this.path = portPath;
+        this.hooks = hooks;
+        this.port = null;
+        this.parser = null;
+        this.options = {};
+        this.isConnected = false;
+        this.reconnectAttempts = 0;
+        this.maxReconnectAttempts = 3;
+        this.reconnectTimer = null;
+        this.tracePath = null;
+
+        // Latest-value-wins command queue (stale stats/speed never pile up)
+        this.commandQueue = new CommandScheduler();
+        this.isProcessingQueue = false;
+        this.lastCommandTime = 0;
+        this.minCommandInterval = 50; // 50ms between commands to prevent ESP32 overload
+
+        // Animation state tracking
+        this.streakModeActive = false;
+        this.idleModeActive = false;
+
+        // Binary STATS frames (negotiated after PING, falls back to text)
+        this.preferBinaryProtocol = true;
+        this.binaryMode = false;
+        this.negotiationTimeout = 500; // ms to wait for PROTO:BIN_OK
+
+        // Key-down events as KEYS frames (negotiated after PROTO:BIN); the
+        // WPM-based SPEED in the STATS frames stays as the fallback
+        this.preferKeyEvents = true;
+        this.keyEventsMode = false;
+        this.keyBatch = [];
+        this.keyEventMaxDepth = 4; // Drop key events while this many commands are pending
+        this.keyEventsDropped = 0;
+        this.wakeQueue = null;
+    }
+
+    /**
+     * Open the port and bring the link up (PING, protocol negotiation, sync)
+     */
+    async connect(options = this.options) {
+        try {
+            if (this.isConnected) {
+                await this.cleanup();
+            }
+            if (this.reconnectTimer) {
+                clearTimeout(this.reconnectTimer);
+                this.reconnectTimer = null;
+            }
+            this.options = options;
+
+            const config = {
+                baudRate: options.baudRate || 115200,
+                dataBits: 8,
+                stopBits: 1,
+                parity: 'none',
+                ...options
+            };
+
+            console.log(`Connecting to ESP32 on ${this.path} with config:`, config);
+
+            // Create serial port connection
+            this.port = new SerialPort({
+                path: this.path,
+                ...config
+            });
+
+            // Set up parser for reading lines
+            this.parser = this.port.pipe(new ReadlineParser({ delimiter: '\n' }));
+
+            // Set up event handlers
+            this.setupEventHandlers();
+
+            // Wait for port to open
+            await new Promise((resolve, reject) => {
+                this.port.on('open', () => {
+                    console.log(`Serial port ${this.path} opened successfully`);
+                    resolve();
+                });
+
+                this.port.on('error', (error) => {
+                    console.error(`Serial port ${this.path} open error:`, error);
+                    reject(error);
+                });
+            });
+
+            this.isConnected = true;
+            this.reconnectAttempts = 0;
+
+            // Wait for ESP32 to restart (critical for proper communication)
+            console.log(`Waiting 2 seconds for ESP32 restart on ${this.path}...`);
+            await this.sleep(2000);
+
+            // Test connection with PING
+            await this.sendTestPing();
+
+            // Switch to binary frames if the firmware supports them
+            await this.negotiateBinaryProtocol();
+            await this.negotiateKeyEvents();
+
+            // Send initial sync
+            await this.sendInitialSync();
+
+            this.hooks.onConnectionChange(this, null);
+
+            console.log(`Successfully connected to ESP32 on ${this.path}`);
+            return { success: true, port: this.path };
+
+        } catch (error) {
+            console.error(`ESP32 connection on ${this.path} failed:`, error);
+            await this.cleanup();
+
+            throw new Error(`Connection failed: ${error.message}`);
+        }
+    }
+
+    /**
+     * Close the port and stop reconnecting
+     */
+    async disconnect() {
+        if (this.reconnectTimer) {
+            clearTimeout(this.reconnectTimer);
+            this.reconnectTimer = null;
+        }
+        this.reconnectAttempts = this.maxReconnectAttempts;
+
+        await this.cleanup();
+        this.hooks.onConnectionChange(this, null);
+    }
+
+    /**
+     * Send test PING to verify connection
+     */
+    async sendTestPing() {
+        try {
+            console.log('Sending PING test...');
+            await this.sendCommand('PING');
+            await this.sleep(100);
+
+            // Note: ESP32 might not respond to PING, that's normal
+            console.log('PING sent (response not required)');
+        } catch (error) {
+            console.warn('PING test failed:', error);
+            // Don't throw error, PING response is optional
+        }
+    }
+
+    /**
+     * Ask the firmware for binary STATS frames. Older firmware ignores
+     * PROTO:BIN, in which case we stay on text commands.
+     */
+    async negotiateBinaryProtocol() {
+        this.binaryMode = false;
+        if (!this.preferBinaryProtocol) {
+            return false;
+        }
+
+        try {
+            const response = this.waitForResponse('PROTO:BIN_OK', this.negotiationTimeout);
+            await this.sendCommand('PROTO:BIN');
+            this.binaryMode = await response;
+        } catch (error) {
+            console.warn('Binary protocol negotiation failed:', error);
+        }
+
+        console.log(`${this.path}: using ${this.binaryMode ? 'binary' : 'text'} protocol`);
+        return this.binaryMode;
+    }
+
+    /**
+     * Ask the firmware to take per-key events (binary mode only)
+     */
+    async negotiateKeyEvents() {
+        this.keyEventsMode = false;
+        if (!this.binaryMode || !this.preferKeyEvents) {
+            return false;
+        }
+
+        try {
+            const response = this.waitForResponse('PROTO:KEYS_OK', this.negotiationTimeout);
+            await this.sendCommand('PROTO:KEYS');
+            this.keyEventsMode = await response;
+        } catch (error) {
+            console.warn('Key event negotiation failed:', error);
+        }
+
+        console.log(`${this.path}: key events ${this.keyEventsMode ? 'enabled' : 'unavailable, using WPM speed only'}`);
+        return this.keyEventsMode;
+    }
+
+    /**
+     * Resolve true when the ESP32 prints the expected line, false on timeout
+     */
+    waitForResponse(expected, timeoutMs) {
+        return new Promise((resolve) => {
+            if (!this.parser) {
+                resolve(false);
+                return;
+            }
+
+            const parser = this.parser;
+            const onData = (data) => {
+                if (data.trim() === expected) {
+                    finish(true);
+                }
+            };
+            const timer = setTimeout(() => finish(false), timeoutMs);
+            const finish = (result) => {
+                clearTimeout(timer);
+                parser.removeListener('data', onData);
+                resolve(result);
+            };
+
+            parser.on('data', onData);
+        });
+    }
+
+    /**
+     * Fetch the AHT30 history in one SENSOR_DUMP batch. Resolves the
+     * decoded history, or null on timeout, a bad CRC or older firmware.
+     */
+    async readSensorHistory(timeoutMs = 3000) {
+        if (!this.parser) {
+            return null;
+        }
+
+        const parser = this.parser;
+        const result = new Promise((resolve) => {
+            let expected = -1;
+            let chunks = [];
+            const onData = (data) => {
+                const line = data.trim();
+                if (line.startsWith('SENSOR_DUMP:BEGIN,bytes=')) {
+                    expected = parseInt(line.slice(24), 10);
+                    chunks = [];
+                } else if (line.startsWith('SENSOR_DATA:') && expected >= 0) {
+                    chunks.push(Buffer.from(line.slice(12), 'base64'));
+                } else if (line.startsWith('SENSOR_DUMP:END,crc=') && expected >= 0) {
+                    const blob = Buffer.concat(chunks);
+                    if (blob.length !== expected || crc16(blob) !== parseInt(line.slice(20), 16)) {
+                        console.warn(`${this.path}: corrupt sensor history (${blob.length}/${expected} bytes)`);
+                        finish(null);
+                        return;
+                    }
+                    try {
+                        finish(decodeSensorHistory(blob));
+                    } catch (error) {
+                        console.warn(`${this.path}: ${error.message}`);
+                        finish(null);
+                    }
+                }
+            };
+            const timer = setTimeout(() => finish(null), timeoutMs);
+            const finish = (history) => {
+                clearTimeout(timer);
+                parser.removeListener('data', onData);
+                resolve(history);
+            };
+
+            parser.on('data', onData);
+        });
+
+        try {
+            await this.sendCommand('SENSOR_DUMP');
+        } catch (error) {
+            console.warn(`${this.path}: SENSOR_DUMP failed:`, error);
+            return null;
+        }
+        return result;
+    }
+
+    /**
+     * Send initial synchronization data
+     */
+    async sendInitialSync() {
+        try {
+            console.log('Sending initial sync...');
+
+            // Send current time
+            const currentTime = new Date().toLocaleTimeString('en-US', {
+                hour12: false,
+                hour: '2-digit',
+                minute: '2-digit'
+            });
+
+            await this.sendCommand(`TIME:${currentTime}`);
+            await this.sleep(50);
+
+            // Send initial stats (will be updated by monitoring systems)
+            await this.sendCommand('CPU:0');
+            await this.sleep(50);
+            await this.sendCommand('RAM:0');
+            await this.sleep(50);
+            await this.sendCommand('WPM:0');
+
+            console.log('Initial sync completed');
+        } catch (error) {
+            console.error('Initial sync failed:', error);
+            // Don't throw error, sync can be retried
+        }
+    }
+
+    /**
+     * Send command to ESP32
+     */
+    async sendCommand(command) {
+        return new Promise((resolve, reject) => {
+            if (!this.isConnected || !this.port) {
+                reject(new Error(`Not connected to ESP32 on ${this.path}`));
+                return;
+            }
+
+            // Add to command queue (replaces a pending command with the same key)
+            this.commandQueue.enqueue(command, resolve, reject);
+            if (this.commandQueue.isUrgent() && this.wakeQueue) {
+                this.wakeQueue();
+            }
+            this.processCommandQueue();
+        });
+    }
+
+    /**
+     * Process command queue with rate limiting
+     */
+    async processCommandQueue() {
+        if (this.isProcessingQueue || this.commandQueue.getDepth() === 0) {
+            return;
+        }
+
+        this.isProcessingQueue = true;
+
+        while (this.isConnected && this.commandQueue.getDepth() > 0) {
+            // Rate limiting - pick the command only afterwards, so whatever
+            // arrives while we wait is coalesced into it. Key events skip it
+            // (and cut a wait short): they are a few bytes and latency-bound.
+            const now = Date.now();
+            const timeSinceLastCommand = now - this.lastCommandTime;
+            if (!this.commandQueue.isUrgent() && timeSinceLastCommand < this.minCommandInterval) {
+                await this.waitForSlot(this.minCommandInterval - timeSinceLastCommand);
+            }
+
+            const entry = this.commandQueue.next();
+            if (!entry || !this.port) {
+                break;
+            }
+            const command = typeof entry.command === 'function' ? entry.command() : entry.command;
+            if (command === null) {
+                this.commandQueue.complete(entry);
+                continue;
+            }
+
+            try {
+                // Send command (binary frames are written as-is)
+                const isFrame = Buffer.isBuffer(command);
+                const fullCommand = isFrame ? command : `${command}\n`;
+                await new Promise((writeResolve, writeReject) => {
+                    this.port.write(fullCommand, (error) => {
+                        if (error) {
+                            writeReject(error);
+                        } else {
+                            writeResolve();
+                        }
+                    });
+                });
+
+                this.lastCommandTime = Date.now();
+                this.recordTrace(fullCommand);
+                // Reduced logging - only log important commands
+        if (!isFrame && (command.includes('PING') || command.includes('TIME:') || command.startsWith('DISPLAY:'))) {
+            console.log(`Sent to ESP32 on ${this.path}: ${command}`);
+        }
+                this.commandQueue.complete(entry);
+
+            } catch (error) {
+                console.error(`Failed to send command ${Buffer.isBuffer(command) ? '<binary frame>' : command} to ${this.path}:`, error);
+                this.commandQueue.complete(entry, error);
+            }
+        }
+
+        this.isProcessingQueue = false;
+    }
+
+    /**
+     * Append written bytes to the trace file, a replay trace for the
+     * firmware's native benchmark (bongo-cat-esp32/bench)
+     */
+    recordTrace(data) {
+        if (!this.tracePath) {
+            return;
+        }
+        try {
+            fs.appendFileSync(this.tracePath, data);
+        } catch (error) {
+            console.error('Failed to record serial trace:', error.message);
+        }
+    }
+
+    /**
+     * Wait out the rate limit; an urgent command ends the wait early
+     */
+    waitForSlot(ms) {
+        return new Promise((resolve) => {
+            const done = () => {
+                clearTimeout(timer);
+                this.wakeQueue = null;
+                resolve();
+            };
+            const timer = setTimeout(done, ms);
+            this.wakeQueue = done;
+        });
+    }
+
+    /**
+     * Queue one key-down ({ timestamp, right }) for the next KEYS frame
+     */
+    sendKeyEvent(event) {
+        if (!this.isConnected || !this.keyEventsMode) {
+            return;
+        }
+
+        // Congested link: the STATS frames' SPEED keeps the paws going
+        if (this.commandQueue.getDepth() > this.keyEventMaxDepth || this.keyBatch.length >= KEYS_MAX) {
+            this.keyEventsDropped++;
+            return;
+        }
+
+        this.keyBatch.push(event);
+        if (this.keyBatch.length === 1) {
+            // Everything that arrives until this is written joins the same frame
+            this.sendCommand(() => this.takeKeyBatch()).catch(() => {});
+        }
+    }
+
+    /**
+     * Encode and clear the pending key events (null if there are none)
+     */
+    takeKeyBatch() {
+        if (this.keyBatch.length === 0) {
+            return null;
+        }
+        const events = this.keyBatch.splice(0, KEYS_MAX);
+        return encodeKeysFrame(events);
+    }
+
+    /**
+     * Send one stats tick, encoded once by the manager for every device:
+     * tick.frame (binary) or tick.statsCommand plus SPEED/STOP/STREAK_* (text)
+     */
+    async sendStatsTick(tick) {
+        try {
+            // Same state tracking in both modes, so a fallback to text mode
+            // picks up where the frames left off
+            if (this.binaryMode) {
+                this.streakModeActive = tick.streak;
+                this.idleModeActive = !tick.typing;
+                await this.sendCommand(tick.frame());
+                return;
+            }
+
+            // Use original engine.py format: STATS:CPU:X,RAM:Y,WPM:Z
+            await this.sendCommand(tick.statsCommand);
+
+            // Send animation commands based on WPM
+            await this.sendAnimationCommands(tick);
+
+        } catch (error) {
+            console.error(`Failed to send combined stats to ${this.path}:`, error);
+        }
+    }
+
+    /**
+     * Send animation commands based on WPM (matching original engine.py)
+     */
+    async sendAnimationCommands(tick) {
+        try {
+            if (tick.typing) {
+                await this.sendCommand(tick.speedCommand);
+
+                // Handle streak mode (65+ WPM like original)
+                if (tick.streak) {
+                    if (!this.streakModeActive) {
+                        await this.sendCommand('STREAK_ON');
+                        this.streakModeActive = true;
+                    }
+                } else {
+                    if (this.streakModeActive) {
+                        await this.sendCommand('STREAK_OFF');
+                        this.streakModeActive = false;
+                    }
+                }
+
+                // Reset idle mode when typing starts
+                if (this.idleModeActive) {
+                    this.idleModeActive = false;
+                }
+
+            } else {
+                // No typing - send STOP command like original engine.py
+                if (!this.idleModeActive) {
+                    await this.sendCommand('STOP');
+
+                    // Turn off streak when stopping
+                    if (this.streakModeActive) {
+                        await this.sendCommand('STREAK_OFF');
+                        this.streakModeActive = false;
+                    }
+
+                    this.idleModeActive = true;
+                }
+            }
+
+        } catch (error) {
+            console.error('Failed to send animation commands:', error);
+        }
+    }
+
+    /**
+     * Send display settings to ESP32
+     */
+    async sendDisplaySettings(settings) {
+        try {
+            console.log(`Sending display settings to ESP32 on ${this.path}:`, settings);
+
+            // Send individual display setting commands using Arduino expected format
+            await this.sendCommand(`DISPLAY_CPU:${settings.showCpu ? 'ON' : 'OFF'}`);
+            await this.sleep(50);
+
+            await this.sendCommand(`DISPLAY_RAM:${settings.showRam ? 'ON' : 'OFF'}`);
+            await this.sleep(50);
+
+            await this.sendCommand(`DISPLAY_WPM:${settings.showWpm ? 'ON' : 'OFF'}`);
+            await this.sleep(50);
+
+            await this.sendCommand(`DISPLAY_TIME:${settings.showTime ? 'ON' : 'OFF'}`);
+            await this.sleep(50);
+
+            if (settings.timeFormat) {
+                await this.sendCommand(`TIME_FORMAT:${settings.timeFormat}`);
+                await this.sleep(50);
+            }
+
+            if (settings.sleepTimeout) {
+                await this.sendCommand(`SLEEP_TIMEOUT:${settings.sleepTimeout}`);
+                await this.sleep(50);
+            }
+
+            // Save settings to ESP32 EEPROM for persistence
+            await this.sendCommand('SAVE_SETTINGS');
+            await this.sleep(50);
+
+            console.log(`Display settings sent and saved to ESP32 on ${this.path} successfully`);
+        } catch (error) {
+            console.error(`Failed to send display settings to ${this.path}:`, error);
+            // Don't throw error - settings were applied locally successfully
+            // ESP32 communication failure shouldn't prevent local settings application
+        }
+    }
+
+    /**
+     * Setup event handlers for serial port
+     */
+    setupEventHandlers() {
+        // Handle incoming data
+        this.parser.on('data', (data) => {
+            const cleanData = data.trim();
+            if (cleanData) {
+                console.log(`ESP32 Response (${this.path}): ${cleanData}`);
+                this.hooks.onData(this, cleanData);
+            }
+        });
+
+        // Handle port errors
+        this.port.on('error', (error) => {
+            console.error(`Serial port ${this.path} error:`, error);
+            this.handleConnectionError(error);
+        });
+
+        // Handle port close
+        this.port.on('close', () => {
+            console.log(`Serial port ${this.path} closed`);
+            if (this.isConnected) {
+                this.handleConnectionError(new Error('Port closed unexpectedly'));
+            }
+        });
+    }
+
+    /**
+     * Handle connection errors and attempt reconnection
+     */
+    async handleConnectionError(error) {
+        console.error(`Connection error on ${this.path}:`, error);
+
+        this.isConnected = false;
+        this.commandQueue.clear(error);
+        this.isProcessingQueue = false;
+        this.hooks.onConnectionChange(this, error);
+
+        // Attempt reconnection if configured
+        if (this.reconnectAttempts < this.maxReconnectAttempts && !this.reconnectTimer) {
+            this.reconnectAttempts++;
+            console.log(`Attempting reconnection to ${this.path} ${this.reconnectAttempts}/${this.maxReconnectAttempts}...`);
+
+            this.reconnectTimer = setTimeout(async () => {
+                this.reconnectTimer = null;
+                try {
+                    await this.connect();
+                } catch (reconnectError) {
+                    console.error(`Reconnection to ${this.path} failed:`, reconnectError);
+                    this.handleConnectionError(reconnectError);
+                }
+            }, 3000);
+        }
+    }
+
+    /**
+     * Cleanup resources
+     */
+    async cleanup() {
+        this.isConnected = false;
+        this.binaryMode = false;
+        this.keyEventsMode = false;
+        this.keyBatch = [];
+        this.commandQueue.clear(new Error('Disconnected from ESP32'));
+        this.isProcessingQueue = false;
+
+        if (this.parser) {
+            this.parser.removeAllListeners();
+            this.parser = null;
+        }
+
+        if (this.port && this.port.isOpen) {
+            await new Promise((resolve) => {
+                this.port.close((error) => {
+                    if (error) {
+                        console.error('Error closing port:', error);
+                    }
+                    resolve();
+                });
+            });
+        }
+
+        this.port = null;
+    }
+
+    /**
+     * Utility sleep function
+     */
+    sleep(ms) {
+        return new Promise(resolve => setTimeout(resolve, ms));
+    }
+
+    /**
+     * Get connection status
+     */
+    getConnectionStatus() {
+        return {
+            isConnected: this.isConnected,
+            port: this.path,
+            protocol: this.binaryMode ? 'binary' : 'text',
+            keyEvents: this.keyEventsMode,
+            queueLength: this.commandQueue.getDepth(),
+            reconnecting: this.reconnectTimer !== null
+        };
+    }
+
+    /**
+     * Queue depth, coalescing and submit-to-write latency (ms)
+     */
+    getQueueStats(reset = false) {
+        const stats = {
+            ...this.commandQueue.getStats(),
+            keyEventsDropped: this.keyEventsDropped
+        };
+        if (reset) {
+            this.commandQueue.resetStats();
+            this.keyEventsDropped = 0;
+        }
+        return stats;
+    }
+}
+
+module.exports = ESP32Device;
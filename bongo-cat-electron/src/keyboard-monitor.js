@@ -1,6 +1,13 @@
 // Using node-global-key-listener for global keyboard monitoring
 const { GlobalKeyboardListener } = require('node-global-key-listener');
 
+// Keys the left hand types on a QWERTY layout (the rest go to the right paw)
+const LEFT_HAND_KEYS = new Set([
+    '`', '1', '2', '3', '4', '5', 'Q', 'W', 'E', 'R', 'T',
+    'A', 'S', 'D', 'F', 'G', 'Z', 'X', 'C', 'V', 'B',
+    'ESCAPE', 'TAB', 'CAPS LOCK', 'SECTION'
+]);
+
 /**
  * Keyboard Monitor for WPM Calculation
  * Tracks typing activity and calculates words per minute
@@ -33,6 +40,9 @@ class KeyboardMonitor {
         
         // Fallback mode flag
         this.fallbackMode = false;
+        
+        // Paw for keys both hands use (space...), alternates
+        this.lastSharedKeyRight = false;
 
         
         console.log('Keyboard Monitor initialized');
@@ -141,6 +151,18 @@ class KeyboardMonitor {
         // Event handlers are set up in the keyboardListener.addListener() call
     }
 
+    /**
+     * Which paw plays a key
+     */
+    isRightHandKey(key) {
+        const name = key.toUpperCase();
+        if (name === 'SPACE') {
+            this.lastSharedKeyRight = !this.lastSharedKeyRight;
+            return this.lastSharedKeyRight;
+        }
+        return !LEFT_HAND_KEYS.has(name);
+    }
+
     /**
      * Enhanced error handling and permission guidance
      */
@@ -213,6 +235,12 @@ class KeyboardMonitor {
                 key: typingKeyResult
             });
 
+            // Every key-down, for the per-key paw strikes on the ESP32
+            this.eventEmitter.emit('key-down', {
+                timestamp: now,
+                right: this.isRightHandKey(typingKeyResult)
+            });
+
             // Update session data
             this.currentSession.totalKeystrokes++;
             this.currentSession.lastKeystrokeTime = now;
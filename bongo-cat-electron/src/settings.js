@@ -16,6 +16,12 @@ class SettingsManager {
                     maximum: 10000,
                     default: 1000
                 },
+                statsDeadband: {
+                    type: 'number',
+                    minimum: 0,
+                    maximum: 50,
+                    default: 2
+                },
                 autoConnect: {
                     type: 'boolean',
                     default: false
@@ -78,6 +84,7 @@ class SettingsManager {
     getDefaultSettings() {
         return {
             updateInterval: 1000,
+            statsDeadband: 2,
             autoConnect: false,
             minimizeToTray: true,
             startMinimized: false,
@@ -200,6 +207,13 @@ class SettingsManager {
         return this.get('updateInterval', 1000);
     }
 
+    /**
+     * Get the CPU/RAM change (percentage points) worth sending to the ESP32
+     */
+    getStatsDeadband() {
+        return this.get('statsDeadband', 2);
+    }
+
     /**
      * Check if app should start minimized
      */
@@ -3,13 +3,23 @@ const si = require('systeminformation');
 /**
  * System Monitor
  * Tracks CPU, RAM, and other system statistics
+ *
+ * Sampling is adaptive: every fastInterval while the values move or the
+ * user types, doubling up to idleInterval while nothing changes. A
+ * 'system-stats' event is only emitted when CPU or RAM moved by more than
+ * deadband (percentage points) since the last emitted value, so idle
+ * periods cost neither host wakeups nor serial writes.
  */
 class SystemMonitor {
     constructor(eventEmitter) {
         this.eventEmitter = eventEmitter;
         this.isMonitoring = false;
-        this.monitoringInterval = null;
-        this.updateInterval = 1000; // Default 1 second
+        this.monitoringTimer = null;
+        this.fastInterval = 500;    // ms between samples while values move / typing
+        this.idleInterval = 1000;   // Slowest sample rate when idle (updateInterval setting)
+        this.currentInterval = this.fastInterval;
+        this.deadband = 2;          // Percentage points before CPU/RAM count as changed
+        this.typingActive = false;
         
         // Cache for system stats
         this.lastStats = {
@@ -17,6 +27,9 @@ class SystemMonitor {
             memory: 0,
             timestamp: Date.now()
         };
+        this.lastEmitted = null;
+        this.samples = 0;
+        this.emitted = 0;
         
         // Performance optimization
         this.cpuLoadArray = [];
@@ -26,31 +39,26 @@ class SystemMonitor {
     }
 
     /**
-     * Start system monitoring
+     * Start system monitoring (interval: slowest idle sample rate in ms)
      */
-    async startMonitoring(interval = 1000) {
+    async startMonitoring(interval = this.idleInterval) {
         try {
             if (this.isMonitoring) {
                 console.log('System monitoring already running');
                 return { success: true };
             }
 
-            this.updateInterval = interval;
-            console.log(`Starting system monitoring with ${interval}ms interval`);
+            this.idleInterval = Math.max(interval, this.fastInterval);
+            console.log(`Starting system monitoring every ${this.fastInterval}-${this.idleInterval}ms (deadband ${this.deadband}%)`);
 
             // Get initial system info
+            this.lastEmitted = null;
             await this.updateSystemStats();
 
             // Start monitoring loop
-            this.monitoringInterval = setInterval(async () => {
-                try {
-                    await this.updateSystemStats();
-                } catch (error) {
-                    console.error('Error in monitoring loop:', error);
-                }
-            }, this.updateInterval);
-
             this.isMonitoring = true;
+            this.currentInterval = this.fastInterval;
+            this.scheduleSample();
             console.log('System monitoring started successfully');
             
             return { success: true };
@@ -71,9 +79,9 @@ class SystemMonitor {
                 return { success: true };
             }
 
-            if (this.monitoringInterval) {
-                clearInterval(this.monitoringInterval);
-                this.monitoringInterval = null;
+            if (this.monitoringTimer) {
+                clearTimeout(this.monitoringTimer);
+                this.monitoringTimer = null;
             }
 
             this.isMonitoring = false;
@@ -89,7 +97,68 @@ class SystemMonitor {
     }
 
     /**
-     * Update system statistics
+     * Take the next sample after currentInterval
+     */
+    scheduleSample() {
+        if (this.monitoringTimer) {
+            clearTimeout(this.monitoringTimer);
+        }
+
+        this.monitoringTimer = setTimeout(async () => {
+            this.monitoringTimer = null;
+            try {
+                const changed = await this.updateSystemStats();
+
+                // Moving values or typing: stay fast; otherwise back off
+                this.currentInterval = changed || this.typingActive
+                    ? this.fastInterval
+                    : Math.min(this.currentInterval * 2, this.idleInterval);
+            } catch (error) {
+                console.error('Error in monitoring loop:', error);
+            }
+            if (this.isMonitoring) {
+                this.scheduleSample();
+            }
+        }, this.currentInterval);
+    }
+
+    /**
+     * Typing state from the keyboard monitor; typing starts a fast sample now
+     */
+    setTypingActive(active) {
+        const started = active && !this.typingActive;
+        this.typingActive = active;
+
+        if (started && this.isMonitoring && this.currentInterval > this.fastInterval) {
+            this.currentInterval = this.fastInterval;
+            this.scheduleSample();
+        }
+    }
+
+    /**
+     * Percentage points CPU or RAM must move before a new value is emitted
+     */
+    setDeadband(deadband) {
+        if (deadband < 0 || deadband > 50) {
+            throw new Error('Deadband must be between 0 and 50');
+        }
+        this.deadband = deadband;
+    }
+
+    /**
+     * True if a value moved beyond the deadband since the last emitted one
+     */
+    exceedsDeadband(stats) {
+        if (!this.lastEmitted) {
+            return true;
+        }
+        return Math.abs(stats.cpu - this.lastEmitted.cpu) > this.deadband ||
+               Math.abs(stats.memory - this.lastEmitted.memory) > this.deadband;
+    }
+
+    /**
+     * Sample system statistics; emits and returns true only if they changed
+     * beyond the deadband (lastStats always has the newest sample)
      */
     async updateSystemStats() {
         try {
@@ -116,16 +185,23 @@ class SystemMonitor {
                 timestamp: Date.now()
             };
 
+            this.samples++;
+
             // Emit stats update
+            if (!this.exceedsDeadband(this.lastStats)) {
+                return false;
+            }
+            this.lastEmitted = this.lastStats;
+            this.emitted++;
             this.eventEmitter.emit('system-stats', this.lastStats);
 
-            return this.lastStats;
+            return true;
 
         } catch (error) {
             console.error('Failed to update system stats:', error);
             
-            // Return cached stats on error
-            return this.lastStats;
+            // Keep the cached stats on error
+            return false;
         }
     }
 
@@ -140,7 +216,8 @@ class SystemMonitor {
             }
 
             // Otherwise, get fresh stats
-            return await this.updateSystemStats();
+            await this.updateSystemStats();
+            return this.lastStats;
 
         } catch (error) {
             console.error('Failed to get current stats:', error);
@@ -292,19 +369,19 @@ class SystemMonitor {
     }
 
     /**
-     * Update monitoring interval
+     * Update the idle (slowest) monitoring interval
      */
     updateInterval(newInterval) {
         if (newInterval < 100 || newInterval > 10000) {
             throw new Error('Interval must be between 100ms and 10000ms');
         }
 
-        this.updateInterval = newInterval;
+        this.idleInterval = Math.max(newInterval, this.fastInterval);
+        this.currentInterval = Math.min(this.currentInterval, this.idleInterval);
         
         if (this.isMonitoring) {
-            // Restart monitoring with new interval
-            this.stopMonitoring();
-            this.startMonitoring(newInterval);
+            // Next sample at the new rate
+            this.scheduleSample();
         }
 
         console.log(`Monitoring interval updated to ${newInterval}ms`);
@@ -316,7 +393,11 @@ class SystemMonitor {
     getStatus() {
         return {
             isMonitoring: this.isMonitoring,
-            interval: this.updateInterval,
+            interval: this.currentInterval,
+            idleInterval: this.idleInterval,
+            deadband: this.deadband,
+            samples: this.samples,
+            emitted: this.emitted,
             lastUpdate: this.lastStats.timestamp,
             lastStats: this.lastStats
         };
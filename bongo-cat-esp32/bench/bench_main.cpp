@@ -0,0 +1,399 @@
+// Firmware-in-the-loop benchmark (env:native)
+//
+// Replays serial traces - the exact bytes the Electron app writes to the
+// port - through the firmware's own modules on the host:
+//
+//   parse:  serial_link (text lines + binary frames) -> app_event_t ->
+//           event_queue, as the I/O and render tasks hand them over
+//   render: the animation commands of the same trace drive the sprite
+//           manager, the cat compositor and the stats overlay, and LVGL
+//           draws every frame into a headless display
+//
+// and reports commands/s parsed, frames/s composited and heap allocations
+// per command. Time is virtual: every replayed command advances the clock
+// by BENCH_COMMAND_GAP_MS, so animation timings behave as on the device.
+//
+//   pio run -e native -t exec
+//   .pio/build/native/program [trace.bin ...]
+//
+// Exits with 1 if the parse path allocates, which it must never do.
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <chrono>
+#include <vector>
+#include "serial_link.h"
+#include "event_queue.h"
+#include "animations_sprites.h"
+#include "cat_compositor.h"
+#include "sprite_cache.h"
+#include "stats_overlay.h"
+
+#define BENCH_CHUNK 64                // Bytes per read, as in handleSerialCommands()
+#define BENCH_MIN_SECONDS 1.0         // Repeat a trace at least this long
+#define BENCH_COMMAND_GAP_MS 10       // Virtual time between replayed commands
+#define BENCH_SCREEN_W 240
+#define BENCH_SCREEN_H 320
+
+uint32_t bench_millis = 0;
+uint32_t bench_cpu_mhz = 240;
+BenchSerial Serial;
+
+// Heap allocations (malloc, calloc, realloc and new, which uses malloc)
+static uint64_t allocations = 0;
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+    allocations++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    allocations++;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    allocations++;
+    return __libc_realloc(ptr, size);
+}
+}
+#define BENCH_COUNTS_MALLOC 1
+#else
+// Elsewhere only C++ allocations are seen
+void* operator new(size_t size) {
+    allocations++;
+    void* ptr = malloc(size);
+    if (!ptr) abort();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+#define BENCH_COUNTS_MALLOC 0
+#endif
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+static bool load_trace(const char* path, std::vector<uint8_t>* data) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+        data->insert(data->end(), buf, buf + n);
+    }
+    fclose(file);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Parse path: serial_link -> app_event_t -> event_queue
+
+typedef struct {
+    serial_link_t link;
+    event_queue_t queue;
+    uint32_t commands;      // Text lines and frames that became events
+} parse_bench_t;
+
+static void drain_queue(parse_bench_t* bench) {
+    app_event_t event;
+    while (event_queue_pop(&bench->queue, &event)) {
+        bench->commands++;
+    }
+}
+
+// Same event conversion and PROTO:* handling as the I/O task in main.cpp
+static void parse_on_command(const serial_command_t* cmd, void* ctx) {
+    parse_bench_t* bench = (parse_bench_t*)ctx;
+
+    if (cmd->verb_hash == serial_hash("PROTO")) {
+        if (strcmp(cmd->arg, "BIN") == 0) serial_link_set_binary(&bench->link, true);
+        else if (strcmp(cmd->arg, "TEXT") == 0) serial_link_set_binary(&bench->link, false);
+        bench->commands++;
+        return;
+    }
+
+    app_event_t event;
+    event.type = APP_EVENT_COMMAND;
+    event.command.verb_hash = cmd->verb_hash;
+    strncpy(event.command.arg, cmd->arg, APP_EVENT_ARG_MAX);
+    event.command.arg[APP_EVENT_ARG_MAX] = '\0';
+    if (!event_queue_push(&bench->queue, &event)) {
+        drain_queue(bench);
+        event_queue_push(&bench->queue, &event);
+    }
+}
+
+static void parse_on_frame(const binary_frame_t* frame, void* ctx) {
+    parse_bench_t* bench = (parse_bench_t*)ctx;
+
+    app_event_t event;
+    event.type = APP_EVENT_FRAME;
+    event.frame = *frame;
+    if (!event_queue_push(&bench->queue, &event)) {
+        drain_queue(bench);
+        event_queue_push(&bench->queue, &event);
+    }
+}
+
+static bool bench_parse(const char* name, const std::vector<uint8_t>& trace) {
+    static parse_bench_t bench;
+    static const serial_link_handlers_t handlers = {parse_on_command, parse_on_frame, &bench};
+    uint8_t chunk[BENCH_CHUNK];
+
+    uint64_t commands = 0;
+    uint64_t bytes = 0;
+    uint64_t allocs = 0;
+    uint32_t passes = 0;
+    double elapsed = 0;
+
+    bench_clock::time_point start = bench_clock::now();
+    while (elapsed < BENCH_MIN_SECONDS) {
+        serial_link_init(&bench.link, &handlers);
+        event_queue_init(&bench.queue);
+        bench.commands = 0;
+
+        uint64_t allocs_before = allocations;
+        for (size_t pos = 0; pos < trace.size(); pos += BENCH_CHUNK) {
+            size_t n = std::min((size_t)BENCH_CHUNK, trace.size() - pos);
+            memcpy(chunk, &trace[pos], n);   // serial_link_feed compacts in place
+            serial_link_feed(&bench.link, chunk, n);
+            drain_queue(&bench);
+        }
+        allocs += allocations - allocs_before;
+
+        commands += bench.commands;
+        bytes += trace.size();
+        passes++;
+        elapsed = seconds_since(start);
+    }
+
+    printf("parse   %-24s %8zu B %6u cmds  %10.0f cmd/s  %7.2f MB/s  %.3f allocs/cmd  dropped %u lines\n",
+           name, trace.size(), (unsigned)(commands / passes), commands / elapsed, bytes / elapsed / 1e6,
+           commands ? (double)allocs / commands : 0.0, (unsigned)bench.link.parser.dropped_lines);
+    return allocs == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Render path: animation commands -> sprite manager -> compositor -> LVGL
+
+static sprite_manager_t manager;
+static lv_obj_t* cat = NULL;
+static bool typing_frame = false;   // Typing flag of the last STATS frame
+static std::vector<app_event_t> replay;
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_color_t draw_pixels[BENCH_SCREEN_W * 40];
+static lv_disp_drv_t disp_drv;
+static uint64_t flushed_pixels = 0;
+
+static void bench_flush(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* pixels) {
+    flushed_pixels += (uint64_t)lv_area_get_width(area) * lv_area_get_height(area);
+    lv_disp_flush_ready(drv);
+}
+
+static void render_setup() {
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, draw_pixels, NULL, BENCH_SCREEN_W * 40);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = BENCH_SCREEN_W;
+    disp_drv.ver_res = BENCH_SCREEN_H;
+    disp_drv.flush_cb = bench_flush;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    // Same scene as createBongoCat()
+    lv_obj_t* screen = lv_scr_act();
+    lv_obj_set_style_bg_color(screen, lv_color_white(), 0);
+    cat = cat_compositor_create(screen, lv_color_white());
+
+    static const lv_img_dsc_t* const all_sprites[] = {
+        &standardbody1, &bodyeartwitch,
+        &stock_face, &happy_face, &blink_face, &sleepy_face,
+        &leftpawdown, &rightpawdown, &twopawsup,
+        &table1,
+        &left_click_effect, &right_click_effect, &sleepy1, &sleepy2, &sleepy3
+    };
+    cat_compositor_register_sprites(all_sprites, sizeof(all_sprites) / sizeof(all_sprites[0]));
+    sprite_cache_init(SPRITE_CACHE_BUDGET);
+    lv_obj_align(cat, LV_ALIGN_CENTER, 12, 50);
+    stats_overlay_create(screen);
+
+    randomSeed(1);
+    sprite_manager_init(&manager);
+    sprite_render_layers(&manager, cat, bench_millis);
+    lv_refr_now(NULL);
+}
+
+// The animation-relevant part of processCommand() / processBinaryFrame()
+static void render_dispatch(const app_event_t* event, uint32_t now) {
+    if (event->type == APP_EVENT_FRAME) {
+        binary_keys_t keys;
+        binary_stats_t stats;
+        manager.last_command_time = now;
+        manager.python_control_mode = true;
+
+        if (binary_decode_keys(&event->frame, &keys)) {
+            sprite_manager_key_events(&manager, keys.events, keys.count, now);
+        } else if (binary_decode_stats(&event->frame, &stats)) {
+            stats_overlay_set_stats(stats.cpu, stats.ram, stats.wpm, now);
+            manager.is_streak_mode = (stats.flags & BINARY_FLAG_STREAK) != 0;
+            bool typing = (stats.flags & BINARY_FLAG_TYPING) && stats.speed > 0;
+            if (typing) {
+                sprite_manager_apply_speed(&manager, stats.speed, now);
+            } else if (typing_frame) {
+                sprite_manager_stop(&manager, now);
+            }
+            typing_frame = typing;
+        }
+        return;
+    }
+
+    const char* arg = event->command.arg;
+    manager.last_command_time = now;
+    manager.python_control_mode = true;
+
+    switch (event->command.verb_hash) {
+        case serial_hash("SPEED"):
+            sprite_manager_apply_speed(&manager, serial_parse_int(arg), now);
+            break;
+        case serial_hash("STOP"):
+            sprite_manager_stop(&manager, now);
+            break;
+        case serial_hash("STREAK_ON"):
+            manager.is_streak_mode = true;
+            break;
+        case serial_hash("STREAK_OFF"):
+            manager.is_streak_mode = false;
+            break;
+        case serial_hash("STATS"): {
+            const char* cpu = serial_find_field(arg, "CPU");
+            const char* ram = serial_find_field(arg, "RAM");
+            const char* wpm = serial_find_field(arg, "WPM");
+            stats_overlay_set_stats(cpu ? serial_parse_int(cpu) : 0, ram ? serial_parse_int(ram) : 0,
+                                    wpm ? serial_parse_int(wpm) : 0, now);
+            break;
+        }
+        case serial_hash("TIME"):
+            stats_overlay_set_time(arg, now);
+            break;
+        default:
+            break;
+    }
+}
+
+static void collect_on_command(const serial_command_t* cmd, void* ctx) {
+    serial_link_t* link = (serial_link_t*)ctx;
+    if (cmd->verb_hash == serial_hash("PROTO")) {
+        if (strcmp(cmd->arg, "BIN") == 0) serial_link_set_binary(link, true);
+        else if (strcmp(cmd->arg, "TEXT") == 0) serial_link_set_binary(link, false);
+        return;
+    }
+
+    app_event_t event;
+    event.type = APP_EVENT_COMMAND;
+    event.command.verb_hash = cmd->verb_hash;
+    strncpy(event.command.arg, cmd->arg, APP_EVENT_ARG_MAX);
+    event.command.arg[APP_EVENT_ARG_MAX] = '\0';
+    replay.push_back(event);
+}
+
+static void collect_on_frame(const binary_frame_t* frame, void* ctx) {
+    app_event_t event;
+    event.type = APP_EVENT_FRAME;
+    event.frame = *frame;
+    replay.push_back(event);
+}
+
+static void bench_render(const char* name, const std::vector<uint8_t>& trace) {
+    // Decode once up front, only the render side is timed here
+    static serial_link_t link;
+    serial_link_handlers_t handlers = {collect_on_command, collect_on_frame, &link};
+    serial_link_init(&link, &handlers);
+    replay.clear();
+
+    std::vector<uint8_t> copy(trace);
+    for (size_t pos = 0; pos < copy.size(); pos += BENCH_CHUNK) {
+        serial_link_feed(&link, &copy[pos], std::min((size_t)BENCH_CHUNK, copy.size() - pos));
+    }
+    if (replay.empty()) return;
+
+    uint64_t events = 0;
+    uint64_t frames = 0;
+    uint64_t allocs = 0;
+    double compose_s = 0;
+    double draw_s = 0;
+    flushed_pixels = 0;
+
+    bench_clock::time_point start = bench_clock::now();
+    while (seconds_since(start) < BENCH_MIN_SECONDS) {
+        for (const app_event_t& event : replay) {
+            bench_millis += BENCH_COMMAND_GAP_MS;
+            uint64_t allocs_before = allocations;
+
+            bench_clock::time_point t0 = bench_clock::now();
+            render_dispatch(&event, bench_millis);
+            sprite_manager_update(&manager, bench_millis);
+            sprite_render_layers(&manager, cat, bench_millis);
+            bench_clock::time_point t1 = bench_clock::now();
+            lv_refr_now(NULL);
+            bench_clock::time_point t2 = bench_clock::now();
+
+            compose_s += std::chrono::duration<double>(t1 - t0).count();
+            draw_s += std::chrono::duration<double>(t2 - t1).count();
+            allocs += allocations - allocs_before;
+            events++;
+            frames++;
+        }
+    }
+
+    printf("render  %-24s %8zu B %6u cmds  %10.0f frames/s composited  %8.0f frames/s drawn  %.1f px/frame  %.3f allocs/cmd\n",
+           name, trace.size(), (unsigned)replay.size(),
+           frames / compose_s, frames / (compose_s + draw_s),
+           (double)flushed_pixels / frames, (double)allocs / events);
+}
+
+int main(int argc, char** argv) {
+    static const char* const default_traces[] = {
+        "bench/traces/text_session.bin",
+        "bench/traces/binary_session.bin",
+    };
+
+    std::vector<const char*> paths;
+    for (int i = 1; i < argc; i++) paths.push_back(argv[i]);
+    if (paths.empty()) paths.assign(default_traces, default_traces + 2);
+
+    printf("Bongo Cat native bench (%s)\n", BENCH_COUNTS_MALLOC ? "malloc counted" : "only new counted");
+    render_setup();
+
+    bool parse_allocation_free = true;
+    for (const char* path : paths) {
+        std::vector<uint8_t> trace;
+        if (!load_trace(path, &trace) || trace.empty()) {
+            printf("cannot read %s\n", path);
+            return 2;
+        }
+
+        const char* name = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+        parse_allocation_free = bench_parse(name, trace) && parse_allocation_free;
+        bench_render(name, trace);
+    }
+
+    if (!parse_allocation_free) {
+        printf("FAIL: the parse path allocated\n");
+        return 1;
+    }
+    return 0;
+}
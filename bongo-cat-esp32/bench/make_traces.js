@@ -0,0 +1,155 @@
+/**
+ * Generate the replay traces for the native benchmark
+ *
+ *   node bench/make_traces.js
+ *
+ * Writes bench/traces/text_session.bin and bench/traces/binary_session.bin:
+ * the bytes the Electron app would write to the port during a ~10 minute
+ * session of typing bursts and pauses, once over text commands and once
+ * with negotiated STATS and KEYS frames. The frames come from the app's own
+ * encoders, and a seeded generator keeps the traces identical between runs.
+ */
+
+const fs = require('fs');
+const path = require('path');
+const { encodeStatsFrame, encodeKeysFrame, KEYS_MAX } = require('../../bongo-cat-electron/src/binary-protocol');
+
+const TICKS = 600;                // One stats update per second
+const MIN_COMMAND_INTERVAL = 50;   // SerialManager.minCommandInterval (ms)
+const OUT_DIR = path.join(__dirname, 'traces');
+
+/**
+ * Deterministic PRNG (mulberry32)
+ */
+function createRandom(seed) {
+    let state = seed >>> 0;
+    return () => {
+        state = (state + 0x6D2B79F5) >>> 0;
+        let t = state;
+        t = Math.imul(t ^ (t >>> 15), t | 1);
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+}
+
+/**
+ * One second per tick: typing bursts of 5-40 s separated by 3-60 s pauses
+ */
+function createSession(seed) {
+    const random = createRandom(seed);
+    const ticks = [];
+    let typing = false;
+    let remaining = 0;
+    let wpm = 0;
+
+    for (let second = 0; second < TICKS; second++) {
+        if (remaining-- <= 0) {
+            typing = !typing;
+            remaining = typing ? 5 + Math.floor(random() * 35) : 3 + Math.floor(random() * 57);
+        }
+
+        wpm = typing ? Math.round(Math.min(140, Math.max(20, wpm * 0.7 + (40 + random() * 90) * 0.3))) : 0;
+        const keysPerSecond = typing ? Math.round(wpm * 5 / 60) : 0;
+        const keys = [];
+        for (let i = 0; i < keysPerSecond; i++) {
+            keys.push({ timestamp: second * 1000 + Math.round(i * 1000 / keysPerSecond + random() * 20), right: random() < 0.5 });
+        }
+
+        ticks.push({
+            second,
+            typing,
+            streak: typing && wpm > 100,
+            cpu: Math.round(5 + random() * 30 + (typing ? 10 : 0)),
+            ram: Math.round(48 + random() * 4),
+            wpm,
+            speed: typing ? wpmToAnimationSpeed(wpm) : 0,
+            keys
+        });
+    }
+    return ticks;
+}
+
+/**
+ * Same mapping as SerialManager.wpmToAnimationSpeed (500 ms idle .. 30 ms at 200 WPM)
+ */
+function wpmToAnimationSpeed(wpm) {
+    const clampedWpm = Math.min(wpm, 200);
+    return Math.max(Math.min(Math.round(500 - clampedWpm / 200 * 470), 500), 30);
+}
+
+function formatTime(second) {
+    const minutes = 9 * 60 + 41 + Math.floor(second / 60);
+    const hour = Math.floor(minutes / 60) % 24;
+    return `${hour % 12 || 12}:${String(minutes % 60).padStart(2, '0')} ${hour < 12 ? 'AM' : 'PM'}`;
+}
+
+/**
+ * Text protocol: what sendStats / sendAnimationSpeed write line by line
+ */
+function textSession(ticks) {
+    const lines = ['PING', 'DISPLAY_CPU:ON', 'DISPLAY_RAM:ON', 'DISPLAY_WPM:ON', 'DISPLAY_TIME:ON'];
+    let lastTime = null;
+    let wasTyping = false;
+    let wasStreak = false;
+
+    for (const tick of ticks) {
+        const time = formatTime(tick.second);
+        if (time !== lastTime) {
+            lines.push(`TIME:${time}`);
+            lastTime = time;
+        }
+        lines.push(`STATS:CPU:${tick.cpu},RAM:${tick.ram},WPM:${tick.wpm}`);
+
+        if (tick.streak !== wasStreak) {
+            lines.push(tick.streak ? 'STREAK_ON' : 'STREAK_OFF');
+            wasStreak = tick.streak;
+        }
+        if (tick.typing) {
+            lines.push(`SPEED:${tick.speed}`);
+        } else if (wasTyping) {
+            lines.push('STOP');
+        }
+        wasTyping = tick.typing;
+
+        if (tick.second % 30 === 0) lines.push('PING');
+    }
+    return Buffer.from(lines.map((line) => `${line}\n`).join(''), 'utf8');
+}
+
+/**
+ * Binary protocol: a STATS frame per tick, key-downs batched into KEYS frames
+ */
+function binarySession(ticks) {
+    const chunks = [Buffer.from('PING\nPROTO:BIN\nPROTO:KEYS\n'), Buffer.from('DISPLAY_CPU:ON\nDISPLAY_TIME:ON\n')];
+    let lastTime = null;
+
+    for (const tick of ticks) {
+        const time = formatTime(tick.second);
+        if (time !== lastTime) {
+            chunks.push(Buffer.from(`TIME:${time}\n`));
+            lastTime = time;
+        }
+
+        // Keys that arrive within one command interval share a frame, like sendKeyEvent
+        let batch = [];
+        for (const key of tick.keys) {
+            if (batch.length > 0 && (key.timestamp - batch[0].timestamp >= MIN_COMMAND_INTERVAL || batch.length === KEYS_MAX)) {
+                chunks.push(encodeKeysFrame(batch));
+                batch = [];
+            }
+            batch.push(key);
+        }
+        if (batch.length > 0) chunks.push(encodeKeysFrame(batch));
+        chunks.push(encodeStatsFrame(tick));
+
+        if (tick.second % 30 === 0) chunks.push(Buffer.from('PING\n'));
+    }
+    return Buffer.concat(chunks);
+}
+
+const ticks = createSession(0xB0C0CA7);
+fs.mkdirSync(OUT_DIR, { recursive: true });
+for (const [name, data] of [['text_session.bin', textSession(ticks)], ['binary_session.bin', binarySession(ticks)]]) {
+    fs.writeFileSync(path.join(OUT_DIR, name), data);
+    console.log(`${name}: ${data.length} bytes`);
+}
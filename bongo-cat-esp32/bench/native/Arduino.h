@@ -0,0 +1,71 @@
+#ifndef BENCH_ARDUINO_H
+#define BENCH_ARDUINO_H
+
+// Native stand-in for the Arduino core, just what the shared firmware
+// modules use. Time is virtual (the bench sets it), Serial output is
+// discarded, the CPU clock calls only remember the value. LVGL's C sources
+// include it for the tick (LV_TICK_CUSTOM_INCLUDE) and only see millis().
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bench clock in ms, also LVGL's tick (LV_TICK_CUSTOM_SYS_TIME_EXPR)
+extern uint32_t bench_millis;
+
+static inline uint32_t millis(void) {
+    return bench_millis;
+}
+
+#ifdef __cplusplus
+}
+
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+static inline long random(long max_value) {
+    return max_value > 0 ? rand() % max_value : 0;
+}
+
+static inline long random(long min_value, long max_value) {
+    return max_value > min_value ? min_value + random(max_value - min_value) : min_value;
+}
+
+static inline void randomSeed(unsigned long seed) {
+    srand((unsigned)seed);
+}
+
+extern uint32_t bench_cpu_mhz;
+
+static inline bool setCpuFrequencyMhz(uint32_t mhz) {
+    bench_cpu_mhz = mhz;
+    return true;
+}
+
+static inline uint32_t getCpuFrequencyMhz() {
+    return bench_cpu_mhz;
+}
+
+class BenchSerial {
+public:
+    template <typename T> size_t print(const T&) { return 0; }
+    template <typename T> size_t print(const T&, int) { return 0; }
+    template <typename T> size_t println(const T&) { return 0; }
+    template <typename T> size_t println(const T&, int) { return 0; }
+    size_t println() { return 0; }
+};
+
+extern BenchSerial Serial;
+
+#endif // __cplusplus
+
+#endif // BENCH_ARDUINO_H
@@ -0,0 +1,34 @@
+#ifndef BENCH_ESP_HEAP_CAPS_H
+#define BENCH_ESP_HEAP_CAPS_H
+
+// Native stand-in for ESP-IDF's capability allocator: one plain heap
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+
+static inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    return malloc(size);
+}
+
+static inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+// No heap statistics on the host (the MEM line shows 0)
+static inline size_t heap_caps_get_free_size(uint32_t caps) {
+    return 0;
+}
+
+static inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return 0;
+}
+
+static inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return 0;
+}
+
+#endif // BENCH_ESP_HEAP_CAPS_H
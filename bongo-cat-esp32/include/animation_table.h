@@ -0,0 +1,157 @@
+#ifndef ANIMATION_TABLE_H
+#define ANIMATION_TABLE_H
+
+#include "animations_sprites.h"
+
+// Declarative animation description
+//
+// Every animation_state_t has one row in anim_states: the layers it sets on
+// entry, an optional frame sequence started on entry, the layers it falls
+// back to when that sequence stops (or right away without one) and where
+// idle progression goes next. Blinks and ear twitches are overlays that
+// swap one layer for a while in any state that allows them.
+//
+// The sprite manager in sprite_manager.cpp interprets these tables; a new animation
+// or state is a new row here, not another branch there.
+//
+// Only the sprite manager needs these (the tables are constexpr, so every
+// translation unit that includes them gets its own copy).
+
+// Timings (ms)
+#define BLINK_DURATION_MS 200
+#define EAR_TWITCH_DURATION_MS 500
+#define SLEEPY_EFFECT_PERIOD_MS 1000
+#define KEY_STRIKE_MS 60              // Paw stays down per key event
+#define KEY_DRIVEN_HOLD_MS 1000       // Rate-based paws resume this long after the last key
+#define TYPING_TIMEOUT_MS 2000        // Stop typing animation after 2 seconds of no commands
+#define PYTHON_TIMEOUT_MS 5000        // Fall back to auto mode after 5 seconds
+
+// Key events play frames of the state's paw sequence (every paw sequence is
+// left strike, rest, right strike, rest); one that arrives while the cat is
+// not typing wakes it into KEY_WAKE_STATE first
+#define ANIM_PAW_LEFT_FRAME 0
+#define ANIM_PAW_REST_FRAME 1
+#define ANIM_PAW_RIGHT_FRAME 2
+#define KEY_WAKE_STATE ANIM_STATE_TYPING_NORMAL
+
+#define LAYER_BIT(layer) (1u << (layer))
+#define LAYERS_BASE (LAYER_BIT(LAYER_BODY) | LAYER_BIT(LAYER_FACE) | LAYER_BIT(LAYER_TABLE))
+#define LAYERS_HANDS (LAYER_BIT(LAYER_PAWS) | LAYER_BIT(LAYER_EFFECTS))
+
+// Layers in set_mask are written (NULL hides the layer), the others are kept
+typedef struct {
+    uint8_t set_mask;
+    const lv_img_dsc_t* sprites[NUM_LAYERS];   // Indexed by sprite_layer_t
+} anim_frame_t;
+
+typedef struct {
+    const anim_frame_t* frames;
+    uint8_t count;
+    uint8_t loop_to;        // Frame that follows the last one
+    uint16_t period_ms;     // Frame time (ANIM_FLAG_PAWS states use the SPEED value)
+} anim_sequence_t;
+
+enum {
+    ANIM_FLAG_TYPING = 1 << 0,  // Typing: starts the typing timeout, stops idle progression
+    ANIM_FLAG_PAWS = 1 << 1,    // Sequence is the paw pattern: SPEED timed, stops on typing timeout
+    ANIM_FLAG_IDLE = 1 << 2,    // Idle stage: the typing sprites leave the cache
+    ANIM_FLAG_BLINK = 1 << 3,   // Blinking allowed
+    ANIM_FLAG_SLEEP = 1 << 4    // Asleep: run in low power mode
+};
+
+typedef struct {
+    const char* name;
+    const char* description;            // Printed on entry (NULL: nothing)
+    uint8_t flags;
+    anim_frame_t enter;                 // Must set LAYERS_BASE (overlays restore from it)
+    const lv_img_dsc_t* streak_face;    // Face in streak mode while the sequence runs (NULL: enter face)
+    const anim_sequence_t* sequence;    // Started on entry (NULL: none)
+    anim_frame_t rest;                  // Applied when there is no sequence or it stops
+    uint8_t idle_stage;                 // 1-3: advance after that sleep stage duration, 0: stay
+    animation_state_t idle_next;
+} anim_state_desc_t;
+
+typedef struct {
+    uint8_t layer;
+    const lv_img_dsc_t* sprite;
+    uint16_t duration_ms;
+    uint16_t interval_min_ms;   // Next one after random(min, max)...
+    uint16_t interval_max_ms;
+    uint16_t blocked_min_ms;    // ...or this range if the state forbids it when it ends
+    uint16_t blocked_max_ms;
+    uint8_t required_flag;      // State flag needed to start (0: any state)
+} anim_overlay_t;
+
+// 4-step typing pattern: left down, both up, right down, both up
+constexpr anim_frame_t paw_frames[] = {
+    {LAYERS_HANDS, {NULL, NULL, NULL, &leftpawdown, NULL}},
+    {LAYERS_HANDS, {NULL, NULL, NULL, &twopawsup, NULL}},
+    {LAYERS_HANDS, {NULL, NULL, NULL, &rightpawdown, NULL}},
+    {LAYERS_HANDS, {NULL, NULL, NULL, &twopawsup, NULL}},
+};
+
+// Same pattern with click effects synchronized to the paw strikes
+constexpr anim_frame_t paw_click_frames[] = {
+    {LAYERS_HANDS, {NULL, NULL, NULL, &leftpawdown, &left_click_effect}},
+    {LAYERS_HANDS, {NULL, NULL, NULL, &twopawsup, NULL}},
+    {LAYERS_HANDS, {NULL, NULL, NULL, &rightpawdown, &right_click_effect}},
+    {LAYERS_HANDS, {NULL, NULL, NULL, &twopawsup, NULL}},
+};
+
+// Nothing for the first period, then cycle the three sleepy effects
+constexpr anim_frame_t sleepy_frames[] = {
+    {LAYER_BIT(LAYER_EFFECTS), {NULL, NULL, NULL, NULL, NULL}},
+    {LAYER_BIT(LAYER_EFFECTS), {NULL, NULL, NULL, NULL, &sleepy1}},
+    {LAYER_BIT(LAYER_EFFECTS), {NULL, NULL, NULL, NULL, &sleepy2}},
+    {LAYER_BIT(LAYER_EFFECTS), {NULL, NULL, NULL, NULL, &sleepy3}},
+};
+
+constexpr anim_sequence_t paw_sequence = {paw_frames, 4, 0, 0};
+constexpr anim_sequence_t paw_click_sequence = {paw_click_frames, 4, 0, 0};
+constexpr anim_sequence_t sleepy_sequence = {sleepy_frames, 4, 1, SLEEPY_EFFECT_PERIOD_MS};
+
+// Layouts
+#define ENTER_STOCK {LAYERS_BASE, {&standardbody1, &stock_face, &table1, NULL, NULL}}
+#define ENTER_SLEEPY {LAYERS_BASE, {&standardbody1, &sleepy_face, &table1, NULL, NULL}}
+#define ENTER_HAPPY {LAYERS_BASE, {&standardbody1, &happy_face, &table1, NULL, NULL}}
+#define REST_PAWS_UP {LAYERS_HANDS, {NULL, NULL, NULL, &twopawsup, NULL}}
+#define REST_HANDS_HIDDEN {LAYERS_HANDS, {NULL, NULL, NULL, NULL, NULL}}
+#define REST_NO_EFFECTS {LAYER_BIT(LAYER_EFFECTS), {NULL, NULL, NULL, NULL, NULL}}
+
+// One row per animation_state_t, in enum order
+constexpr anim_state_desc_t anim_states[] = {
+    {"IDLE_STAGE1", "😐 Stage 1: Stock face, paws up",
+     ANIM_FLAG_IDLE | ANIM_FLAG_BLINK, ENTER_STOCK, NULL, NULL, REST_PAWS_UP, 1, ANIM_STATE_IDLE_STAGE2},
+    {"IDLE_STAGE2", "😐 Stage 2: Stock face, hands hidden",
+     ANIM_FLAG_IDLE | ANIM_FLAG_BLINK, ENTER_STOCK, NULL, NULL, REST_HANDS_HIDDEN, 2, ANIM_STATE_IDLE_STAGE3},
+    {"IDLE_STAGE3", "😴 Stage 3: Deep sleep preparation, hands hidden",
+     ANIM_FLAG_IDLE | ANIM_FLAG_SLEEP, ENTER_SLEEPY, NULL, NULL, REST_HANDS_HIDDEN, 3, ANIM_STATE_IDLE_STAGE4},
+    {"IDLE_STAGE4", "😴 Stage 4: Deep sleep with cycling effects, hands hidden",
+     ANIM_FLAG_IDLE | ANIM_FLAG_SLEEP, {LAYERS_BASE | LAYER_BIT(LAYER_PAWS), {&standardbody1, &sleepy_face, &table1, NULL, NULL}},
+     NULL, &sleepy_sequence, REST_HANDS_HIDDEN, 0, ANIM_STATE_IDLE_STAGE4},
+    {"TYPING_SLOW", "👐 Slow typing",
+     ANIM_FLAG_TYPING | ANIM_FLAG_PAWS | ANIM_FLAG_BLINK, ENTER_STOCK, &happy_face, &paw_sequence, REST_NO_EFFECTS, 0, ANIM_STATE_TYPING_SLOW},
+    {"TYPING_NORMAL", "👐 Normal typing",
+     ANIM_FLAG_TYPING | ANIM_FLAG_PAWS | ANIM_FLAG_BLINK, ENTER_STOCK, &happy_face, &paw_sequence, REST_NO_EFFECTS, 0, ANIM_STATE_TYPING_NORMAL},
+    {"TYPING_FAST", "👐⚡ Fast typing with click effects",
+     ANIM_FLAG_TYPING | ANIM_FLAG_PAWS | ANIM_FLAG_BLINK, ENTER_STOCK, &happy_face, &paw_click_sequence, REST_NO_EFFECTS, 0, ANIM_STATE_TYPING_FAST},
+    {"TYPING_STREAK", "👐⚡😊 Legacy streak mode - fast typing with happy face",  // Kept for compatibility but unused
+     ANIM_FLAG_PAWS | ANIM_FLAG_BLINK, ENTER_HAPPY, NULL, &paw_click_sequence, REST_NO_EFFECTS, 0, ANIM_STATE_TYPING_STREAK},
+    {"BLINKING", NULL,
+     ANIM_FLAG_BLINK, ENTER_STOCK, NULL, NULL, REST_NO_EFFECTS, 0, ANIM_STATE_BLINKING},
+    {"EAR_TWITCH", NULL,
+     ANIM_FLAG_BLINK, ENTER_STOCK, NULL, NULL, REST_NO_EFFECTS, 0, ANIM_STATE_EAR_TWITCH},
+};
+
+static_assert(sizeof(anim_states) / sizeof(anim_states[0]) == ANIM_STATE_COUNT, "anim_states needs one row per animation_state_t");
+
+// One row per anim_overlay_id_t
+constexpr anim_overlay_t anim_overlays[] = {
+    // Blink only while awake; one that ends in a sleepy state waits longer
+    {LAYER_FACE, &blink_face, BLINK_DURATION_MS, 3000, 8000, 5000, 10000, ANIM_FLAG_BLINK},
+    {LAYER_BODY, &bodyeartwitch, EAR_TWITCH_DURATION_MS, 10000, 30000, 10000, 30000, 0},
+};
+
+static_assert(sizeof(anim_overlays) / sizeof(anim_overlays[0]) == ANIM_OVERLAY_COUNT, "anim_overlays needs one row per anim_overlay_id_t");
+
+#endif // ANIMATION_TABLE_H
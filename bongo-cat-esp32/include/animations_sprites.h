@@ -16,6 +16,35 @@
     #include "lvgl/lvgl.h"
 #endif
 
+// External declarations for all sprites
+extern const lv_img_dsc_t standardbody1;
+extern const lv_img_dsc_t bodyeartwitch;
+extern const lv_img_dsc_t stock_face;
+extern const lv_img_dsc_t happy_face;
+extern const lv_img_dsc_t blink_face;
+extern const lv_img_dsc_t sleepy_face;
+extern const lv_img_dsc_t leftpawdown;
+extern const lv_img_dsc_t rightpawdown;
+extern const lv_img_dsc_t twopawsup;
+extern const lv_img_dsc_t table1;
+extern const lv_img_dsc_t left_click_effect;
+extern const lv_img_dsc_t right_click_effect;
+extern const lv_img_dsc_t sleepy1;
+extern const lv_img_dsc_t sleepy2;
+extern const lv_img_dsc_t sleepy3;
+
+// Sprite data, compiled once by src/sprite_data.cpp (which defines
+// ANIMATIONS_SPRITES_DATA): run-length encoded atlas by default (generated
+// by python_scripts/pack_sprites.py), -DSPRITE_ATLAS=0 for the raw RGB565A8
+// arrays. It comes after the extern declarations so the definitions get
+// external linkage.
+#ifndef SPRITE_ATLAS
+#define SPRITE_ATLAS 1
+#endif
+
+#if defined(ANIMATIONS_SPRITES_DATA) && SPRITE_ATLAS
+#include "../lib/bongo_cat_animations/src/atlas/sprite_atlas.c"
+#elif defined(ANIMATIONS_SPRITES_DATA)
 // Body sprites
 #include "../lib/bongo_cat_animations/src/body/standardbody1.c"
 #include "../lib/bongo_cat_animations/src/body/bodyeartwitch.c"
@@ -40,23 +69,7 @@
 #include "../lib/bongo_cat_animations/src/effects/sleepy1.c"
 #include "../lib/bongo_cat_animations/src/effects/sleepy2.c"
 #include "../lib/bongo_cat_animations/src/effects/sleepy3.c"
-
-// External declarations for all sprites
-extern const lv_img_dsc_t standardbody1;
-extern const lv_img_dsc_t bodyeartwitch;
-extern const lv_img_dsc_t stock_face;
-extern const lv_img_dsc_t happy_face;
-extern const lv_img_dsc_t blink_face;
-extern const lv_img_dsc_t sleepy_face;
-extern const lv_img_dsc_t leftpawdown;
-extern const lv_img_dsc_t rightpawdown;
-extern const lv_img_dsc_t twopawsup;
-extern const lv_img_dsc_t table1;
-extern const lv_img_dsc_t left_click_effect;
-extern const lv_img_dsc_t right_click_effect;
-extern const lv_img_dsc_t sleepy1;
-extern const lv_img_dsc_t sleepy2;
-extern const lv_img_dsc_t sleepy3;
+#endif
 
 // Sprite layer definitions (Z-order from back to front)
 typedef enum {
@@ -79,40 +92,77 @@ typedef enum {
     ANIM_STATE_TYPING_FAST,         // Stock face, fast paws + click effects
     ANIM_STATE_TYPING_STREAK,       // Happy face, ultra-fast paws
     ANIM_STATE_BLINKING,            // Brief blink animation
-    ANIM_STATE_EAR_TWITCH           // Body sprite swap
+    ANIM_STATE_EAR_TWITCH,          // Body sprite swap
+    ANIM_STATE_COUNT
 } animation_state_t;
 
-// Sprite management structure
+// Temporary single-layer swaps that run on top of any state
+typedef enum {
+    ANIM_OVERLAY_BLINK = 0,
+    ANIM_OVERLAY_EAR_TWITCH,
+    ANIM_OVERLAY_COUNT
+} anim_overlay_id_t;
+
+// Key events waiting to be played (same encoding as BINARY_TYPE_KEYS)
+#define KEY_QUEUE_SIZE 16
+#define KEY_EVENT_RIGHT 0x80
+#define KEY_EVENT_GAP_MASK 0x7F
+
+// Sprite management structure (layouts and timings live in animation_table.h)
 typedef struct {
     const lv_img_dsc_t* current_sprites[NUM_LAYERS];
     animation_state_t current_state;
     uint32_t state_start_time;
-    uint32_t blink_timer;
-    uint32_t ear_twitch_timer;
-    uint32_t effect_timer;
-    uint8_t effect_frame;           // For sleepy effect animation (0,1,2)
-    bool paw_animation_active;
-    uint8_t paw_frame;              // Now 0-3 for 4-step typing pattern
-    uint32_t paw_timer;
-    uint16_t animation_speed_ms;
-    bool click_effect_left;         // For alternating click effects
+    
+    // Frame sequence of the current state (paw pattern, sleepy effects)
+    bool sequence_active;
+    uint8_t sequence_frame;
+    uint32_t sequence_timer;        // When the current frame was due (the next one is a period later)
+    uint32_t sequence_skipped;      // Frames passed over to stay on schedule
+    uint16_t animation_speed_ms;    // Paw frame time, set by SPEED
     
     // Enhanced animation control
     bool idle_progression_enabled;  // Allow automatic idle progression
     uint32_t last_typing_time;      // Track last typing command for timeout
     bool is_streak_mode;            // Flag for happy face during typing streak
+    bool python_control_mode;       // Host drives idle progression (until PYTHON_TIMEOUT_MS of silence)
+    uint32_t last_command_time;     // Last command from the host
+    int sleep_timeout_minutes;      // Settings copy: spreads the idle stages over this time
     
-    // Animation state variables (moved from static to prevent timing issues)
-    uint32_t blink_start_time;      // When current blink started
-    bool blinking;                  // Currently blinking
-    uint32_t ear_twitch_start_time; // When current ear twitch started  
-    bool ear_twitching;             // Currently ear twitching
+    // Key events (PROTO:KEYS): each key-down strikes a paw, and the rate-based
+    // sequence pauses while they keep coming
+    uint32_t last_key_time;         // 0 = none yet
+    bool strike_active;             // A paw is down, released after KEY_STRIKE_MS
+    uint32_t strike_time;
+    uint8_t key_queue[KEY_QUEUE_SIZE];  // Later keys of a batch: KEY_EVENT_RIGHT | gap ms
+    uint8_t key_queue_head;
+    uint8_t key_queue_count;
+    uint32_t key_next_time;         // When key_queue[key_queue_head] is due
+    
+    // Blink / ear twitch state
+    bool overlay_active[ANIM_OVERLAY_COUNT];
+    uint32_t overlay_start[ANIM_OVERLAY_COUNT];  // When the running one started
+    uint32_t overlay_next[ANIM_OVERLAY_COUNT];   // When the next one is due
 } sprite_manager_t;
 
-// Function declarations
+// Longest sprite_manager_next_deadline() looks ahead
+#define SPRITE_MANAGER_MAX_WAIT_MS 1000
+
+// Function declarations (src/sprite_manager.cpp; no LVGL objects, no tasks,
+// so it also runs in the native benchmark)
 void sprite_manager_init(sprite_manager_t* manager);
 void sprite_manager_update(sprite_manager_t* manager, uint32_t current_time);
+uint32_t sprite_manager_next_deadline(const sprite_manager_t* manager, uint32_t current_time);
 void sprite_manager_set_state(sprite_manager_t* manager, animation_state_t new_state, uint32_t current_time);
+
+// Play a batch of key-down events: the first strikes now, the rest follow at their gaps
+void sprite_manager_key_events(sprite_manager_t* manager, const uint8_t* events, uint8_t count, uint32_t current_time);
 void sprite_render_layers(sprite_manager_t* manager, lv_obj_t* canvas, uint32_t current_time);
 
+// Typing speed from SPEED or a binary STATS frame (picks the typing state), and STOP
+void sprite_manager_apply_speed(sprite_manager_t* manager, uint16_t speed, uint32_t current_time);
+void sprite_manager_stop(sprite_manager_t* manager, uint32_t current_time);
+
+const char* get_state_name(animation_state_t state);
+
 #endif // ANIMATIONS_SPRITES_H 
\ No newline at end of file
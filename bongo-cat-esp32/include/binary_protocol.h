@@ -0,0 +1,92 @@
+#ifndef BINARY_PROTOCOL_H
+#define BINARY_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Compact binary framing used alongside the text commands
+//
+//   [0xA5] [len] [type] [payload: len bytes] [crc16 lo] [crc16 hi]
+//
+// The CRC is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over len, type
+// and payload. Text commands are plain ASCII, so the 0xA5 start byte never
+// shows up in them and both can share the same serial stream. The host asks
+// for binary mode with PROTO:BIN and uses it once the device answers
+// PROTO:BIN_OK. Multi-byte fields are little endian.
+//
+// Plain C/C++, no Arduino dependency. Keep in sync with
+// bongo-cat-electron/src/binary-protocol.js.
+
+#define BINARY_FRAME_START 0xA5
+#define BINARY_MAX_PAYLOAD 32
+
+// Frame types
+#define BINARY_TYPE_STATS 0x01   // binary_stats_t: all stats, speed and flags
+#define BINARY_TYPE_KEYS 0x02    // binary_keys_t: key-down events (needs PROTO:KEYS)
+
+// binary_stats_t flags
+#define BINARY_FLAG_TYPING 0x01  // User is typing, speed is valid
+#define BINARY_FLAG_STREAK 0x02  // Streak mode (happy face)
+
+#define BINARY_STATS_PAYLOAD_SIZE 7
+
+// KEYS payload: one byte per key-down, oldest first. The low bits are the ms
+// since the previous key in the frame (0 for the first), the top bit the
+// hand that plays it.
+#define BINARY_KEYS_MAX 16
+#define BINARY_KEY_RIGHT 0x80
+#define BINARY_KEY_GAP_MASK 0x7F
+
+// Decoded STATS frame
+typedef struct {
+    uint8_t cpu;         // CPU usage in %
+    uint8_t ram;         // RAM usage in %
+    uint16_t wpm;        // Words per minute
+    uint16_t speed;      // Animation speed, same scale as SPEED:<value>
+    uint8_t flags;       // BINARY_FLAG_*
+} binary_stats_t;
+
+// Decoded KEYS frame
+typedef struct {
+    uint8_t count;
+    uint8_t events[BINARY_KEYS_MAX];   // BINARY_KEY_RIGHT | gap ms
+} binary_keys_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t len;
+    uint8_t payload[BINARY_MAX_PAYLOAD];
+} binary_frame_t;
+
+typedef enum {
+    BINARY_PASS,      // Byte is not part of a frame (hand it to the text parser)
+    BINARY_PENDING,   // Byte consumed, frame not complete yet
+    BINARY_FRAME,     // Byte completed a valid frame
+    BINARY_ERROR      // Byte completed a corrupt frame, it was dropped
+} binary_result_t;
+
+typedef struct {
+    uint8_t state;
+    uint8_t index;
+    uint16_t crc;
+    binary_frame_t frame;
+    uint32_t frames_ok;
+    uint32_t frames_bad;
+} binary_decoder_t;
+
+void binary_decoder_init(binary_decoder_t* decoder);
+
+// Push one received byte. On BINARY_FRAME the frame is copied to *out.
+binary_result_t binary_decoder_feed(binary_decoder_t* decoder, uint8_t byte, binary_frame_t* out);
+
+// CRC-16/CCITT-FALSE
+uint16_t binary_crc16(uint16_t crc, const uint8_t* data, size_t len);
+
+// Decode a STATS frame payload (false if the frame is not a valid STATS frame)
+bool binary_decode_stats(const binary_frame_t* frame, binary_stats_t* stats);
+
+// Decode a KEYS frame payload (false if the frame is not a valid KEYS frame)
+bool binary_decode_keys(const binary_frame_t* frame, binary_keys_t* keys);
+
+#endif // BINARY_PROTOCOL_H
@@ -0,0 +1,52 @@
+#ifndef CAT_COMPOSITOR_H
+#define CAT_COMPOSITOR_H
+
+#include <lvgl.h>
+
+// Cat geometry
+#define CAT_SIZE 64     // Base sprite size
+#define CAT_SCALE 4     // On-screen pixels per sprite pixel (64x64 -> 256x256)
+#define CAT_SCREEN_SIZE (CAT_SIZE * CAT_SCALE)
+
+#define CAT_MAX_LAYERS 8     // Layers tracked for change detection
+#define CAT_MAX_SPRITES 32   // Sprites with precomputed bounding boxes
+
+// Pre-scaled sprite compositor
+//
+// The sprite layers are blended once into a 64x64 frame whenever they change.
+// At draw time every frame pixel is written as a CAT_SCALE x CAT_SCALE block
+// straight into LVGL's draw buffer, so no generic image transform is involved.
+// The frame is blended onto the screen background and is therefore always
+// opaque, which lets LVGL skip drawing anything underneath the cat.
+//
+// Every sprite has an opaque bounding box (computed once at registration).
+// A render only recomposes and invalidates the union of the old and new boxes
+// of the layers that actually changed, so a paw swap only flushes the paws.
+//
+// Sprites may be raw RGB565A8 / TRUE_COLOR arrays or run-length encoded
+// atlas entries (see sprite_rle.h); encoded ones are blended run by run.
+// Raw RGB565A8 sprites with only fully transparent or fully opaque pixels
+// also get a visibility mask per row at registration, so their visible
+// runs are copied whole and the transparent ones skipped. Fills and the
+// 4x expansion write two pixels per 32-bit store (pixel_ops.h).
+//
+// The compositor works on plain lv_img_dsc_t pointers and never needs the
+// sprite names from animations_sprites.h.
+
+// Create the cat object (CAT_SCREEN_SIZE x CAT_SCREEN_SIZE) on a parent
+lv_obj_t* cat_compositor_create(lv_obj_t* parent, lv_color_t background);
+
+// Precompute bounding boxes for a sprite set (call once at startup)
+void cat_compositor_register_sprites(const lv_img_dsc_t* const* sprites, uint8_t count);
+
+// Opaque bounding box of a sprite in sprite pixels (false if fully transparent)
+bool cat_compositor_get_bounds(const lv_img_dsc_t* sprite, lv_area_t* box);
+
+// Blend changed layers back to front (NULL entries are empty) and invalidate
+// only the area they touch. Does nothing when no layer changed.
+void cat_compositor_render(lv_obj_t* cat, const lv_img_dsc_t* const* layers, uint8_t layer_count);
+
+// Force the next render to recompose and invalidate the whole cat
+void cat_compositor_invalidate(lv_obj_t* cat);
+
+#endif // CAT_COMPOSITOR_H
@@ -0,0 +1,91 @@
+#ifndef DISPLAY_BACKEND_H
+#define DISPLAY_BACKEND_H
+
+#include <lvgl.h>
+#include <TFT_eSPI.h>
+
+// Height of each LVGL draw buffer in display lines (override with -D)
+#ifndef DISPLAY_DRAW_BUF_LINES
+#define DISPLAY_DRAW_BUF_LINES 20
+#endif
+
+// Burst refresh: lines per burst buffer (two are used; 0 disables bursts)
+#ifndef DISPLAY_BURST_LINES
+#define DISPLAY_BURST_LINES 80
+#endif
+
+// Share of the screen that has to be invalid for a burst (%)
+#ifndef DISPLAY_BURST_MIN_PERCENT
+#define DISPLAY_BURST_MIN_PERCENT 75
+#endif
+
+// DMA-capable memory a burst leaves free for everything else (bytes)
+#define DISPLAY_BURST_HEAP_RESERVE 32768
+
+// SPI write clock probe (needs display_spi_clock.h force-included, see platformio.ini)
+#ifndef DISPLAY_SPI_PROBE_MAX_HZ
+#define DISPLAY_SPI_PROBE_MAX_HZ 80000000
+#endif
+#define DISPLAY_SPI_PROBE_MIN_HZ 20000000
+#define DISPLAY_SPI_PROBE_ROUNDS 8        // Pattern bands that must survive per clock
+
+// Double-buffered DMA display backend
+//
+// With ESP32_DMA two DMA-capable draw buffers are registered with LVGL. Each
+// flush starts a pushImageDMA transfer and returns at once, so LVGL renders
+// the next band into the other buffer while the previous one is still on the
+// SPI bus. TFT_eSPI has no completion callback, so the transfer is polled:
+// LVGL's wait_cb and display_backend_poll() call lv_disp_flush_ready() as soon
+// as the DMA reports it is done.
+//
+// If DMA is not compiled in, the buffers cannot be allocated or initDMA()
+// fails, it falls back to one static buffer and blocking pushColors().
+//
+// Small bands suit animation, where only the paws change, but a cold start
+// or a screen change makes LVGL redraw every object once per band and send
+// 16 small transfers. When a frame is about to redraw at least
+// DISPLAY_BURST_MIN_PERCENT of the screen, display_backend_begin_frame()
+// swaps in two DISPLAY_BURST_LINES buffers carved from free DMA memory (as
+// many lines as fit), and the next frame that is back to dirty regions
+// swaps the small buffers in again and frees them.
+//
+// The SPI write clock is probed once at boot: pseudo-random bands are
+// written at each clock the SPI peripheral can make (80 MHz / n) from
+// DISPLAY_SPI_PROBE_MAX_HZ down and read back over MISO at the fixed
+// SPI_READ_FREQUENCY. The fastest clock without a single wrong pixel is
+// kept. If read-back does not work even at the slowest clock, the probe
+// gives up and DISPLAY_SPI_DEFAULT_HZ stays.
+
+// Probe the SPI write clock (after tft.init, before display_backend_init;
+// scribbles on the top lines of the screen). Returns the clock in Hz.
+uint32_t display_backend_probe_spi(TFT_eSPI* tft);
+
+// Set up draw buffers and register the LVGL display driver (after lv_init)
+lv_disp_t* display_backend_init(TFT_eSPI* tft, lv_coord_t width, lv_coord_t height);
+
+// Choose burst or band buffers for the next refresh. Call before
+// lv_timer_handler() / lv_refr_now() while no flush is in flight.
+void display_backend_begin_frame();
+
+// Signal flush-ready if the running transfer has finished (call from loop)
+void display_backend_poll();
+
+// Block until no transfer is in flight and release the SPI bus.
+// Call before anything else uses the bus (e.g. touch reads).
+void display_backend_wait_idle();
+
+// True when the DMA path is active
+bool display_backend_dma_enabled();
+
+// SPI write clock in use (Hz)
+uint32_t display_backend_spi_hz();
+
+// Frames drawn with burst buffers since boot
+uint32_t display_backend_burst_count();
+
+// Cross-task ownership of the SPI bus shared by display and touch.
+// The render task holds it while LVGL flushes; other users take it briefly.
+bool display_backend_lock_bus(uint32_t timeout_ms);
+void display_backend_unlock_bus();
+
+#endif // DISPLAY_BACKEND_H
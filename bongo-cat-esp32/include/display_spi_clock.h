@@ -0,0 +1,35 @@
+#ifndef DISPLAY_SPI_CLOCK_H
+#define DISPLAY_SPI_CLOCK_H
+
+// Runtime SPI write clock for TFT_eSPI
+//
+// TFT_eSPI reads SPI_FREQUENCY every time it opens a write transaction and
+// once in initDMA(), when it adds the DMA device. platformio.ini
+// force-includes this header into every file (TFT_eSPI's included) so that
+// SPI_FREQUENCY names a variable, which display_backend_probe_spi() raises
+// at boot to the fastest clock that survives a write / read-back test.
+// Until then, and whenever the probe cannot run, the clock is
+// DISPLAY_SPI_DEFAULT_HZ.
+
+#ifndef DISPLAY_SPI_DEFAULT_HZ
+#define DISPLAY_SPI_DEFAULT_HZ 40000000
+#endif
+
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t display_spi_frequency;
+
+#ifdef __cplusplus
+}
+#endif
+#endif // __ASSEMBLER__
+
+#undef SPI_FREQUENCY
+#define SPI_FREQUENCY display_spi_frequency
+
+#endif // DISPLAY_SPI_CLOCK_H
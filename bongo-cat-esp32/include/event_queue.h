@@ -0,0 +1,73 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+#include "binary_protocol.h"
+
+// Queue capacity in events (override with -D, must be a power of two)
+#ifndef EVENT_QUEUE_SIZE
+#define EVENT_QUEUE_SIZE 32
+#endif
+
+// Longest command argument carried by an event (longer ones are truncated)
+#define APP_EVENT_ARG_MAX 47
+
+// Lock-free single producer / single consumer event queue
+//
+// The I/O task (core 0) turns serial lines, binary frames, touches and sensor
+// readings into typed app_event_t values and pushes them here; the render
+// task (core 1) pops and applies them. Exactly one task may push and exactly
+// one may pop. Neither side ever blocks: a full queue drops the event and
+// counts it.
+
+typedef enum {
+    APP_EVENT_COMMAND,   // Text command: verb hash + argument
+    APP_EVENT_FRAME,     // Binary protocol frame
+    APP_EVENT_TOUCH,     // Touch down / move / up
+    APP_EVENT_SENSOR,    // AHT30 reading
+    APP_EVENT_BOOT       // Background boot stage done (settings, touch, AHT30)
+} app_event_type_t;
+
+typedef struct {
+    uint8_t type;      // app_event_type_t
+    uint32_t time_us;  // micros() when the I/O task posted it
+    union {
+        struct {
+            uint32_t verb_hash;                 // serial_hash(verb)
+            char arg[APP_EVENT_ARG_MAX + 1];
+        } command;
+        binary_frame_t frame;
+        struct {
+            uint8_t phase;      // TouchEventType: down / move / up
+            uint16_t x;
+            uint16_t y;
+        } touch;
+        struct {
+            float temperature;
+            float humidity;
+            bool ok;
+        } sensor;
+    };
+} app_event_t;
+
+typedef struct {
+    app_event_t slots[EVENT_QUEUE_SIZE];
+    std::atomic<uint32_t> head;   // Written by the producer only
+    std::atomic<uint32_t> tail;   // Written by the consumer only
+    std::atomic<uint32_t> dropped;
+} event_queue_t;
+
+void event_queue_init(event_queue_t* queue);
+
+// Producer side: false (and dropped++) when the queue is full
+bool event_queue_push(event_queue_t* queue, const app_event_t* event);
+
+// Consumer side: false when the queue is empty
+bool event_queue_pop(event_queue_t* queue, app_event_t* event);
+
+// Approximate number of queued events (either side)
+uint32_t event_queue_count(const event_queue_t* queue);
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,44 @@
+#ifndef GLYPH_STRIP_H
+#define GLYPH_STRIP_H
+
+#include <lvgl.h>
+
+// Characters the strip holds: digits, stats separators and the fixed
+// "CPU: ", "RAM: ", "WPM: " and " AM"/" PM" letters. Anything else is drawn
+// as a blank cell.
+#define GLYPH_STRIP_CHARSET " 0123456789%:ACMPRUW"
+
+// Largest cell the strip has room for (unscii 16 is 8x16)
+#define GLYPH_CELL_MAX_W 8
+#define GLYPH_CELL_MAX_H 16
+
+#define GLYPH_TEXT_MAX_CELLS 12
+
+// Pre-rendered fixed-width text
+//
+// glyph_strip_init rasterizes the charset of a monospaced bitmap font once
+// into an RGB565 strip, already blended onto the background colour. A glyph
+// text object is a row of fixed cells: setting a new string compares it cell
+// by cell and invalidates only the cells that changed, and drawing copies
+// glyph rows straight into LVGL's draw buffer, with no glyph lookup, kerning
+// or label layout. The cells are opaque, so nothing underneath is redrawn.
+// All calls belong to the render task.
+
+typedef struct {
+    lv_obj_t* obj;
+    uint8_t cells;
+    bool align_right;                       // Short strings hug the right edge
+    char text[GLYPH_TEXT_MAX_CELLS];        // One character per cell, space padded
+} glyph_text_t;
+
+// Rasterize the charset; false if the font is not monospaced or its cells
+// are larger than GLYPH_CELL_MAX_W x GLYPH_CELL_MAX_H
+bool glyph_strip_init(const lv_font_t* font, lv_color_t color, lv_color_t background);
+
+// Create a text object of `cells` cells (needs glyph_strip_init)
+void glyph_text_create(glyph_text_t* text, lv_obj_t* parent, uint8_t cells, bool align_right);
+
+// Show a string (cut to the cell count); returns how many cells changed
+uint8_t glyph_text_set(glyph_text_t* text, const char* str);
+
+#endif // GLYPH_STRIP_H
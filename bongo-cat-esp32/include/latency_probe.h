@@ -0,0 +1,53 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -DLATENCY_PROBE=0 compiles the probe out (SEQ lines are then ignored)
+#ifndef LATENCY_PROBE
+#define LATENCY_PROBE 1
+#endif
+
+// Stamped events followed at once; a stamp that finds no room is not acked
+#define LATENCY_PROBE_PENDING 8
+
+// Command-to-flush latency probe
+//
+// Used by python_scripts/latency_bench.py. The host sends SEQ:<id> right
+// before a command line or binary frame, which stamps that next event. Once
+// its effect has left for the panel the render task answers
+//
+//   ACK:<id>,<parse us>,<state us>,<flush us>
+//
+// parse is micros() when the I/O task posted the event. state is the time
+// from parse until the render task had applied it. flush is the time from
+// parse until the first LVGL refresh after the following animation update
+// had gone out over SPI. flush is 0 when nothing was invalidated, i.e. the
+// command changed no pixels. Without SEQ lines the probe does nothing. All
+// calls belong to the render task.
+
+#if LATENCY_PROBE
+
+// SEQ:<id>: stamp the next command or frame
+void latency_probe_arm(uint32_t id);
+
+// A command or frame event was applied (post_us: when it was posted)
+void latency_probe_applied(uint32_t post_us);
+
+// The animation update ran; redraw_pending: LVGL has areas to refresh
+void latency_probe_rendered(bool redraw_pending);
+
+// An LVGL refresh has been flushed
+void latency_probe_flushed();
+
+#else
+
+static inline void latency_probe_arm(uint32_t id) { (void)id; }
+static inline void latency_probe_applied(uint32_t post_us) { (void)post_us; }
+static inline void latency_probe_rendered(bool redraw_pending) { (void)redraw_pending; }
+static inline void latency_probe_flushed() {}
+
+#endif
+
+#endif // LATENCY_PROBE_H
@@ -45,11 +45,20 @@
    MEMORY SETTINGS
  *=========================*/
 
+/*LVGL_STATIC_POOL=1: LVGL gets a fixed pool of LVGL_POOL_SIZE bytes in .bss instead of heap blocks.
+ *Size it from the MEM command's lv_peak / suggest_pool (measured with the default heap allocator).*/
+#ifndef LVGL_STATIC_POOL
+    #define LVGL_STATIC_POOL 0
+#endif
+#ifndef LVGL_POOL_SIZE
+    #define LVGL_POOL_SIZE (24U * 1024U)
+#endif
+
 /*1: use custom malloc/free, 0: use the built-in `lv_mem_alloc()` and `lv_mem_free()`*/
-#define LV_MEM_CUSTOM 1
+#define LV_MEM_CUSTOM (!LVGL_STATIC_POOL)
 #if LV_MEM_CUSTOM == 0
     /*Size of the memory available for `lv_mem_alloc()` in bytes (>= 2kB)*/
-    #define LV_MEM_SIZE (40U * 1024U)          /*[bytes]*/
+    #define LV_MEM_SIZE LVGL_POOL_SIZE          /*[bytes]*/
 
     /*Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too.*/
     #define LV_MEM_ADR 0     /*0: unused*/
@@ -60,10 +69,11 @@
     #endif
 
 #else       /*LV_MEM_CUSTOM*/
-    #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
-    #define LV_MEM_CUSTOM_ALLOC   malloc
-    #define LV_MEM_CUSTOM_FREE    free
-    #define LV_MEM_CUSTOM_REALLOC realloc
+    /*Heap blocks, counted for the MEM telemetry*/
+    #define LV_MEM_CUSTOM_INCLUDE "mem_telemetry.h"   /*Header for the dynamic memory function*/
+    #define LV_MEM_CUSTOM_ALLOC   mem_telemetry_lv_alloc
+    #define LV_MEM_CUSTOM_FREE    mem_telemetry_lv_free
+    #define LV_MEM_CUSTOM_REALLOC mem_telemetry_lv_realloc
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
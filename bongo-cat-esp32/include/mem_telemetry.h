@@ -0,0 +1,75 @@
+#ifndef MEM_TELEMETRY_H
+#define MEM_TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Print a MEM line every this many ms (0: only on the MEM command)
+#ifndef MEM_TELEMETRY_REPORT_MS
+#define MEM_TELEMETRY_REPORT_MS 60000
+#endif
+
+// Sample for the low-water marks this often
+#define MEM_TELEMETRY_SAMPLE_MS 5000
+
+// Margin on top of the measured LVGL peak for the suggested pool size (%)
+#define MEM_TELEMETRY_POOL_MARGIN 25
+
+// Memory telemetry
+//
+// LVGL pool and ESP heap usage with high-water marks. With the built-in
+// LVGL pool (-DLVGL_STATIC_POOL=1, see lv_conf.h) the numbers come from
+// lv_mem_monitor(); with LV_MEM_CUSTOM, LVGL allocates through the
+// counting wrappers below and "used"/"peak" are the bytes LVGL asked for,
+// which is what a static pool has to hold. The heap numbers are the
+// internal 8-bit heap (where LVGL, the sprite cache and the stacks live)
+// and DMA-capable memory (the draw buffers). All calls except the
+// allocator wrappers belong to the render task.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// LV_MEM_CUSTOM_ALLOC / _FREE / _REALLOC (lv_conf.h)
+void* mem_telemetry_lv_alloc(size_t size);
+void mem_telemetry_lv_free(void* ptr);
+void* mem_telemetry_lv_realloc(void* ptr, size_t size);
+
+#ifdef __cplusplus
+}
+
+typedef struct {
+    // LVGL
+    bool lv_static_pool;            // Built-in pool (LV_MEM_CUSTOM == 0)
+    uint32_t lv_total;              // Pool size (0 with LV_MEM_CUSTOM)
+    uint32_t lv_used;               // Bytes in use
+    uint32_t lv_peak;               // Most bytes in use since boot / reset
+    uint32_t lv_free;               // Free pool bytes (0 with LV_MEM_CUSTOM)
+    uint32_t lv_largest_free;       // Largest free pool block (0 with LV_MEM_CUSTOM)
+    uint8_t lv_frag_pct;            // Pool fragmentation (0 with LV_MEM_CUSTOM)
+    uint32_t lv_blocks;             // Live allocations
+    uint32_t lv_failed;             // Allocations that returned NULL
+
+    // ESP heap, internal 8-bit memory
+    uint32_t heap_free;
+    uint32_t heap_min_free;         // Low-water mark since boot (ESP-IDF)
+    uint32_t heap_largest_free;     // Largest block malloc can hand out now
+    uint32_t heap_min_largest_free; // Smallest largest block seen since boot / reset
+
+    // DMA-capable memory
+    uint32_t dma_free;
+    uint32_t dma_largest_free;
+} mem_telemetry_t;
+
+// Read the current numbers and update the low-water marks
+void mem_telemetry_sample(mem_telemetry_t* out);
+
+// LVGL pool size that would have held the peak, plus MEM_TELEMETRY_POOL_MARGIN
+uint32_t mem_telemetry_suggested_pool(const mem_telemetry_t* mem);
+
+// Restart the LVGL peak and the sampled low-water marks
+void mem_telemetry_reset_peaks();
+
+#endif // __cplusplus
+
+#endif // MEM_TELEMETRY_H
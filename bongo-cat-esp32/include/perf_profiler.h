@@ -0,0 +1,87 @@
+#ifndef PERF_PROFILER_H
+#define PERF_PROFILER_H
+
+#include <Arduino.h>
+
+// Compile the profiler in (override with -DPERF_PROFILER=0)
+#ifndef PERF_PROFILER
+#define PERF_PROFILER 1
+#endif
+
+// Recent samples kept per section for p99 (must be a power of two)
+#ifndef PERF_RING_SIZE
+#define PERF_RING_SIZE 128
+#endif
+
+// Cycle-counter profiler
+//
+// Each section records how long it took, in microseconds, from the CPU cycle
+// counter. Per section it keeps count/min/max/total since the last reset and
+// a ring of the last PERF_RING_SIZE samples, from which perf_dump() takes the
+// p99. Every section has exactly one writer task; PERF and PERF:RESET run on
+// the render task and never block the writers (a reset is applied by the
+// writer on its next sample).
+//
+// With PERF_PROFILER=0 the macros compile to nothing.
+
+typedef enum {
+    PERF_FRAME = 0,       // Render loop pass that ran LVGL
+    PERF_SERIAL,          // handleSerialCommands
+    PERF_TOUCH,           // readTouchScreen
+    PERF_ANIM_UPDATE,     // sprite_manager_update
+    PERF_RENDER_LAYERS,   // sprite_render_layers
+    PERF_LVGL,            // lv_timer_handler
+    PERF_FLUSH,           // Display flush callback
+    PERF_SENSOR,          // AHT30 read
+    PERF_SECTION_COUNT
+} perf_section_t;
+
+void perf_init();
+
+// Print one line per section: PERF:<name>,n=..,min=..,avg=..,p99=..,max=.. (us)
+void perf_dump();
+
+// Clear all sections
+void perf_reset();
+
+// Cycle counter rate after a CPU frequency change
+void perf_set_cpu_mhz(uint32_t mhz);
+
+#if PERF_PROFILER
+
+static inline uint32_t perf_now() {
+    return ESP.getCycleCount();
+}
+
+// Record a sample that started at perf_now() == start_cycles
+void perf_record(perf_section_t section, uint32_t start_cycles);
+
+class PerfScope {
+public:
+    explicit PerfScope(perf_section_t section) : section(section), start(perf_now()) {}
+    ~PerfScope() { perf_record(section, start); }
+
+private:
+    perf_section_t section;
+    uint32_t start;
+};
+
+#define PERF_CONCAT_INNER(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_INNER(a, b)
+
+// Time the rest of the enclosing block
+#define PERF_SCOPE(section) PerfScope PERF_CONCAT(perf_scope_, __LINE__)(section)
+
+// Time from PERF_START to a matching PERF_STOP (for work that is not a block)
+#define PERF_START(var) uint32_t var = perf_now()
+#define PERF_STOP(section, var) perf_record(section, var)
+
+#else
+
+#define PERF_SCOPE(section) do {} while (0)
+#define PERF_START(var) do {} while (0)
+#define PERF_STOP(section, var) do {} while (0)
+
+#endif // PERF_PROFILER
+
+#endif // PERF_PROFILER_H
@@ -0,0 +1,44 @@
+#ifndef PIXEL_OPS_H
+#define PIXEL_OPS_H
+
+#include <lvgl.h>
+#include <stdint.h>
+
+// Packed RGB565 helpers
+//
+// The ESP32 has no SIMD unit, but one 32-bit store moves two RGB565 pixels.
+// These helpers write pixel pairs as words once the destination is word
+// aligned and do the odd pixel at either end on its own. Pixel buffers are
+// lv_color_t arrays, so the word stores go through a may_alias type.
+
+static_assert(sizeof(lv_color_t) == 2, "pixel_ops needs LV_COLOR_DEPTH 16");
+
+typedef uint32_t __attribute__((may_alias)) pixel_pair_t;
+
+// One color in both halves of a word
+static inline uint32_t pixel_pair(lv_color_t color) {
+    return (uint32_t)color.full * 0x00010001u;
+}
+
+// Two pixels as one word, first pixel at the lower address
+static inline uint32_t pixel_pack(lv_color_t first, lv_color_t second) {
+    return (uint32_t)first.full | ((uint32_t)second.full << 16);
+}
+
+// Fill count pixels with one color
+static inline void pixel_fill(lv_color_t* dst, lv_color_t color, uint32_t count) {
+    if (count && ((uintptr_t)dst & 2)) {
+        *dst++ = color;
+        count--;
+    }
+
+    uint32_t pair = pixel_pair(color);
+    pixel_pair_t* words = (pixel_pair_t*)dst;
+    for (uint32_t i = count / 2; i > 0; i--) {
+        *words++ = pair;
+    }
+
+    if (count & 1) *(lv_color_t*)words = color;
+}
+
+#endif // PIXEL_OPS_H
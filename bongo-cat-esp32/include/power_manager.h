@@ -0,0 +1,63 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+
+// CPU clock per mode (MHz, must be a frequency setCpuFrequencyMhz accepts)
+#ifndef POWER_FULL_CPU_MHZ
+#define POWER_FULL_CPU_MHZ 240
+#endif
+#ifndef POWER_LOW_CPU_MHZ
+#define POWER_LOW_CPU_MHZ 80      // Lowest clock that keeps the APB (UART, SPI) at 80 MHz
+#endif
+
+// Backlight duty per mode (0-255)
+#ifndef POWER_FULL_BACKLIGHT
+#define POWER_FULL_BACKLIGHT 255
+#endif
+#ifndef POWER_LOW_BACKLIGHT
+#define POWER_LOW_BACKLIGHT 40
+#endif
+
+// Let ESP-IDF light-sleep the chip while both tasks wait in low power mode
+// (needs an SDK built with CONFIG_PM_ENABLE and tickless idle; UART bytes
+// that arrive during light sleep can be lost, so it is opt-in)
+#ifndef POWER_LIGHT_SLEEP
+#define POWER_LIGHT_SLEEP 0
+#endif
+
+#define POWER_BACKLIGHT_CHANNEL 0
+#define POWER_BACKLIGHT_FREQ 5000
+#define POWER_BACKLIGHT_BITS 8
+
+// Power manager
+//
+// The animation state machine picks the mode: sleep stages run in
+// POWER_MODE_LOW (slow clock, dimmed backlight, slower LVGL refresh), every
+// other state in POWER_MODE_FULL. Switching back is immediate, so a SPEED
+// command is animated at full clock. All calls belong to the render task.
+
+typedef enum {
+    POWER_MODE_FULL = 0,
+    POWER_MODE_LOW
+} power_mode_t;
+
+typedef struct {
+    power_mode_t mode;
+    uint32_t cpu_mhz;
+    uint8_t backlight;
+    bool light_sleep;           // Automatic light sleep active
+    uint32_t low_entries;       // Switches into POWER_MODE_LOW since boot
+    uint32_t low_ms;            // Time spent in POWER_MODE_LOW since boot
+} power_stats_t;
+
+// PWM the backlight at full brightness and run at full clock
+void power_manager_init();
+
+// Switch modes (no-op if already there)
+void power_manager_set_mode(power_mode_t mode);
+power_mode_t power_manager_get_mode();
+
+void power_manager_get_stats(power_stats_t* stats);
+
+#endif // POWER_MANAGER_H
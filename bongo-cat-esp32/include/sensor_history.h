@@ -0,0 +1,71 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Entries kept per tier (oldest ones are overwritten)
+#ifndef SENSOR_HISTORY_RAW
+#define SENSOR_HISTORY_RAW 40        // Readings as taken: 10 min at 15 s
+#endif
+#ifndef SENSOR_HISTORY_MINUTES
+#define SENSOR_HISTORY_MINUTES 60    // 1-minute buckets: the last hour
+#endif
+#ifndef SENSOR_HISTORY_HOURS
+#define SENSOR_HISTORY_HOURS 48      // 1-hour buckets: the last two days
+#endif
+
+#define SENSOR_HISTORY_MAGIC 'H'
+#define SENSOR_HISTORY_VERSION 1
+
+// Next try at writing dump lines when the UART FIFO was full (ms)
+#define SENSOR_HISTORY_DUMP_RETRY_MS 5
+
+// Sensor history
+//
+// AHT30 readings in three rings: the raw readings, and min / max / mean
+// buckets per minute and per hour. A minute bucket is closed by the first
+// reading of a later minute and folded into the open hour bucket, which
+// is closed the same way. Times are seconds since boot, temperatures
+// 0.01 °C and humidities 0.01 %RH. Minutes or hours without a reading
+// leave no bucket, so gaps show up as jumps in the start times.
+//
+// SENSOR_DUMP streams all of it as one binary blob, little endian:
+//
+//   [magic 'H'] [version 1] [uptime s, u32] [raw n] [minute n] [hour n]
+//   raw n x    [time s, u32] [temp, i16] [hum, u16]
+//   minute n x [start s, u32] [readings, u16]
+//              [temp min, i16] [temp max, i16] [temp mean, i16]
+//              [hum min, u16] [hum max, u16] [hum mean, u16]
+//   hour n x   same as minute
+//
+// oldest first in every tier. The open minute and hour are not in it;
+// their readings are in the finer tiers. The blob goes out as text lines,
+// so it shares the serial stream with everything else:
+//
+//   SENSOR_DUMP:BEGIN,bytes=<blob size>
+//   SENSOR_DATA:<base64, whole records, at most 57 bytes per line>
+//   SENSOR_DUMP:END,crc=<CRC-16/CCITT-FALSE of the blob, 4 hex digits>
+//
+// Lines go out only while the UART FIFO has room for them, so a dump
+// never blocks the render task. Readings that arrive during a dump are
+// held back until it is done (the newest one wins). All calls belong to
+// the render task.
+
+#define SENSOR_HISTORY_HEADER_SIZE 9
+#define SENSOR_HISTORY_RAW_SIZE 8
+#define SENSOR_HISTORY_BUCKET_SIZE 18
+
+// Store one reading taken at now_ms
+void sensor_history_add(uint32_t now_ms, float temperature, float humidity);
+
+// Start streaming the history (restarts a dump that is still running)
+void sensor_history_dump_begin(uint32_t now_ms);
+
+// True while dump lines are waiting to be written
+bool sensor_history_dump_pending();
+
+// Write dump lines while they fit the UART FIFO. True if lines are left.
+bool sensor_history_dump_poll();
+
+#endif // SENSOR_HISTORY_H
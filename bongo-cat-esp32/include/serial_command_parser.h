@@ -0,0 +1,68 @@
+#ifndef SERIAL_COMMAND_PARSER_H
+#define SERIAL_COMMAND_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Buffer sizes (override with -D)
+#ifndef SERIAL_PARSER_RING_SIZE
+#define SERIAL_PARSER_RING_SIZE 256   // Raw byte ring, must be a power of two
+#endif
+#ifndef SERIAL_PARSER_LINE_MAX
+#define SERIAL_PARSER_LINE_MAX 128    // Longest accepted command line
+#endif
+
+// Non-blocking, allocation-free serial command parser
+//
+// Bytes are pushed into a fixed ring as they arrive and assembled into lines
+// without waiting for the rest of a partial line. A finished line is trimmed
+// and split in place at the first ':' into a verb and an argument, and the
+// verb's FNV-1a hash is computed so callers can dispatch with a switch on
+// serial_hash("VERB"). Lines longer than SERIAL_PARSER_LINE_MAX are dropped.
+//
+// Plain C/C++, no Arduino dependency.
+
+// One parsed command, pointing into the parser's line buffer.
+// Only valid until the next call to serial_parser_next().
+typedef struct {
+    const char* verb;      // Text before the first ':' (whole line if none)
+    const char* arg;       // Text after the first ':' ("" if none)
+    uint32_t verb_hash;    // serial_hash(verb)
+    bool has_arg;          // Line contained a ':'
+} serial_command_t;
+
+typedef struct {
+    uint8_t ring[SERIAL_PARSER_RING_SIZE];
+    uint16_t head;                          // Next write position
+    uint16_t tail;                          // Next read position
+    char line[SERIAL_PARSER_LINE_MAX + 1];  // Line being assembled
+    uint16_t line_len;
+    bool discarding;                        // Current line overflowed, skip to '\n'
+    uint32_t dropped_bytes;                 // Bytes lost to a full ring
+    uint32_t dropped_lines;                 // Lines lost to overflow
+} serial_parser_t;
+
+// FNV-1a, usable in case labels: case serial_hash("SPEED"):
+static constexpr uint32_t serial_hash(const char* s, uint32_t h = 2166136261u) {
+    return *s ? serial_hash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+
+void serial_parser_init(serial_parser_t* parser);
+
+// Append received bytes; returns how many fit (the rest are dropped)
+size_t serial_parser_feed(serial_parser_t* parser, const uint8_t* data, size_t len);
+
+// Free space in the ring
+size_t serial_parser_space(const serial_parser_t* parser);
+
+// Pull the next complete, non-empty line. Returns false when none is ready.
+bool serial_parser_next(serial_parser_t* parser, serial_command_t* cmd);
+
+// Parse a decimal integer like String::toInt() (0 if there are no digits)
+int32_t serial_parse_int(const char* s);
+
+// Find "KEY:" in a comma separated list and return the text after it, or NULL
+const char* serial_find_field(const char* list, const char* key);
+
+#endif // SERIAL_COMMAND_PARSER_H
@@ -0,0 +1,40 @@
+#ifndef SERIAL_LINK_H
+#define SERIAL_LINK_H
+
+#include "serial_command_parser.h"
+#include "binary_protocol.h"
+
+// Serial stream demultiplexer
+//
+// Splits the bytes received from the host into text commands and, once the
+// host negotiated PROTO:BIN, binary frames, and hands both to the handlers
+// in the order they arrived. A chunk is split in the mode that was active
+// when it was fed, so a PROTO:BIN / PROTO:TEXT handler takes effect with
+// the next chunk. Transport decisions (what PROTO:* means, where events go)
+// stay with the caller.
+//
+// Plain C/C++, no Arduino dependency.
+
+typedef struct {
+    // Called for every complete line; cmd is only valid during the call
+    void (*command)(const serial_command_t* cmd, void* ctx);
+    void (*frame)(const binary_frame_t* frame, void* ctx);
+    void* ctx;
+} serial_link_handlers_t;
+
+typedef struct {
+    serial_parser_t parser;
+    binary_decoder_t decoder;
+    bool binary_mode;
+    serial_link_handlers_t handlers;
+} serial_link_t;
+
+void serial_link_init(serial_link_t* link, const serial_link_handlers_t* handlers);
+
+// Enter (decoder reset) or leave binary mode
+void serial_link_set_binary(serial_link_t* link, bool binary);
+
+// Split one received chunk; text bytes are compacted in place in data
+void serial_link_feed(serial_link_t* link, uint8_t* data, size_t len);
+
+#endif // SERIAL_LINK_H
@@ -0,0 +1,59 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <Arduino.h>
+
+// Quiet time after the last SAVE_SETTINGS before anything is written
+#ifndef SETTINGS_COMMIT_DELAY_MS
+#define SETTINGS_COMMIT_DELAY_MS 2000
+#endif
+
+// Configuration settings structure
+struct BongoCatSettings {
+    bool show_cpu = true;
+    bool show_ram = true;
+    bool show_wpm = true;
+    bool show_time = true;
+    bool time_format_24h = true;
+    int sleep_timeout_minutes = 5;
+    float animation_sensitivity = 1.0;
+};
+
+// Settings persistence on NVS
+//
+// Every field is its own NVS key, so a save only writes the fields that
+// differ from what is stored; NVS itself journals and wear-levels the
+// writes across its partition. A CRC32 over all fields, written after them,
+// tells a complete set from one cut short by a reset. Saves are staged and
+// committed SETTINGS_COMMIT_DELAY_MS after the last one, so a burst of
+// setting commands costs one flash write per changed field.
+//
+// The first boot after the switch imports the old EEPROM record if its
+// checksum is valid and its values pass settings_valid(); an erased
+// (all-zero) record counts as nothing to migrate. The I/O task owns the store during the boot stage
+// (settings_store_begin() and the first load in bootPeripherals()); from
+// APP_EVENT_BOOT on, all calls belong to the render task.
+
+// Open the NVS namespace (and migrate from EEPROM once)
+void settings_store_begin();
+
+// Latest saved settings, staged ones included. False if nothing valid is
+// stored (out is left untouched).
+bool settings_store_load(BongoCatSettings* out);
+
+// Stage settings for the deferred commit
+void settings_store_save(const BongoCatSettings* settings, uint32_t current_time);
+
+// True while a commit is staged; *deadline is when it is due
+bool settings_store_pending(uint32_t* deadline);
+
+// Write the staged fields that changed; returns how many were written
+uint8_t settings_store_commit();
+
+// True if every field is within its valid range
+bool settings_valid(const BongoCatSettings* s);
+
+// CRC-32 (IEEE 802.3, reflected, init and xorout 0xFFFFFFFF)
+uint32_t settings_crc32(uint32_t crc, const uint8_t* data, size_t len);
+
+#endif // SETTINGS_STORE_H
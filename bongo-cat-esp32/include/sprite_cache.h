@@ -0,0 +1,58 @@
+#ifndef SPRITE_CACHE_H
+#define SPRITE_CACHE_H
+
+#include <lvgl.h>
+#include "animations_sprites.h"  // SPRITE_ATLAS
+
+// Internal RAM the cache may use for sprite data (override with -D). Atlas
+// blobs are small, so 8 KB holds all typing sprites; a raw RGB565A8 sprite
+// is 12 KB, so with -DSPRITE_ATLAS=0 the default fits the two paw frames.
+#ifndef SPRITE_CACHE_BUDGET
+#if SPRITE_ATLAS
+#define SPRITE_CACHE_BUDGET 8192
+#else
+#define SPRITE_CACHE_BUDGET (2 * 64 * 64 * 3)
+#endif
+#endif
+
+// Most sprites resident at once
+#define SPRITE_CACHE_MAX_ENTRIES 8
+
+// Internal RAM cache for hot sprites
+//
+// Sprite data is LV_ATTRIBUTE_LARGE_CONST and is read through the SPI flash
+// cache, where it competes with code fetches. Promoting a sprite copies its
+// data into internal RAM; the compositor then blends from the copy. Sprites
+// keep their flash descriptor as identity, so nothing else has to know
+// whether a sprite is resident. All calls belong to the render task.
+
+typedef struct {
+    uint32_t hits;         // Blends served from internal RAM
+    uint32_t misses;       // Blends read from flash
+    uint32_t promotions;   // Sprites copied in
+    uint32_t evictions;    // Sprites dropped
+    uint32_t rejected;     // Promotions refused (budget, slots or allocation)
+    uint32_t bytes_used;
+    uint32_t budget;
+    uint8_t entries;
+} sprite_cache_stats_t;
+
+void sprite_cache_init(uint32_t budget_bytes);
+
+// Copy a sprite into internal RAM (no-op if already resident)
+bool sprite_cache_promote(const lv_img_dsc_t* sprite);
+
+// Promote a set in priority order, skipping any that do not fit; returns
+// how many of them are resident afterwards
+uint8_t sprite_cache_promote_set(const lv_img_dsc_t* const* sprites, uint8_t count);
+
+// Drop every resident sprite
+void sprite_cache_evict_all();
+
+// Descriptor to read pixels from: the resident copy or the sprite itself
+const lv_img_dsc_t* sprite_cache_get(const lv_img_dsc_t* sprite);
+
+void sprite_cache_get_stats(sprite_cache_stats_t* stats);
+void sprite_cache_reset_counters();
+
+#endif // SPRITE_CACHE_H
@@ -0,0 +1,32 @@
+#ifndef SPRITE_RLE_H
+#define SPRITE_RLE_H
+
+#include <lvgl.h>
+
+// Color format of run-length encoded sprites
+#define SPRITE_RLE_CF LV_IMG_CF_USER_ENCODED_0
+#define SPRITE_RLE_MAGIC 'R'
+
+// Run-length encoded sprite decoder
+//
+// Sprites packed by python_scripts/pack_sprites.py keep their lv_img_dsc_t
+// names but point at a small blob instead of a 64x64 RGB565A8 array:
+//
+//   [magic 'R'] [palette count N] [x1] [y1] [x2] [y2]
+//   N x [color lo] [color hi] [alpha]
+//   for every row y1..y2: [run count R] R x [x] [length] [palette index]
+//
+// Only visible pixels are stored, as horizontal runs of one palette entry,
+// so blending is a fill per run and transparent padding costs nothing.
+// These sprites can only be drawn through the cat compositor, not lv_img.
+
+// True when a descriptor holds an encoded sprite
+bool sprite_rle_is_encoded(const lv_img_dsc_t* sprite);
+
+// Bounding box of the visible pixels from the blob header (false if empty)
+bool sprite_rle_get_bounds(const lv_img_dsc_t* sprite, lv_area_t* box);
+
+// Blend the runs that fall inside region into a frame of frame_w pixels per row
+void sprite_rle_blend(const lv_img_dsc_t* sprite, lv_color_t* frame, lv_coord_t frame_w, const lv_area_t* region);
+
+#endif // SPRITE_RLE_H
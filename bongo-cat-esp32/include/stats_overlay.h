@@ -0,0 +1,68 @@
+#ifndef STATS_OVERLAY_H
+#define STATS_OVERLAY_H
+
+#include <lvgl.h>
+
+// Shortest time between two redraws of one field (ms); a value that arrives
+// sooner is shown when the interval is over. The clock is not limited.
+#ifndef STATS_OVERLAY_LOAD_INTERVAL_MS
+#define STATS_OVERLAY_LOAD_INTERVAL_MS 1000  // CPU and RAM
+#endif
+#ifndef STATS_OVERLAY_WPM_INTERVAL_MS
+#define STATS_OVERLAY_WPM_INTERVAL_MS 250
+#endif
+
+#define STATS_OVERLAY_TEXT_MAX 12   // "CPU: 100%", "12:59 PM" + NUL
+
+// Draw the fields from a pre-rendered glyph strip (glyph_strip.h) instead of
+// lv_label; -DSTATS_OVERLAY_GLYPH_STRIP=0 goes back to labels
+#ifndef STATS_OVERLAY_GLYPH_STRIP
+#define STATS_OVERLAY_GLYPH_STRIP 1
+#endif
+
+#define STATS_OVERLAY_STATS_CELLS 9  // "CPU: 100%"
+#define STATS_OVERLAY_TIME_CELLS 8   // "12:59 PM", 24h times are right aligned
+
+// Stats overlay
+//
+// Owns the CPU, RAM, WPM and time fields. Values are formatted into fixed
+// per-field buffers and a field is only touched when its text actually
+// changes, so a STATS line that repeats the last values costs no layout and
+// no redraw. Fields are glyph strip cells where only the changed characters
+// are redrawn, or labels that display the buffer in place
+// (lv_label_set_text_static) if the strip is off or the font does not fit
+// it. All calls belong to the render task.
+
+typedef enum {
+    STATS_FIELD_CPU = 0,
+    STATS_FIELD_RAM,
+    STATS_FIELD_WPM,
+    STATS_FIELD_TIME,
+    STATS_FIELD_COUNT
+} stats_field_t;
+
+typedef struct {
+    uint32_t updates;       // Values handed in
+    uint32_t unchanged;     // ...that matched what was on screen
+    uint32_t deferred;      // ...that had to wait for the field's interval
+    uint32_t redraws;       // Field texts actually changed
+    uint32_t cells;         // Glyph cells redrawn (0 with labels)
+} stats_overlay_stats_t;
+
+// Create the fields on screen (top left stats, top right clock)
+void stats_overlay_create(lv_obj_t* screen);
+
+void stats_overlay_set_stats(int cpu, int ram, int wpm, uint32_t current_time);
+void stats_overlay_set_time(const char* text, uint32_t current_time);
+void stats_overlay_set_visible(stats_field_t field, bool visible);
+
+// Show deferred values whose interval is over
+void stats_overlay_flush(uint32_t current_time);
+
+// True while a deferred value waits; *deadline is when the earliest is due
+bool stats_overlay_pending(uint32_t* deadline);
+
+void stats_overlay_get_stats(stats_overlay_stats_t* stats);
+void stats_overlay_reset_stats();
+
+#endif // STATS_OVERLAY_H
@@ -0,0 +1,47 @@
+#ifndef TIMER_SCHEDULER_H
+#define TIMER_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Timers per scheduler (ids 0 .. SCHEDULER_MAX_TIMERS-1)
+#define SCHEDULER_MAX_TIMERS 8
+
+// Deadline min-heap
+//
+// Every subsystem owns a timer id and sets the millis() deadline of its next
+// piece of work. The task then sleeps for scheduler_wait_ms() (or until it is
+// notified of an event) and runs whatever scheduler_pop_due() hands back.
+// Deadlines compare with wrap-safe arithmetic, like millis() differences.
+// A scheduler belongs to one task; it is not thread safe.
+
+typedef struct {
+    uint32_t deadline[SCHEDULER_MAX_TIMERS];
+    uint8_t heap[SCHEDULER_MAX_TIMERS];    // Timer ids ordered by deadline
+    int8_t slot[SCHEDULER_MAX_TIMERS];     // Heap position of each id, -1 = idle
+    uint8_t count;
+} scheduler_t;
+
+void scheduler_init(scheduler_t* sched);
+
+// Arm a timer, or move it if it is already armed
+void scheduler_set(scheduler_t* sched, uint8_t id, uint32_t deadline);
+
+// Arm a timer unless it is already armed for an earlier deadline
+void scheduler_set_earlier(scheduler_t* sched, uint8_t id, uint32_t deadline);
+
+void scheduler_cancel(scheduler_t* sched, uint8_t id);
+bool scheduler_is_armed(const scheduler_t* sched, uint8_t id);
+
+// Remove and return the earliest timer if it is due at now
+bool scheduler_pop_due(scheduler_t* sched, uint32_t now, uint8_t* id);
+
+// ms until the earliest deadline (0 if one is due, max_ms if none is closer)
+uint32_t scheduler_wait_ms(const scheduler_t* sched, uint32_t now, uint32_t max_ms);
+
+// Wrap-safe "a is before b" for millis() timestamps
+static inline bool scheduler_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+#endif // TIMER_SCHEDULER_H
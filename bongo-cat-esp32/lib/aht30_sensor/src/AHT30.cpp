@@ -1,18 +1,16 @@
 #include "AHT30.h"
+#include "debug_log.h"
 
 AHT30::AHT30(uint8_t sda_pin, uint8_t scl_pin) 
     : sda_pin(sda_pin), scl_pin(scl_pin), initialized(false), 
       lastTemperature(0.0), lastHumidity(0.0), lastReadSuccess(false),
+      measuring(false), resultReady(false), triggerTime(0), lastPollTime(0),
       calibrationEnabled(true), tempOffset(DEFAULT_TEMP_OFFSET),
       humiScale(DEFAULT_HUMI_SCALE), humiOffset(DEFAULT_HUMI_OFFSET) {
     
-    Serial.println("AHT30: Constructor called with calibration:");
-    Serial.print("  Temperature offset: ");
-    Serial.println(tempOffset);
-    Serial.print("  Humidity scale: ");
-    Serial.println(humiScale);
-    Serial.print("  Humidity offset: ");
-    Serial.println(humiOffset);
+    // Runs as a global constructor, before Serial is up
+    LOG_DEBUG("AHT30: Calibration: temperature offset %.2f, humidity scale %.2f, humidity offset %.2f",
+              tempOffset, humiScale, humiOffset);
 }
 
 bool AHT30::begin() {
@@ -25,53 +23,49 @@ bool AHT30::begin() {
     
     // Check if sensor is connected
     if (!isConnected()) {
-        Serial.println("AHT30: Sensor not found at address 0x38!");
+        LOG_ERROR("AHT30: Sensor not found at address 0x38!");
         return false;
     }
     
-    Serial.println("AHT30: Sensor found at address 0x38");
+    LOG_INFO("AHT30: Sensor found at address 0x38");
     
     // Soft reset (recommended for reliability)
-    Serial.println("AHT30: Performing soft reset...");
+    LOG_DEBUG("AHT30: Performing soft reset...");
     Wire.beginTransmission(AHT30_I2C_ADDRESS);
     Wire.write(AHT30_CMD_SOFT_RESET);
     if (Wire.endTransmission() != 0) {
-        Serial.println("AHT30: Soft reset failed, but continuing...");
+        LOG_WARN("AHT30: Soft reset failed, but continuing...");
     }
     delay(20); // Wait for reset to complete
     
     // Load calibration data (important for AHT30)
-    Serial.println("AHT30: Loading calibration data...");
+    LOG_DEBUG("AHT30: Loading calibration data...");
     if (!loadCalibrationData()) {
-        Serial.println("AHT30: Calibration load failed, but continuing...");
+        LOG_WARN("AHT30: Calibration load failed, but continuing...");
     } else {
-        Serial.println("AHT30: Calibration data loaded successfully");
+        LOG_DEBUG("AHT30: Calibration data loaded successfully");
     }
     delay(10); // Wait for calibration to complete
     
     // Check calibration status
-    Serial.println("AHT30: Checking calibration status...");
+    LOG_DEBUG("AHT30: Checking calibration status...");
     if (!checkCalibrationStatus()) {
-        Serial.println("⚠️ AHT30: Sensor not calibrated!");
+        LOG_ERROR("⚠️ AHT30: Sensor not calibrated!");
         return false;
     } else {
-        Serial.println("✅ AHT30: Sensor is properly calibrated");
+        LOG_INFO("✅ AHT30: Sensor is properly calibrated");
     }
     
     // Test read to verify sensor is working
     float temp, hum;
     if (!readTemperatureAndHumidity(&temp, &hum)) {
-        Serial.println("AHT30: Test measurement failed!");
+        LOG_ERROR("AHT30: Test measurement failed!");
         return false;
     }
     
     initialized = true;
-    Serial.println("AHT30: Sensor initialized successfully!");
-    Serial.print("AHT30: Initial reading - Temp: ");
-    Serial.print(temp, 1);
-    Serial.print("°C, Humidity: ");
-    Serial.print(hum, 1);
-    Serial.println("%");
+    LOG_INFO("AHT30: Sensor initialized successfully!");
+    LOG_INFO("AHT30: Initial reading - Temp: %.1f°C, Humidity: %.1f%%", temp, hum);
     
     return true;
 }
@@ -90,32 +84,85 @@ bool AHT30::triggerMeasurement() {
     return Wire.endTransmission() == 0;
 }
 
-bool AHT30::readTemperatureAndHumidity(float* temperature, float* humidity) {
+bool AHT30::startMeasurement() {
+    if (measuring) {
+        return false;  // Previous measurement still running
+    }
+    
+    resultReady = false;
+    
     // Trigger measurement
     if (!triggerMeasurement()) {
-        Serial.println("AHT30: Failed to trigger measurement!");
-        lastReadSuccess = false;
+        LOG_WARN("AHT30: Failed to trigger measurement!");
+        finishMeasurement(false);
         return false;
     }
     
-    // Wait for measurement to complete
-    delay(AHT30_MEASUREMENT_DELAY);
+    measuring = true;
+    triggerTime = millis();
+    lastPollTime = triggerTime;
+    return true;
+}
+
+bool AHT30::poll() {
+    if (!measuring) {
+        return false;
+    }
+    
+    uint32_t now = millis();
+    uint32_t elapsed = now - triggerTime;
+    
+    // The conversion takes at least AHT30_MEASUREMENT_DELAY, after that
+    // check the busy bit every AHT30_POLL_INTERVAL
+    if (elapsed < AHT30_MEASUREMENT_DELAY) {
+        return false;
+    }
+    if (elapsed > AHT30_MEASUREMENT_DELAY && now - lastPollTime < AHT30_POLL_INTERVAL) {
+        return false;
+    }
+    lastPollTime = now;
     
     // Read measurement data (6 bytes)
     uint8_t data[6];
     if (!readData(data, 6)) {
-        Serial.println("AHT30: Failed to read measurement data!");
-        lastReadSuccess = false;
-        return false;
+        LOG_WARN("AHT30: Failed to read measurement data!");
+        finishMeasurement(false);
+        return true;
     }
     
     // Check if sensor is busy (bit 7 of status byte should be 0)
-    if (data[0] & 0x80) {
-        Serial.println("AHT30: Sensor still busy!");
-        lastReadSuccess = false;
+    if (data[0] & AHT30_STATUS_BUSY) {
+        if (elapsed >= AHT30_MEASUREMENT_TIMEOUT) {
+            LOG_WARN("AHT30: Sensor still busy!");
+            finishMeasurement(false);
+            return true;
+        }
+        return false;  // Not done yet, try again later
+    }
+    
+    decodeMeasurement(data);
+    finishMeasurement(true);
+    return true;
+}
+
+bool AHT30::getMeasurement(float* temperature, float* humidity) {
+    resultReady = false;
+    if (!lastReadSuccess) {
         return false;
     }
     
+    *temperature = lastTemperature;
+    *humidity = lastHumidity;
+    return true;
+}
+
+void AHT30::finishMeasurement(bool success) {
+    measuring = false;
+    resultReady = true;
+    lastReadSuccess = success;
+}
+
+void AHT30::decodeMeasurement(const uint8_t* data) {
     // Convert raw data to temperature and humidity (correct bit manipulation)
     // Humidity: 20 bits from data[1], data[2], data[3]
     uint32_t humidityRaw = ((uint32_t)data[1] << 12) | ((uint32_t)data[2] << 4) | (data[3] >> 4);
@@ -123,40 +170,49 @@ bool AHT30::readTemperatureAndHumidity(float* temperature, float* humidity) {
     // Temperature: 20 bits from data[3], data[4], data[5]
     uint32_t temperatureRaw = (((uint32_t)data[3] & 0x0F) << 16) | ((uint32_t)data[4] << 8) | data[5];
     
-    *humidity = convertHumidity(humidityRaw);
-    *temperature = convertTemperature(temperatureRaw);
+    float humidity = convertHumidity(humidityRaw);
+    float temperature = convertTemperature(temperatureRaw);
     
     // Apply calibration if enabled
     if (calibrationEnabled) {
-        float originalTemp = *temperature;
-        float originalHumidity = *humidity;
+        float originalTemp = temperature;
+        float originalHumidity = humidity;
         
-        *temperature = applyCalibration(*temperature, true);
-        *humidity = applyCalibration(*humidity, false);
+        temperature = applyCalibration(temperature, true);
+        humidity = applyCalibration(humidity, false);
         
         // Debug output to show calibration effect
-        Serial.print("AHT30: Raw -> Calibrated: ");
-        Serial.print("Temp ");
-        Serial.print(originalTemp, 1);
-        Serial.print("°C -> ");
-        Serial.print(*temperature, 1);
-        Serial.print("°C, Humidity ");
-        Serial.print(originalHumidity, 1);
-        Serial.print("% -> ");
-        Serial.print(*humidity, 1);
-        Serial.println("%");
+        LOG_DEBUG("AHT30: Raw -> Calibrated: Temp %.1f°C -> %.1f°C, Humidity %.1f%% -> %.1f%%",
+                  originalTemp, temperature, originalHumidity, humidity);
         
         // Limit humidity range
-        if (*humidity < 0) *humidity = 0;
-        if (*humidity > 100) *humidity = 100;
+        if (humidity < 0) humidity = 0;
+        if (humidity > 100) humidity = 100;
     }
     
     // Store last readings
-    lastTemperature = *temperature;
-    lastHumidity = *humidity;
-    lastReadSuccess = true;
+    lastTemperature = temperature;
+    lastHumidity = humidity;
+}
+
+bool AHT30::readTemperatureAndHumidity(float* temperature, float* humidity) {
+    // Blocking wrapper around the non-blocking measurement
+    if (measuring) {
+        LOG_WARN("AHT30: Measurement already in progress!");
+        return false;
+    }
+    if (!startMeasurement()) {
+        resultReady = false;
+        return false;
+    }
     
-    return true;
+    // Wait for measurement to complete
+    delay(AHT30_MEASUREMENT_DELAY);
+    while (!poll()) {
+        delay(1);
+    }
+    
+    return getMeasurement(temperature, humidity);
 }
 
 bool AHT30::readTemperature(float* temperature) {
@@ -175,6 +231,7 @@ void AHT30::softReset() {
     Wire.endTransmission();
     delay(20); // Wait for reset to complete
     initialized = false;
+    measuring = false;  // Any running measurement is lost
 }
 
 bool AHT30::readData(uint8_t* buffer, uint8_t length) {
@@ -184,8 +241,7 @@ bool AHT30::readData(uint8_t* buffer, uint8_t length) {
     uint32_t startTime = millis();
     while (Wire.available() < length) {
         if (millis() - startTime > 100) { // 100ms timeout
-            Serial.print("AHT30: Timeout waiting for data. Available: ");
-            Serial.println(Wire.available());
+            LOG_WARN("AHT30: Timeout waiting for data. Available: %d", Wire.available());
             return false;
         }
         delay(1);
@@ -217,11 +273,11 @@ bool AHT30::loadCalibrationData() {
     Wire.write(0x00);
     
     if (Wire.endTransmission() != 0) {
-        Serial.println("AHT30: Failed to send calibration command");
+        LOG_WARN("AHT30: Failed to send calibration command");
         return false;
     }
     
-    Serial.println("AHT30: Calibration command sent successfully");
+    LOG_DEBUG("AHT30: Calibration command sent successfully");
     return true;
 }
 
@@ -230,24 +286,22 @@ bool AHT30::checkCalibrationStatus() {
     Wire.beginTransmission(AHT30_I2C_ADDRESS);
     Wire.write(0x71); // Status register command
     if (Wire.endTransmission() != 0) {
-        Serial.println("AHT30: Failed to read status register");
+        LOG_WARN("AHT30: Failed to read status register");
         return false;
     }
     
     Wire.requestFrom(AHT30_I2C_ADDRESS, 1);
     if (Wire.available() < 1) {
-        Serial.println("AHT30: No data received from status register");
+        LOG_WARN("AHT30: No data received from status register");
         return false;
     }
     
     uint8_t status = Wire.read();
-    Serial.print("AHT30: Status register: 0x");
-    Serial.println(status, HEX);
+    LOG_DEBUG("AHT30: Status register: 0x%02X", status);
     
     // Check calibration bit (bit 3 = 0x08)
     bool isCalibrated = (status & 0x08) != 0;
-    Serial.print("AHT30: Calibration bit (0x08): ");
-    Serial.println(isCalibrated ? "SET" : "NOT SET");
+    LOG_DEBUG("AHT30: Calibration bit (0x08): %s", isCalibrated ? "SET" : "NOT SET");
     
     return isCalibrated;
 }
@@ -256,19 +310,13 @@ void AHT30::setCalibration(float tempOffset, float humiScale, float humiOffset)
     this->tempOffset = tempOffset;
     this->humiScale = humiScale;
     this->humiOffset = humiOffset;
-    Serial.println("AHT30: Calibration parameters updated");
-    Serial.print("  Temperature offset: ");
-    Serial.println(tempOffset);
-    Serial.print("  Humidity scale: ");
-    Serial.println(humiScale);
-    Serial.print("  Humidity offset: ");
-    Serial.println(humiOffset);
+    LOG_INFO("AHT30: Calibration parameters updated: temperature offset %.2f, humidity scale %.2f, humidity offset %.2f",
+             tempOffset, humiScale, humiOffset);
 }
 
 void AHT30::enableCalibration(bool enable) {
     calibrationEnabled = enable;
-    Serial.print("AHT30: Calibration ");
-    Serial.println(enable ? "enabled" : "disabled");
+    LOG_INFO("AHT30: Calibration %s", enable ? "enabled" : "disabled");
 }
 
 float AHT30::applyCalibration(float value, bool isTemperature) {
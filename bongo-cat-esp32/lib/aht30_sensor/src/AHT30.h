@@ -14,6 +14,11 @@
 
 // Measurement delay
 #define AHT30_MEASUREMENT_DELAY 80  // ms
+#define AHT30_POLL_INTERVAL 10        // ms between busy-bit checks after the delay
+#define AHT30_MEASUREMENT_TIMEOUT 250 // ms before a measurement is given up
+
+// Status byte bits
+#define AHT30_STATUS_BUSY 0x80
 
 // Default calibration offsets (adjusted based on actual sensor comparison)
 // Temperature is 7°C too high -> offset -7.0
@@ -29,6 +34,14 @@ public:
     bool begin();
     bool isConnected();
     bool readTemperatureAndHumidity(float* temperature, float* humidity);
+    
+    // Non-blocking measurement: startMeasurement(), then call poll() regularly
+    // until it returns true, then fetch the result with getMeasurement()
+    bool startMeasurement();
+    bool poll();
+    bool isMeasuring() const { return measuring; }
+    bool isReady() const { return resultReady; }
+    bool getMeasurement(float* temperature, float* humidity);
     bool readTemperature(float* temperature);
     bool readHumidity(float* humidity);
     void softReset();
@@ -51,6 +64,12 @@ private:
     float lastHumidity;
     bool lastReadSuccess;
     
+    // Non-blocking measurement state
+    bool measuring;
+    bool resultReady;
+    uint32_t triggerTime;
+    uint32_t lastPollTime;
+    
     // Calibration parameters
     bool calibrationEnabled;
     float tempOffset;
@@ -59,6 +78,8 @@ private:
     
     bool triggerMeasurement();
     bool readData(uint8_t* buffer, uint8_t length);
+    void finishMeasurement(bool success);
+    void decodeMeasurement(const uint8_t* data);
     bool loadCalibrationData();
     bool checkCalibrationStatus();
     float convertTemperature(uint32_t raw);
@@ -0,0 +1,104 @@
+#include "debug_log.h"
+
+#if DEBUG_LOG_LEVEL > DEBUG_LOG_NONE
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+
+static_assert((DEBUG_LOG_RING_SIZE & (DEBUG_LOG_RING_SIZE - 1)) == 0, "DEBUG_LOG_RING_SIZE must be a power of two");
+static_assert(DEBUG_LOG_LINE_MAX < 255, "line length is stored in one byte");
+
+#define RING_MASK (DEBUG_LOG_RING_SIZE - 1)
+
+// Each line is stored as a length byte followed by its text. head and tail
+// run freely and wrap through RING_MASK; both tasks write, hence the lock.
+static uint8_t ring[DEBUG_LOG_RING_SIZE];
+static uint32_t head = 0;
+static uint32_t tail = 0;
+static uint32_t dropped = 0;
+static uint32_t dropped_reported = 0;
+static void (*wakeup_cb)() = NULL;
+static portMUX_TYPE ring_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char level_tags[] = {'-', 'E', 'W', 'I', 'D', 'V'};
+
+void debug_log_set_wakeup(void (*wakeup)()) {
+    wakeup_cb = wakeup;
+}
+
+void debug_log_write(uint8_t level, const char* format, ...) {
+    // "[I] ..." so log lines stand apart from command replies
+    char line[DEBUG_LOG_LINE_MAX + 1];
+    line[0] = '[';
+    line[1] = level_tags[level <= DEBUG_LOG_VERBOSE ? level : 0];
+    line[2] = ']';
+    line[3] = ' ';
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(line + 4, sizeof(line) - 4, format, args);
+    va_end(args);
+    if (n < 0) return;
+
+    uint32_t len = 4 + (uint32_t)n;
+    if (len > DEBUG_LOG_LINE_MAX) len = DEBUG_LOG_LINE_MAX;
+
+    bool was_empty;
+    portENTER_CRITICAL(&ring_lock);
+    if (DEBUG_LOG_RING_SIZE - (head - tail) < len + 1) {
+        dropped++;
+        portEXIT_CRITICAL(&ring_lock);
+        return;
+    }
+    was_empty = head == tail;
+    ring[head++ & RING_MASK] = (uint8_t)len;
+    for (uint32_t i = 0; i < len; i++) {
+        ring[head++ & RING_MASK] = (uint8_t)line[i];
+    }
+    portEXIT_CRITICAL(&ring_lock);
+
+    if (was_empty && wakeup_cb) wakeup_cb();
+}
+
+bool debug_log_flush() {
+    if (dropped != dropped_reported && Serial.availableForWrite() > 40) {
+        uint32_t lost = dropped - dropped_reported;
+        dropped_reported = dropped;
+        Serial.printf("[W] %lu log lines dropped\n", (unsigned long)lost);
+    }
+
+    char line[DEBUG_LOG_LINE_MAX + 1];
+    for (;;) {
+        // Asked outside the lock: the UART driver takes a mutex
+        uint32_t room = (uint32_t)Serial.availableForWrite();
+
+        portENTER_CRITICAL(&ring_lock);
+        if (head == tail) {
+            portEXIT_CRITICAL(&ring_lock);
+            return false;
+        }
+
+        // Whole lines only: the newline has to fit the FIFO too
+        uint32_t len = ring[tail & RING_MASK];
+        if (room < len + 1) {
+            portEXIT_CRITICAL(&ring_lock);
+            return true;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            line[i] = (char)ring[(tail + 1 + i) & RING_MASK];
+        }
+        tail += len + 1;
+        portEXIT_CRITICAL(&ring_lock);
+
+        // One write per line, so replies from the render task land between lines
+        line[len] = '\n';
+        Serial.write((const uint8_t*)line, len + 1);
+    }
+}
+
+uint32_t debug_log_dropped() {
+    return dropped;
+}
+
+#endif // DEBUG_LOG_LEVEL > DEBUG_LOG_NONE
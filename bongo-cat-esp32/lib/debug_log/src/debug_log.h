@@ -0,0 +1,86 @@
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Log levels, numbered like CORE_DEBUG_LEVEL / ARDUHAL_LOG_LEVEL_*
+#define DEBUG_LOG_NONE 0
+#define DEBUG_LOG_ERROR 1
+#define DEBUG_LOG_WARN 2
+#define DEBUG_LOG_INFO 3
+#define DEBUG_LOG_DEBUG 4
+#define DEBUG_LOG_VERBOSE 5
+
+// Most verbose level compiled in (override with -D; defaults to the core's level)
+#ifndef DEBUG_LOG_LEVEL
+#ifdef CORE_DEBUG_LEVEL
+#define DEBUG_LOG_LEVEL CORE_DEBUG_LEVEL
+#else
+#define DEBUG_LOG_LEVEL DEBUG_LOG_NONE
+#endif
+#endif
+
+// Bytes of formatted lines waiting for the UART (power of two)
+#ifndef DEBUG_LOG_RING_SIZE
+#define DEBUG_LOG_RING_SIZE 2048
+#endif
+
+// Longest line in bytes (longer ones are cut); fits the 128-byte UART FIFO
+#define DEBUG_LOG_LINE_MAX 120
+
+// Deferred debug log
+//
+// Status chatter on the hot paths (animation state changes, touch
+// coordinates, sensor readings...) goes through the LOG_* macros instead
+// of Serial.print. A call above DEBUG_LOG_LEVEL is a constant-false branch
+// and is compiled away with its format string, so the production build
+// (CORE_DEBUG_LEVEL=0) sends nothing but command replies. Enabled calls
+// format the line into a ring buffer and return, from any task; the I/O
+// task writes whole lines out with debug_log_flush() when the UART FIFO
+// has room, so a log line never blocks a task and never splits a reply
+// like PONG. Lines that find the ring full are dropped and counted.
+//
+// Command replies, diagnostics dumps and the app's boot messages stay
+// plain Serial output. The bundled libraries (AHT30, TouchScreenLib) log
+// through LOG_* only, so the same level silences them too.
+
+constexpr bool debug_log_enabled(int level) {
+    return level <= DEBUG_LOG_LEVEL;
+}
+
+#if DEBUG_LOG_LEVEL > DEBUG_LOG_NONE
+
+// Called when the ring goes from empty to non-empty (wakes the flushing task)
+void debug_log_set_wakeup(void (*wakeup)());
+
+// Format one line into the ring (without trailing newline)
+void debug_log_write(uint8_t level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+// Write queued lines while they fit the UART FIFO. True if lines are left.
+bool debug_log_flush();
+
+// Lines lost to a full ring since boot
+uint32_t debug_log_dropped();
+
+#else
+
+static inline void debug_log_set_wakeup(void (*wakeup)()) { (void)wakeup; }
+static inline void debug_log_write(uint8_t, const char*, ...) {}
+static inline bool debug_log_flush() { return false; }
+static inline uint32_t debug_log_dropped() { return 0; }
+
+#endif
+
+#define LOG_AT(level, ...) \
+    do { \
+        if (debug_log_enabled(level)) debug_log_write(level, __VA_ARGS__); \
+    } while (0)
+
+#define LOG_ERROR(...) LOG_AT(DEBUG_LOG_ERROR, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(DEBUG_LOG_WARN, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(DEBUG_LOG_INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(DEBUG_LOG_DEBUG, __VA_ARGS__)
+#define LOG_VERBOSE(...) LOG_AT(DEBUG_LOG_VERBOSE, __VA_ARGS__)
+
+#endif // DEBUG_LOG_H
@@ -1,14 +1,28 @@
 #include "touch_screen_lib.h"
+#include "debug_log.h"
 
 // 默认校准数据（从官方例子获取）
 const uint16_t TouchScreenLib::defaultCalData[5] = { 328, 3443, 365, 3499, 3 };
 
+volatile bool TouchScreenLib::irqPending = false;
+
+// PENIRQ falls when the panel is pressed; just note it, sampling happens in update()
+void IRAM_ATTR TouchScreenLib::onPenIrq() {
+    irqPending = true;
+}
+
 TouchScreenLib::TouchScreenLib(TFT_eSPI* tft_instance) {
     tft = tft_instance;
     screenWidth = 240;
     screenHeight = 320;
     debugEnabled = true;
     calibrationSet = false;
+    state = STATE_IDLE;
+    irqPin = -1;
+    debounceCount = 0;
+    lastSampleTime = 0;
+    lastX = 0;
+    lastY = 0;
     
     // 复制默认校准数据
     for (int i = 0; i < 5; i++) {
@@ -16,27 +30,33 @@ TouchScreenLib::TouchScreenLib(TFT_eSPI* tft_instance) {
     }
 }
 
-bool TouchScreenLib::init() {
+bool TouchScreenLib::init(int8_t irqPin) {
     if (debugEnabled) {
-        Serial.println("🔘 Initializing touch screen library...");
+        LOG_INFO("🔘 Initializing touch screen library...");
     }
     
     // 设置触摸屏校准数据
     tft->setTouch(calData);
     calibrationSet = true;
     
+    // PENIRQ is open drain, active low
+    this->irqPin = irqPin;
+    if (irqPin >= 0) {
+        pinMode(irqPin, INPUT_PULLUP);
+        irqPending = (digitalRead(irqPin) == LOW);
+        attachInterrupt(digitalPinToInterrupt(irqPin), onPenIrq, FALLING);
+    }
+    
     if (debugEnabled) {
-        Serial.println("✅ Touch screen library initialized");
-        Serial.print("🔘 Screen size: ");
-        Serial.print(screenWidth);
-        Serial.print("x");
-        Serial.println(screenHeight);
-        Serial.print("🔘 Calibration data: {");
-        for (int i = 0; i < 5; i++) {
-            Serial.print(calData[i]);
-            if (i < 4) Serial.print(", ");
+        LOG_INFO("✅ Touch screen library initialized");
+        LOG_DEBUG("🔘 Screen size: %ux%u", screenWidth, screenHeight);
+        LOG_DEBUG("🔘 Calibration data: {%u, %u, %u, %u, %u}",
+                  calData[0], calData[1], calData[2], calData[3], calData[4]);
+        if (irqPin >= 0) {
+            LOG_DEBUG("🔘 PENIRQ on pin %d", irqPin);
+        } else {
+            LOG_DEBUG("🔘 No PENIRQ, using pressure polling");
         }
-        Serial.println("}");
     }
     
     return true;
@@ -50,7 +70,7 @@ bool TouchScreenLib::readTouch(uint16_t* x, uint16_t* y) {
 bool TouchScreenLib::readTouch(uint16_t* x, uint16_t* y, uint16_t* pressure) {
     if (!calibrationSet) {
         if (debugEnabled) {
-            Serial.println("❌ Touch screen not calibrated!");
+            LOG_WARN("❌ Touch screen not calibrated!");
         }
         return false;
     }
@@ -61,11 +81,8 @@ bool TouchScreenLib::readTouch(uint16_t* x, uint16_t* y, uint16_t* pressure) {
     if (touched) {
         // 获取原始数据用于调试
         if (debugEnabled) {
-            Serial.println("=== 触摸识别过程 ===");
-            Serial.print("1. 原始ADC读取: X=");
-            Serial.print(rawX);
-            Serial.print(", Y=");
-            Serial.println(rawY);
+            LOG_VERBOSE("=== 触摸识别过程 ===");
+            LOG_VERBOSE("1. 原始ADC读取: X=%u, Y=%u", rawX, rawY);
         }
         
         // 应用校准数据
@@ -74,15 +91,8 @@ bool TouchScreenLib::readTouch(uint16_t* x, uint16_t* y, uint16_t* pressure) {
         *pressure = 600; // TFT_eSPI的getTouch函数不返回压力值，使用固定值
         
         if (debugEnabled) {
-            Serial.print("2. 校准后坐标: X=");
-            Serial.print(*x);
-            Serial.print(", Y=");
-            Serial.println(*y);
-            Serial.print("3. 屏幕范围: ");
-            Serial.print(screenWidth);
-            Serial.print("x");
-            Serial.println(screenHeight);
-            Serial.println("==================");
+            LOG_VERBOSE("2. 校准后坐标: X=%u, Y=%u", *x, *y);
+            LOG_VERBOSE("3. 屏幕范围: %ux%u", screenWidth, screenHeight);
         }
         
         return true;
@@ -104,13 +114,8 @@ void TouchScreenLib::setCalibration(uint16_t newCalData[5]) {
     calibrationSet = true;
     
     if (debugEnabled) {
-        Serial.println("🔘 Touch calibration updated");
-        Serial.print("🔘 New calibration data: {");
-        for (int i = 0; i < 5; i++) {
-            Serial.print(calData[i]);
-            if (i < 4) Serial.print(", ");
-        }
-        Serial.println("}");
+        LOG_DEBUG("🔘 Touch calibration updated: {%u, %u, %u, %u, %u}",
+                  calData[0], calData[1], calData[2], calData[3], calData[4]);
     }
 }
 
@@ -120,9 +125,109 @@ void TouchScreenLib::getRawTouch(uint16_t* rawX, uint16_t* rawY) {
 
 void TouchScreenLib::setDebugOutput(bool enable) {
     debugEnabled = enable;
+    LOG_DEBUG("🔘 Touch screen debug output %s", enable ? "enabled" : "disabled");
+}
+
+bool TouchScreenLib::wantsBus() {
+    uint32_t now = millis();
+    
+    if (state != STATE_IDLE) {
+        return now - lastSampleTime >= TOUCH_SAMPLE_INTERVAL;
+    }
+    
+    if (irqPin >= 0) {
+        // Nothing on PENIRQ means nobody is touching: no SPI at all
+        return irqPending || digitalRead(irqPin) == LOW;
+    }
+    
+    return now - lastSampleTime >= TOUCH_PRESENCE_INTERVAL;
+}
+
+uint32_t TouchScreenLib::nextPollDelay() {
+    // PENIRQ is latched, so idle checks with an IRQ pin only cost a GPIO read
+    uint32_t interval = (state != STATE_IDLE) ? TOUCH_SAMPLE_INTERVAL : TOUCH_PRESENCE_INTERVAL;
+    uint32_t elapsed = millis() - lastSampleTime;
+    return (elapsed >= interval) ? 0 : interval - elapsed;
+}
+
+// One calibrated coordinate sample (several XPT2046 conversions)
+bool TouchScreenLib::sampleTouch(uint16_t* x, uint16_t* y) {
+    uint16_t rawX, rawY;
+    if (!tft->getTouch(&rawX, &rawY, TOUCH_PRESSURE_THRESHOLD)) {
+        return false;
+    }
+    *x = constrain(rawX, 0, screenWidth - 1);
+    *y = constrain(rawY, 0, screenHeight - 1);
+    return true;
+}
+
+bool TouchScreenLib::makeEvent(TouchEvent* event, TouchEventType type, uint32_t now) {
+    event->type = type;
+    event->x = lastX;
+    event->y = lastY;
+    event->time = now;
+    
     if (debugEnabled) {
-        Serial.println("🔘 Touch screen debug output enabled");
-    } else {
-        Serial.println("🔘 Touch screen debug output disabled");
+        static const char* const names[] = { "NONE", "DOWN", "MOVE", "UP" };
+        LOG_DEBUG("🔘 Touch %s: X=%u, Y=%u", names[type], lastX, lastY);
+    }
+    return true;
+}
+
+bool TouchScreenLib::update(TouchEvent* event) {
+    event->type = TOUCH_EVENT_NONE;
+    if (!calibrationSet || !wantsBus()) {
+        return false;
+    }
+    
+    uint32_t now = millis();
+    lastSampleTime = now;
+    
+    if (state == STATE_IDLE) {
+        // Cheap presence check: a single pressure conversion
+        bool pressed = tft->getTouchRawZ() > TOUCH_PRESSURE_THRESHOLD;
+        irqPending = false;  // Drop edges caused by our own conversion
+        
+        if (!pressed) {
+            return false;
+        }
+        state = STATE_PENDING;
+        debounceCount = 0;
+    }
+    
+    uint16_t x, y;
+    bool touched = sampleTouch(&x, &y);
+    
+    if (state == STATE_PENDING) {
+        if (!touched) {
+            state = STATE_IDLE;  // Glitch, not a press
+            return false;
+        }
+        lastX = x;
+        lastY = y;
+        if (++debounceCount < TOUCH_DEBOUNCE_SAMPLES) {
+            return false;
+        }
+        state = STATE_TOUCHING;
+        debounceCount = 0;
+        return makeEvent(event, TOUCH_EVENT_DOWN, now);
+    }
+    
+    // STATE_TOUCHING
+    if (!touched) {
+        if (++debounceCount < TOUCH_DEBOUNCE_SAMPLES) {
+            return false;
+        }
+        state = STATE_IDLE;
+        irqPending = false;
+        return makeEvent(event, TOUCH_EVENT_UP, now);
+    }
+    
+    debounceCount = 0;
+    if (abs((int)x - (int)lastX) < TOUCH_MOVE_THRESHOLD && abs((int)y - (int)lastY) < TOUCH_MOVE_THRESHOLD) {
+        return false;
     }
+    lastX = x;
+    lastY = y;
+    return makeEvent(event, TOUCH_EVENT_MOVE, now);
 }
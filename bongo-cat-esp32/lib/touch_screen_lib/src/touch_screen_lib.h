@@ -4,13 +4,41 @@
 #include <Arduino.h>
 #include <TFT_eSPI.h>
 
+// XPT2046 PENIRQ pin (-1: not wired, fall back to a low-rate pressure check)
+#ifndef TOUCH_IRQ_PIN
+#define TOUCH_IRQ_PIN -1
+#endif
+
+// Event sampling (ms / samples / pixels)
+#define TOUCH_PRESENCE_INTERVAL 50   // Pressure check while idle without PENIRQ
+#define TOUCH_SAMPLE_INTERVAL 20     // Coordinate sampling while touched
+#define TOUCH_DEBOUNCE_SAMPLES 2     // Consecutive samples to confirm down/up
+#define TOUCH_MOVE_THRESHOLD 4       // Movement before a MOVE is reported
+#define TOUCH_PRESSURE_THRESHOLD 600 // Same threshold getTouch() uses
+
+// 触摸事件类型
+enum TouchEventType {
+    TOUCH_EVENT_NONE = 0,
+    TOUCH_EVENT_DOWN,
+    TOUCH_EVENT_MOVE,
+    TOUCH_EVENT_UP
+};
+
+// 触摸事件
+struct TouchEvent {
+    TouchEventType type;
+    uint16_t x;
+    uint16_t y;
+    uint32_t time;  // millis() of the sample
+};
+
 class TouchScreenLib {
 public:
     // 构造函数
     TouchScreenLib(TFT_eSPI* tft_instance);
     
-    // 初始化触摸屏
-    bool init();
+    // 初始化触摸屏 (irqPin: XPT2046 PENIRQ, -1 = none)
+    bool init(int8_t irqPin = TOUCH_IRQ_PIN);
     
     // 读取触摸坐标
     bool readTouch(uint16_t* x, uint16_t* y);
@@ -21,6 +49,16 @@ public:
     // 检查是否有触摸
     bool isTouched();
     
+    // 事件驱动接口: call update() often; it only talks to the controller
+    // when wantsBus() is true and returns true when it produced an event.
+    // While idle, PENIRQ (or a slow pressure check) gates all SPI traffic.
+    bool wantsBus();
+    bool update(TouchEvent* event);
+    bool isPressed() const { return state == STATE_TOUCHING; }
+    
+    // ms until wantsBus() should be checked again (for callers that sleep)
+    uint32_t nextPollDelay();
+    
     // 设置校准数据
     void setCalibration(uint16_t calData[5]);
     
@@ -44,6 +82,20 @@ private:
     
     // 默认校准数据（从官方例子获取）
     static const uint16_t defaultCalData[5];
+    
+    // 事件状态机
+    enum State { STATE_IDLE, STATE_PENDING, STATE_TOUCHING };
+    State state;
+    int8_t irqPin;
+    uint8_t debounceCount;
+    uint32_t lastSampleTime;
+    uint16_t lastX, lastY;      // Last reported position
+    
+    static volatile bool irqPending;
+    static void IRAM_ATTR onPenIrq();
+    
+    bool sampleTouch(uint16_t* x, uint16_t* y);
+    bool makeEvent(TouchEvent* event, TouchEventType type, uint32_t now);
 };
 
 #endif // TOUCH_SCREEN_LIB_H
@@ -0,0 +1,109 @@
+#include "binary_protocol.h"
+#include <string.h>
+
+// Decoder states
+enum {
+    STATE_IDLE,      // Waiting for the start byte
+    STATE_LEN,
+    STATE_TYPE,
+    STATE_PAYLOAD,
+    STATE_CRC_LO,
+    STATE_CRC_HI
+};
+
+static uint16_t crc16_byte(uint16_t crc, uint8_t byte) {
+    crc ^= (uint16_t)byte << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+    return crc;
+}
+
+uint16_t binary_crc16(uint16_t crc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc = crc16_byte(crc, data[i]);
+    }
+    return crc;
+}
+
+void binary_decoder_init(binary_decoder_t* decoder) {
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->state = STATE_IDLE;
+}
+
+binary_result_t binary_decoder_feed(binary_decoder_t* decoder, uint8_t byte, binary_frame_t* out) {
+    switch (decoder->state) {
+        case STATE_IDLE:
+            if (byte != BINARY_FRAME_START) return BINARY_PASS;
+            decoder->crc = 0xFFFF;
+            decoder->state = STATE_LEN;
+            return BINARY_PENDING;
+
+        case STATE_LEN:
+            if (byte > BINARY_MAX_PAYLOAD) {
+                // Cannot be one of ours: resync on the next start byte
+                decoder->state = STATE_IDLE;
+                decoder->frames_bad++;
+                return BINARY_ERROR;
+            }
+            decoder->frame.len = byte;
+            decoder->crc = crc16_byte(decoder->crc, byte);
+            decoder->state = STATE_TYPE;
+            return BINARY_PENDING;
+
+        case STATE_TYPE:
+            decoder->frame.type = byte;
+            decoder->crc = crc16_byte(decoder->crc, byte);
+            decoder->index = 0;
+            decoder->state = (decoder->frame.len > 0) ? STATE_PAYLOAD : STATE_CRC_LO;
+            return BINARY_PENDING;
+
+        case STATE_PAYLOAD:
+            decoder->frame.payload[decoder->index++] = byte;
+            decoder->crc = crc16_byte(decoder->crc, byte);
+            if (decoder->index >= decoder->frame.len) {
+                decoder->state = STATE_CRC_LO;
+            }
+            return BINARY_PENDING;
+
+        case STATE_CRC_LO:
+            decoder->crc ^= byte;  // Low byte must cancel out
+            decoder->state = STATE_CRC_HI;
+            return BINARY_PENDING;
+
+        case STATE_CRC_HI:
+        default:
+            decoder->state = STATE_IDLE;
+            if ((decoder->crc ^ ((uint16_t)byte << 8)) != 0) {
+                decoder->frames_bad++;
+                return BINARY_ERROR;
+            }
+            decoder->frames_ok++;
+            *out = decoder->frame;
+            return BINARY_FRAME;
+    }
+}
+
+bool binary_decode_stats(const binary_frame_t* frame, binary_stats_t* stats) {
+    if (frame->type != BINARY_TYPE_STATS || frame->len < BINARY_STATS_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    const uint8_t* p = frame->payload;
+    stats->cpu = p[0];
+    stats->ram = p[1];
+    stats->wpm = (uint16_t)(p[2] | (p[3] << 8));
+    stats->speed = (uint16_t)(p[4] | (p[5] << 8));
+    stats->flags = p[6];
+    return true;
+}
+
+bool binary_decode_keys(const binary_frame_t* frame, binary_keys_t* keys) {
+    if (frame->type != BINARY_TYPE_KEYS || frame->len == 0 || frame->len > BINARY_KEYS_MAX) {
+        return false;
+    }
+
+    keys->count = frame->len;
+    memcpy(keys->events, frame->payload, frame->len);
+    return true;
+}
@@ -0,0 +1,351 @@
+#include "cat_compositor.h"
+#include "sprite_rle.h"
+#include "sprite_cache.h"
+#include "pixel_ops.h"
+#include <esp_heap_caps.h>
+
+static_assert(CAT_SIZE <= 64, "alpha row masks hold one bit per column in a uint64_t");
+static_assert(CAT_SCALE % 2 == 0, "draw_scaled packs pixel pairs from one source pixel");
+
+// Composited 64x64 frame, always opaque
+static lv_color_t cat_frame[CAT_SIZE * CAT_SIZE];
+static lv_color_t cat_background;
+
+// Layers currently in cat_frame, used to find what changed
+static const lv_img_dsc_t* shown_layers[CAT_MAX_LAYERS];
+static bool full_redraw_pending = true;
+
+// Precomputed opaque bounding boxes
+typedef struct {
+    const lv_img_dsc_t* sprite;
+    lv_area_t box;
+    bool empty;
+    // Binary-alpha RGB565A8 only: visible columns of rows box.y1..y2, bit x = column x
+    uint64_t* alpha_rows;
+} sprite_bounds_t;
+
+static sprite_bounds_t sprite_bounds[CAT_MAX_SPRITES];
+static uint8_t sprite_bounds_count = 0;
+
+// Scan a sprite's alpha for the smallest box holding all visible pixels.
+// With build_mask, a sprite whose alpha is only ever 0 or 255 also gets its
+// per-row visibility masks.
+static void compute_bounds(const lv_img_dsc_t* sprite, sprite_bounds_t* out, bool build_mask) {
+    out->sprite = sprite;
+    out->alpha_rows = NULL;
+    lv_coord_t w = LV_MIN((lv_coord_t)sprite->header.w, (lv_coord_t)CAT_SIZE);
+    lv_coord_t h = LV_MIN((lv_coord_t)sprite->header.h, (lv_coord_t)CAT_SIZE);
+
+    if (sprite_rle_is_encoded(sprite)) {
+        // Encoded sprites carry their box in the header
+        out->empty = !sprite_rle_get_bounds(sprite, &out->box);
+        return;
+    }
+
+    if (sprite->header.cf != LV_IMG_CF_RGB565A8) {
+        // No alpha plane: the whole image is opaque
+        lv_area_set(&out->box, 0, 0, w - 1, h - 1);
+        out->empty = (w == 0 || h == 0);
+        return;
+    }
+
+    const uint8_t* alpha = sprite->data + sprite->header.w * sprite->header.h * sizeof(lv_color_t);
+    lv_coord_t x1 = CAT_SIZE, y1 = CAT_SIZE, x2 = -1, y2 = -1;
+    bool binary = true;
+
+    for (lv_coord_t y = 0; y < h; y++) {
+        const uint8_t* row = &alpha[y * sprite->header.w];
+        for (lv_coord_t x = 0; x < w; x++) {
+            if (row[x] != LV_OPA_TRANSP) {
+                if (x < x1) x1 = x;
+                if (x > x2) x2 = x;
+                if (y < y1) y1 = y;
+                y2 = y;
+                if (row[x] != LV_OPA_COVER) binary = false;
+            }
+        }
+    }
+
+    out->empty = (x2 < 0);
+    lv_area_set(&out->box, x1, y1, x2, y2);
+    if (out->empty || !binary || !build_mask) return;
+
+    // Without the masks (no memory) the sprite just takes the per-pixel path
+    uint32_t rows = y2 - y1 + 1;
+    out->alpha_rows = (uint64_t*)heap_caps_malloc(rows * sizeof(uint64_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!out->alpha_rows) return;
+
+    for (lv_coord_t y = y1; y <= y2; y++) {
+        const uint8_t* row = &alpha[y * sprite->header.w];
+        uint64_t bits = 0;
+        for (lv_coord_t x = x1; x <= x2; x++) {
+            if (row[x] == LV_OPA_COVER) bits |= 1ull << x;
+        }
+        out->alpha_rows[y - y1] = bits;
+    }
+}
+
+static const sprite_bounds_t* find_bounds(const lv_img_dsc_t* sprite) {
+    for (uint8_t i = 0; i < sprite_bounds_count; i++) {
+        if (sprite_bounds[i].sprite == sprite) return &sprite_bounds[i];
+    }
+
+    // Unregistered sprite: compute now and remember it if there is room
+    // (the scratch slot is recomputed on every use, so it gets no masks)
+    static sprite_bounds_t scratch;
+    sprite_bounds_t* slot = (sprite_bounds_count < CAT_MAX_SPRITES) ? &sprite_bounds[sprite_bounds_count++] : &scratch;
+    compute_bounds(sprite, slot, slot != &scratch);
+    return slot;
+}
+
+// Grow a dirty area (sprite pixels) by a sprite's bounding box
+static void add_dirty(lv_area_t* dirty, bool* has_dirty, const lv_img_dsc_t* sprite) {
+    if (!sprite) return;
+    const sprite_bounds_t* b = find_bounds(sprite);
+    if (b->empty) return;
+
+    if (*has_dirty) {
+        _lv_area_join(dirty, dirty, &b->box);
+    } else {
+        *dirty = b->box;
+        *has_dirty = true;
+    }
+}
+
+// Blend the part of one sprite that falls inside the region
+static void blend_sprite(const lv_img_dsc_t* sprite, const lv_area_t* region) {
+    const sprite_bounds_t* b = find_bounds(sprite);
+    if (b->empty) return;
+
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, &b->box, region)) return;
+
+    // Read the pixels from internal RAM when the sprite is resident
+    sprite = sprite_cache_get(sprite);
+
+    if (sprite_rle_is_encoded(sprite)) {
+        sprite_rle_blend(sprite, cat_frame, CAT_SIZE, &area);
+        return;
+    }
+
+    const lv_color_t* colors = (const lv_color_t*)sprite->data;
+    uint32_t stride = sprite->header.w;
+    lv_coord_t w = lv_area_get_width(&area);
+
+    if (sprite->header.cf == LV_IMG_CF_TRUE_COLOR) {
+        // Opaque sprite: plain row copies
+        for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+            memcpy(&cat_frame[y * CAT_SIZE + area.x1], &colors[y * stride + area.x1], w * sizeof(lv_color_t));
+        }
+        return;
+    }
+
+    if (sprite->header.cf != LV_IMG_CF_RGB565A8) {
+        return;  // Unsupported format, nothing sensible to blend
+    }
+
+    if (b->alpha_rows) {
+        // Binary alpha: copy each row's visible runs, skip the transparent ones
+        uint64_t region_bits = (w >= 64 ? ~0ull : (1ull << w) - 1) << area.x1;
+
+        for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+            uint64_t bits = b->alpha_rows[y - b->box.y1] & region_bits;
+            const lv_color_t* src = &colors[y * stride];
+            lv_color_t* dst = &cat_frame[y * CAT_SIZE];
+
+            while (bits) {
+                // Adding the lowest set bit carries through its run of ones
+                uint64_t carry = bits + (bits & (0 - bits));
+                uint32_t start = __builtin_ctzll(bits);
+                uint32_t end = carry ? __builtin_ctzll(carry) : 64;
+                memcpy(&dst[start], &src[start], (end - start) * sizeof(lv_color_t));
+                bits &= carry;
+            }
+        }
+        return;
+    }
+
+    // RGB565A8: color plane followed by an 8-bit alpha plane
+    const uint8_t* alpha = sprite->data + stride * sprite->header.h * sizeof(lv_color_t);
+
+    for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+        const lv_color_t* src = &colors[y * stride];
+        const uint8_t* src_a = &alpha[y * stride];
+        lv_color_t* dst = &cat_frame[y * CAT_SIZE];
+
+        for (lv_coord_t x = area.x1; x <= area.x2; x++) {
+            uint8_t a = src_a[x];
+            if (a == LV_OPA_COVER) {
+                dst[x] = src[x];
+            } else if (a != LV_OPA_TRANSP) {
+                dst[x] = lv_color_mix(src[x], dst[x], a);
+            }
+        }
+    }
+}
+
+// Rebuild a region of the frame from the background and all layers
+static void compose_region(const lv_area_t* region, const lv_img_dsc_t* const* layers, uint8_t layer_count) {
+    uint32_t w = lv_area_get_width(region);
+    for (lv_coord_t y = region->y1; y <= region->y2; y++) {
+        pixel_fill(&cat_frame[y * CAT_SIZE + region->x1], cat_background, w);
+    }
+
+    for (uint8_t layer = 0; layer < layer_count; layer++) {
+        if (layers[layer]) {
+            blend_sprite(layers[layer], region);
+        }
+    }
+}
+
+// Write the frame into the draw buffer as CAT_SCALE x CAT_SCALE blocks
+static void draw_scaled(lv_event_t* e) {
+    lv_obj_t* obj = lv_event_get_target(e);
+    lv_draw_ctx_t* draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, &coords, draw_ctx->clip_area)) {
+        return;
+    }
+
+    lv_color_t* buf = (lv_color_t*)draw_ctx->buf;
+    lv_coord_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+    lv_coord_t run_w = lv_area_get_width(&clip);
+    lv_color_t* prev_row = NULL;
+    int32_t prev_src_y = -1;
+
+    for (lv_coord_t y = clip.y1; y <= clip.y2; y++) {
+        int32_t src_y = (y - coords.y1) / CAT_SCALE;
+        lv_color_t* dst = buf + (int32_t)(y - draw_ctx->buf_area->y1) * buf_w + (clip.x1 - draw_ctx->buf_area->x1);
+
+        if (src_y == prev_src_y) {
+            // Same source row as the line above: copy the expanded line
+            memcpy(dst, prev_row, run_w * sizeof(lv_color_t));
+        } else {
+            const lv_color_t* src = &cat_frame[src_y * CAT_SIZE];
+            int32_t local_x = clip.x1 - coords.x1;
+            lv_color_t* out = dst;
+            lv_coord_t n = run_w;
+
+            // Expand into whole words: one pixel first if the line starts mid-word
+            if (n > 0 && ((uintptr_t)out & 2)) {
+                *out++ = src[local_x++ / CAT_SCALE];
+                n--;
+            }
+
+            pixel_pair_t* words = (pixel_pair_t*)out;
+            if ((local_x & 1) == 0) {
+                // Pairs start on even columns, so both halves share a source pixel
+                for (lv_coord_t i = n / 2; i > 0; i--, local_x += 2) {
+                    *words++ = pixel_pair(src[local_x / CAT_SCALE]);
+                }
+            } else {
+                for (lv_coord_t i = n / 2; i > 0; i--, local_x += 2) {
+                    *words++ = pixel_pack(src[local_x / CAT_SCALE], src[(local_x + 1) / CAT_SCALE]);
+                }
+            }
+            if (n & 1) *(lv_color_t*)words = src[local_x / CAT_SCALE];
+            prev_src_y = src_y;
+        }
+        prev_row = dst;
+    }
+}
+
+static void cat_event_cb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_DRAW_MAIN) {
+        draw_scaled(e);
+    } else if (code == LV_EVENT_COVER_CHECK) {
+        // The frame is opaque, so the cat fully covers whatever is behind it
+        lv_cover_check_info_t* info = (lv_cover_check_info_t*)lv_event_get_param(e);
+        if (info->res == LV_COVER_RES_MASKED) return;
+
+        lv_area_t coords;
+        lv_obj_get_coords(lv_event_get_target(e), &coords);
+        info->res = _lv_area_is_in(info->area, &coords, 0) ? LV_COVER_RES_COVER : LV_COVER_RES_NOT_COVER;
+    }
+}
+
+lv_obj_t* cat_compositor_create(lv_obj_t* parent, lv_color_t background) {
+    cat_background = background;
+    pixel_fill(cat_frame, background, CAT_SIZE * CAT_SIZE);
+    for (uint8_t i = 0; i < CAT_MAX_LAYERS; i++) {
+        shown_layers[i] = NULL;
+    }
+    full_redraw_pending = true;
+
+    lv_obj_t* cat = lv_obj_create(parent);
+    lv_obj_remove_style_all(cat);
+    lv_obj_clear_flag(cat, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(cat, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(cat, CAT_SCREEN_SIZE, CAT_SCREEN_SIZE);
+    lv_obj_add_event_cb(cat, cat_event_cb, LV_EVENT_ALL, NULL);
+    return cat;
+}
+
+void cat_compositor_register_sprites(const lv_img_dsc_t* const* sprites, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (sprites[i]) find_bounds(sprites[i]);
+    }
+}
+
+bool cat_compositor_get_bounds(const lv_img_dsc_t* sprite, lv_area_t* box) {
+    if (!sprite) return false;
+    const sprite_bounds_t* b = find_bounds(sprite);
+    if (box) *box = b->box;
+    return !b->empty;
+}
+
+void cat_compositor_render(lv_obj_t* cat, const lv_img_dsc_t* const* layers, uint8_t layer_count) {
+    if (layer_count > CAT_MAX_LAYERS) layer_count = CAT_MAX_LAYERS;
+
+    lv_area_t dirty;
+    bool has_dirty = false;
+
+    if (full_redraw_pending) {
+        lv_area_set(&dirty, 0, 0, CAT_SIZE - 1, CAT_SIZE - 1);
+        has_dirty = true;
+    } else {
+        // Union of old and new boxes for every layer that changed
+        for (uint8_t layer = 0; layer < layer_count; layer++) {
+            if (layers[layer] != shown_layers[layer]) {
+                add_dirty(&dirty, &has_dirty, shown_layers[layer]);
+                add_dirty(&dirty, &has_dirty, layers[layer]);
+            }
+        }
+    }
+
+    for (uint8_t layer = 0; layer < layer_count; layer++) {
+        shown_layers[layer] = layers[layer];
+    }
+
+    if (!has_dirty) return;
+
+    compose_region(&dirty, layers, layer_count);
+
+    if (full_redraw_pending) {
+        lv_obj_invalidate(cat);
+        full_redraw_pending = false;
+        return;
+    }
+
+    // Scale the dirty sprite area to absolute screen coordinates
+    lv_area_t coords;
+    lv_obj_get_coords(cat, &coords);
+
+    lv_area_t screen_area;
+    screen_area.x1 = coords.x1 + dirty.x1 * CAT_SCALE;
+    screen_area.y1 = coords.y1 + dirty.y1 * CAT_SCALE;
+    screen_area.x2 = coords.x1 + (dirty.x2 + 1) * CAT_SCALE - 1;
+    screen_area.y2 = coords.y1 + (dirty.y2 + 1) * CAT_SCALE - 1;
+    lv_obj_invalidate_area(cat, &screen_area);
+}
+
+void cat_compositor_invalidate(lv_obj_t* cat) {
+    (void)cat;
+    full_redraw_pending = true;
+}
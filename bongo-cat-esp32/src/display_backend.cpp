@@ -0,0 +1,340 @@
+#include "display_backend.h"
+#include "perf_profiler.h"
+#include "debug_log.h"
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Blocking fallback buffer (same size as the original single buffer)
+#define FALLBACK_BUF_PIXELS (240 * 10)
+
+// SPI write clocks are whole fractions of the peripheral's 80 MHz source
+#define SPI_SOURCE_HZ 80000000
+
+// Probe bands live in the fallback buffer (unused until LVGL is set up):
+// the pattern in one half, what was read back in the other
+#define PROBE_WIDTH 240
+#define PROBE_PIXELS (FALLBACK_BUF_PIXELS / 2)
+#define PROBE_LINES (PROBE_PIXELS / PROBE_WIDTH)
+
+#ifdef DISPLAY_SPI_CLOCK_H
+// TFT_eSPI's SPI_FREQUENCY (display_spi_clock.h is force-included by platformio.ini)
+uint32_t display_spi_frequency = DISPLAY_SPI_DEFAULT_HZ;
+#endif
+
+static TFT_eSPI* display_tft = NULL;
+static lv_disp_t* display = NULL;
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static lv_color_t* band_buf1 = NULL;                // The small DMA buffers, restored after a burst
+static lv_color_t* band_buf2 = NULL;
+static lv_color_t* burst_buf = NULL;                // Both burst buffers in one block while a burst is on
+static uint32_t burst_count = 0;
+static lv_color_t fallback_buf[FALLBACK_BUF_PIXELS];
+static SemaphoreHandle_t bus_mutex = NULL;
+
+static bool dma_enabled = false;
+static bool bus_open = false;                       // startWrite() held across DMA flushes
+static lv_disp_drv_t* volatile pending_drv = NULL;  // Flush waiting for its transfer to finish
+static bool pending_last = false;                   // Pending flush is the last one of the frame
+
+static void log_first_flush(const lv_area_t* area) {
+    static bool first_flush = true;
+    if (first_flush) {
+        LOG_DEBUG("🖼️ First flush: x1=%d y1=%d x2=%d y2=%d", area->x1, area->y1, area->x2, area->y2);
+        first_flush = false;
+    }
+}
+
+static void release_bus() {
+    if (bus_open) {
+        display_tft->endWrite();
+        bus_open = false;
+    }
+}
+
+static void complete_flush() {
+    lv_disp_drv_t* drv = pending_drv;
+    pending_drv = NULL;
+
+    // Keep the bus between bands of a frame, give it back once the frame is out
+    if (pending_last) {
+        release_bus();
+    }
+    lv_disp_flush_ready(drv);
+}
+
+// Blocking flush: the original pushColors path
+static void flush_blocking(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    PERF_SCOPE(PERF_FLUSH);
+    log_first_flush(area);
+
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+
+    display_tft->startWrite();
+    display_tft->setAddrWindow(area->x1, area->y1, w, h);
+    display_tft->pushColors((uint16_t*)color_p, w * h, true);
+    display_tft->endWrite();
+
+    lv_disp_flush_ready(disp);
+}
+
+// DMA flush: queue the band and return, completion is signalled by polling
+static void flush_dma(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    PERF_SCOPE(PERF_FLUSH);
+    log_first_flush(area);
+
+    // LVGL waits for the previous flush before handing over a buffer, but be safe
+    if (pending_drv) {
+        display_tft->dmaWait();
+        complete_flush();
+    }
+
+    if (!bus_open) {
+        display_tft->startWrite();
+        bus_open = true;
+    }
+
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+
+    pending_last = lv_disp_flush_is_last(disp);
+    pending_drv = disp;
+    display_tft->pushImageDMA(area->x1, area->y1, w, h, (uint16_t*)color_p);
+}
+
+// Called by LVGL while it waits for a buffer to be released
+static void wait_dma(lv_disp_drv_t* disp) {
+    (void)disp;
+    display_backend_poll();
+}
+
+// Allocate both DMA buffers, or neither
+static bool alloc_dma_buffers(lv_coord_t width, lv_color_t** buf1, lv_color_t** buf2) {
+    size_t bytes = (size_t)width * DISPLAY_DRAW_BUF_LINES * sizeof(lv_color_t);
+    *buf1 = (lv_color_t*)heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+    *buf2 = (lv_color_t*)heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+
+    if (*buf1 && *buf2) return true;
+
+    heap_caps_free(*buf1);
+    heap_caps_free(*buf2);
+    *buf1 = *buf2 = NULL;
+    return false;
+}
+
+lv_disp_t* display_backend_init(TFT_eSPI* tft, lv_coord_t width, lv_coord_t height) {
+    display_tft = tft;
+    bus_mutex = xSemaphoreCreateMutex();
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = width;
+    disp_drv.ver_res = height;
+
+    lv_color_t* buf1 = NULL;
+    lv_color_t* buf2 = NULL;
+
+    #ifdef ESP32_DMA
+    if (alloc_dma_buffers(width, &buf1, &buf2)) {
+        if (tft->initDMA()) {
+            // pushImageDMA swaps in place, matching pushColors(..., true)
+            tft->setSwapBytes(true);
+            dma_enabled = true;
+        } else {
+            Serial.println("⚠️ TFT DMA init failed, using blocking flush");
+            heap_caps_free(buf1);
+            heap_caps_free(buf2);
+        }
+    } else {
+        Serial.println("⚠️ No DMA memory for draw buffers, using blocking flush");
+    }
+    #endif
+
+    if (dma_enabled) {
+        band_buf1 = buf1;
+        band_buf2 = buf2;
+        lv_disp_draw_buf_init(&draw_buf, buf1, buf2, width * DISPLAY_DRAW_BUF_LINES);
+        disp_drv.flush_cb = flush_dma;
+        disp_drv.wait_cb = wait_dma;
+        Serial.println("🖼️ DMA flush enabled: 2 x " + String(DISPLAY_DRAW_BUF_LINES) + " line buffers");
+    } else {
+        lv_disp_draw_buf_init(&draw_buf, fallback_buf, NULL, FALLBACK_BUF_PIXELS);
+        disp_drv.flush_cb = flush_blocking;
+    }
+
+    disp_drv.draw_buf = &draw_buf;
+    display = lv_disp_drv_register(&disp_drv);
+    return display;
+}
+
+// Share of the screen LVGL is going to redraw (%)
+static uint32_t invalid_percent() {
+    uint32_t pixels = 0;
+    for (uint16_t i = 0; i < display->inv_p; i++) {
+        if (display->inv_area_joined[i]) continue;
+        pixels += lv_area_get_size(&display->inv_areas[i]);
+    }
+
+    // Overlapping areas are counted twice, which only errs towards a burst
+    uint32_t screen = (uint32_t)disp_drv.hor_res * disp_drv.ver_res;
+    return pixels >= screen ? 100 : pixels * 100 / screen;
+}
+
+// Swap in two burst buffers, as tall as free DMA memory allows
+static void start_burst() {
+    size_t line_bytes = (size_t)disp_drv.hor_res * sizeof(lv_color_t);
+    size_t free_bytes = heap_caps_get_free_size(MALLOC_CAP_DMA);
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_DMA);
+    if (free_bytes <= DISPLAY_BURST_HEAP_RESERVE) return;
+
+    size_t usable = free_bytes - DISPLAY_BURST_HEAP_RESERVE;
+    if (largest < usable) usable = largest;
+
+    uint32_t lines = usable / (2 * line_bytes);
+    if (lines > DISPLAY_BURST_LINES) lines = DISPLAY_BURST_LINES;
+    if (lines <= DISPLAY_DRAW_BUF_LINES) return;  // Would not beat the bands
+
+    burst_buf = (lv_color_t*)heap_caps_malloc(2 * lines * line_bytes, MALLOC_CAP_DMA);
+    if (!burst_buf) return;
+
+    uint32_t pixels = lines * disp_drv.hor_res;
+    lv_disp_draw_buf_init(&draw_buf, burst_buf, burst_buf + pixels, pixels);
+    burst_count++;
+}
+
+// Back to the small bands
+static void end_burst() {
+    lv_disp_draw_buf_init(&draw_buf, band_buf1, band_buf2, disp_drv.hor_res * DISPLAY_DRAW_BUF_LINES);
+    heap_caps_free(burst_buf);
+    burst_buf = NULL;
+}
+
+void display_backend_begin_frame() {
+    if (!dma_enabled || !display || DISPLAY_BURST_LINES == 0) return;
+
+    bool full = invalid_percent() >= DISPLAY_BURST_MIN_PERCENT;
+    if (full == (burst_buf != NULL)) return;
+
+    // The buffers must not change under a running transfer
+    display_backend_wait_idle();
+    if (full) {
+        start_burst();
+    } else {
+        end_burst();
+    }
+}
+
+static uint16_t swap_bytes(uint16_t color) {
+    return (uint16_t)((color << 8) | (color >> 8));
+}
+
+// Write one pseudo-random band at the current write clock, read it back at
+// SPI_READ_FREQUENCY and count the pixels that came back different
+static uint32_t probe_band(TFT_eSPI* tft, uint32_t seed, bool swapped) {
+    uint16_t* pattern = (uint16_t*)fallback_buf;
+    uint16_t* readback = pattern + PROBE_PIXELS;
+
+    uint32_t x = seed | 1;  // xorshift32: every bit toggles at random
+    for (uint32_t i = 0; i < PROBE_PIXELS; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        pattern[i] = (uint16_t)x;
+    }
+
+    tft->pushImage(0, 0, PROBE_WIDTH, PROBE_LINES, pattern);
+    tft->readRect(0, 0, PROBE_WIDTH, PROBE_LINES, readback);
+
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < PROBE_PIXELS; i++) {
+        uint16_t expected = swapped ? swap_bytes(pattern[i]) : pattern[i];
+        if (readback[i] != expected) errors++;
+    }
+    return errors;
+}
+
+static String format_mhz(uint32_t hz) {
+    return String(hz / 1000000.0f, hz % 1000000 ? 2 : 0) + " MHz";
+}
+
+uint32_t display_backend_probe_spi(TFT_eSPI* tft) {
+#ifdef DISPLAY_SPI_CLOCK_H
+    // Read-back has to work at the slowest clock first, in one byte order
+    // or the other, or there is nothing to compare against (MISO not wired)
+    display_spi_frequency = DISPLAY_SPI_PROBE_MIN_HZ;
+    bool swapped = false;
+    if (probe_band(tft, 1, false) != 0) {
+        swapped = true;
+        if (probe_band(tft, 1, true) != 0) {
+            display_spi_frequency = DISPLAY_SPI_DEFAULT_HZ;
+            Serial.println("⚠️ SPI probe: no display read-back, keeping " + format_mhz(display_spi_frequency));
+            return display_spi_frequency;
+        }
+    }
+
+    // Fastest clock first; the first one without a wrong pixel wins
+    uint32_t best = DISPLAY_SPI_PROBE_MIN_HZ;
+    uint32_t divider = (SPI_SOURCE_HZ + DISPLAY_SPI_PROBE_MAX_HZ - 1) / DISPLAY_SPI_PROBE_MAX_HZ;
+    for (; SPI_SOURCE_HZ / divider > DISPLAY_SPI_PROBE_MIN_HZ; divider++) {
+        uint32_t hz = SPI_SOURCE_HZ / divider;
+        display_spi_frequency = hz;
+
+        uint32_t errors = 0;
+        for (uint8_t round = 0; round < DISPLAY_SPI_PROBE_ROUNDS && errors == 0; round++) {
+            errors = probe_band(tft, hz ^ ((round + 1) * 0x9E3779B9u), swapped);
+        }
+        if (errors == 0) {
+            best = hz;
+            break;
+        }
+        Serial.println("⚡ SPI probe: " + format_mhz(hz) + " failed (" + String(errors) + " bad pixels)");
+    }
+
+    display_spi_frequency = best;
+    Serial.println("⚡ SPI write clock: " + format_mhz(best));
+    return best;
+#else
+    (void)tft;
+    Serial.println("⚡ SPI write clock fixed at " + format_mhz(SPI_FREQUENCY));
+    return SPI_FREQUENCY;
+#endif
+}
+
+void display_backend_poll() {
+    if (!pending_drv) return;
+    if (display_tft->dmaBusy()) return;
+    complete_flush();
+}
+
+void display_backend_wait_idle() {
+    if (!dma_enabled) return;
+
+    if (pending_drv) {
+        display_tft->dmaWait();
+        complete_flush();
+    }
+    release_bus();
+}
+
+bool display_backend_dma_enabled() {
+    return dma_enabled;
+}
+
+uint32_t display_backend_spi_hz() {
+    return SPI_FREQUENCY;
+}
+
+uint32_t display_backend_burst_count() {
+    return burst_count;
+}
+
+bool display_backend_lock_bus(uint32_t timeout_ms) {
+    if (!bus_mutex) return true;  // Not initialized yet: single-threaded boot
+    TickType_t ticks = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return xSemaphoreTake(bus_mutex, ticks) == pdTRUE;
+}
+
+void display_backend_unlock_bus() {
+    if (bus_mutex) xSemaphoreGive(bus_mutex);
+}
@@ -0,0 +1,46 @@
+#include "event_queue.h"
+
+#define QUEUE_MASK (EVENT_QUEUE_SIZE - 1)
+
+static_assert((EVENT_QUEUE_SIZE & QUEUE_MASK) == 0, "EVENT_QUEUE_SIZE must be a power of two");
+
+void event_queue_init(event_queue_t* queue) {
+    queue->head.store(0, std::memory_order_relaxed);
+    queue->tail.store(0, std::memory_order_relaxed);
+    queue->dropped.store(0, std::memory_order_relaxed);
+}
+
+bool event_queue_push(event_queue_t* queue, const app_event_t* event) {
+    uint32_t head = queue->head.load(std::memory_order_relaxed);
+    uint32_t tail = queue->tail.load(std::memory_order_acquire);
+
+    if (head - tail >= EVENT_QUEUE_SIZE) {
+        queue->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    queue->slots[head & QUEUE_MASK] = *event;
+
+    // Publish the slot contents before the new head
+    queue->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool event_queue_pop(event_queue_t* queue, app_event_t* event) {
+    uint32_t tail = queue->tail.load(std::memory_order_relaxed);
+    uint32_t head = queue->head.load(std::memory_order_acquire);
+
+    if (tail == head) {
+        return false;
+    }
+
+    *event = queue->slots[tail & QUEUE_MASK];
+
+    // Hand the slot back to the producer only after it was copied out
+    queue->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t event_queue_count(const event_queue_t* queue) {
+    return queue->head.load(std::memory_order_acquire) - queue->tail.load(std::memory_order_acquire);
+}
@@ -0,0 +1,181 @@
+#include "glyph_strip.h"
+#include <string.h>
+
+#define GLYPH_COUNT (sizeof(GLYPH_STRIP_CHARSET) - 1)
+#define GLYPH_BLANK 0   // Slot of ' ', the first charset entry
+
+// Cell-sized RGB565 glyphs (row stride cell_w), blended onto the background
+static lv_color_t strip[GLYPH_COUNT][GLYPH_CELL_MAX_W * GLYPH_CELL_MAX_H];
+static uint8_t cell_w = 0;
+static uint8_t cell_h = 0;
+
+// ASCII -> strip slot
+static uint8_t slot_of[128];
+
+static inline const lv_color_t* glyph_pixels(char c) {
+    uint8_t ascii = (uint8_t)c;
+    return strip[ascii < 128 ? slot_of[ascii] : GLYPH_BLANK];
+}
+
+// Draw one glyph of the font into its strip slot
+static bool rasterize(const lv_font_t* font, uint8_t slot, uint32_t letter, lv_color_t color, lv_color_t background) {
+    lv_color_t* cell = strip[slot];
+    for (uint16_t i = 0; i < cell_w * cell_h; i++) {
+        cell[i] = background;
+    }
+
+    lv_font_glyph_dsc_t dsc;
+    if (!lv_font_get_glyph_dsc(font, &dsc, letter, 0)) {
+        return true;  // Not in the font: stays blank
+    }
+    if (dsc.adv_w != cell_w) {
+        return false;  // Not monospaced
+    }
+    if (dsc.box_w == 0 || dsc.box_h == 0) {
+        return true;
+    }
+    if (dsc.bpp != 1 && dsc.bpp != 2 && dsc.bpp != 4 && dsc.bpp != 8) {
+        return false;
+    }
+
+    const uint8_t* bitmap = lv_font_get_glyph_bitmap(font, letter);
+    if (!bitmap) return true;
+
+    // Same placement as LVGL's letter drawing: boxes sit on the baseline
+    int16_t top = (font->line_height - font->base_line) - dsc.box_h - dsc.ofs_y;
+    int16_t left = dsc.ofs_x;
+    uint8_t max_value = (1 << dsc.bpp) - 1;
+    uint32_t bit = 0;
+
+    for (int16_t y = 0; y < dsc.box_h; y++) {
+        for (int16_t x = 0; x < dsc.box_w; x++, bit += dsc.bpp) {
+            uint8_t value = (bitmap[bit >> 3] >> (8 - dsc.bpp - (bit & 7))) & max_value;
+            int16_t cy = top + y;
+            int16_t cx = left + x;
+            if (value == 0 || cy < 0 || cy >= cell_h || cx < 0 || cx >= cell_w) continue;
+
+            lv_opa_t opa = (lv_opa_t)(value * 255 / max_value);
+            cell[cy * cell_w + cx] = lv_color_mix(color, background, opa);
+        }
+    }
+    return true;
+}
+
+bool glyph_strip_init(const lv_font_t* font, lv_color_t color, lv_color_t background) {
+    lv_font_glyph_dsc_t dsc;
+    if (!lv_font_get_glyph_dsc(font, &dsc, '0', 0)) {
+        return false;
+    }
+    if (dsc.adv_w == 0 || dsc.adv_w > GLYPH_CELL_MAX_W || font->line_height > GLYPH_CELL_MAX_H) {
+        return false;
+    }
+
+    cell_w = dsc.adv_w;
+    cell_h = font->line_height;
+    memset(slot_of, GLYPH_BLANK, sizeof(slot_of));
+
+    for (uint8_t slot = 0; slot < GLYPH_COUNT; slot++) {
+        char letter = GLYPH_STRIP_CHARSET[slot];
+        if (!rasterize(font, slot, (uint8_t)letter, color, background)) {
+            cell_w = 0;
+            return false;
+        }
+        slot_of[(uint8_t)letter] = slot;
+    }
+    return true;
+}
+
+// Copy the visible part of every cell row into the draw buffer
+static void draw_cells(lv_event_t* e) {
+    const glyph_text_t* text = (const glyph_text_t*)lv_event_get_user_data(e);
+    lv_draw_ctx_t* draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_area_t coords;
+    lv_obj_get_coords(text->obj, &coords);
+
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, &coords, draw_ctx->clip_area)) {
+        return;
+    }
+
+    lv_color_t* buf = (lv_color_t*)draw_ctx->buf;
+    lv_coord_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+
+    for (lv_coord_t y = clip.y1; y <= clip.y2; y++) {
+        int32_t row = (y - coords.y1) * cell_w;
+        lv_color_t* dst = buf + (int32_t)(y - draw_ctx->buf_area->y1) * buf_w + (clip.x1 - draw_ctx->buf_area->x1);
+
+        for (lv_coord_t x = clip.x1; x <= clip.x2; ) {
+            lv_coord_t local = x - coords.x1;
+            uint8_t col = local % cell_w;
+            lv_coord_t run = LV_MIN(cell_w - col, clip.x2 - x + 1);
+
+            memcpy(dst, glyph_pixels(text->text[local / cell_w]) + row + col, run * sizeof(lv_color_t));
+            dst += run;
+            x += run;
+        }
+    }
+}
+
+static void glyph_text_event_cb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if (code == LV_EVENT_DRAW_MAIN) {
+        draw_cells(e);
+    } else if (code == LV_EVENT_COVER_CHECK) {
+        // Cells carry their background, so they cover whatever is behind them
+        lv_cover_check_info_t* info = (lv_cover_check_info_t*)lv_event_get_param(e);
+        if (info->res == LV_COVER_RES_MASKED) return;
+
+        lv_area_t coords;
+        lv_obj_get_coords(lv_event_get_target(e), &coords);
+        info->res = _lv_area_is_in(info->area, &coords, 0) ? LV_COVER_RES_COVER : LV_COVER_RES_NOT_COVER;
+    }
+}
+
+void glyph_text_create(glyph_text_t* text, lv_obj_t* parent, uint8_t cells, bool align_right) {
+    if (cells > GLYPH_TEXT_MAX_CELLS) cells = GLYPH_TEXT_MAX_CELLS;
+    text->cells = cells;
+    text->align_right = align_right;
+    memset(text->text, ' ', sizeof(text->text));
+
+    text->obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(text->obj);
+    lv_obj_clear_flag(text->obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(text->obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(text->obj, cells * cell_w, cell_h);
+    lv_obj_add_event_cb(text->obj, glyph_text_event_cb, LV_EVENT_ALL, text);
+}
+
+uint8_t glyph_text_set(glyph_text_t* text, const char* str) {
+    uint8_t len = strnlen(str, text->cells);
+    uint8_t pad = text->align_right ? text->cells - len : 0;
+
+    int16_t first = -1;
+    int16_t last = -1;
+    uint8_t changed = 0;
+
+    for (uint8_t cell = 0; cell < text->cells; cell++) {
+        char c = (cell >= pad && cell < pad + len) ? str[cell - pad] : ' ';
+        if (c == text->text[cell]) continue;
+
+        text->text[cell] = c;
+        if (first < 0) first = cell;
+        last = cell;
+        changed++;
+    }
+
+    if (changed > 0) {
+        // One area from the first to the last changed cell ("CPU: 45%" -> "CPU: 47%" is one cell)
+        lv_area_t coords;
+        lv_obj_get_coords(text->obj, &coords);
+
+        lv_area_t area;
+        area.x1 = coords.x1 + first * cell_w;
+        area.x2 = coords.x1 + (last + 1) * cell_w - 1;
+        area.y1 = coords.y1;
+        area.y2 = coords.y1 + cell_h - 1;
+        lv_obj_invalidate_area(text->obj, &area);
+    }
+    return changed;
+}
@@ -0,0 +1,78 @@
+#include "latency_probe.h"
+
+#if LATENCY_PROBE
+
+#include <Arduino.h>
+#include <stdio.h>
+
+typedef enum {
+    PROBE_FREE = 0,
+    PROBE_APPLIED,      // Waiting for the next animation update
+    PROBE_DRAWING       // Waiting for the refresh that puts it on the panel
+} probe_stage_t;
+
+typedef struct {
+    uint32_t id;
+    uint32_t parse_us;
+    uint32_t state_us;  // Relative to parse_us
+    uint8_t stage;
+} probe_entry_t;
+
+static probe_entry_t probes[LATENCY_PROBE_PENDING];
+static uint32_t armed_id = 0;
+static bool armed = false;
+
+static void sendAck(probe_entry_t* probe, uint32_t flush_us) {
+    char line[64];
+    int len = snprintf(line, sizeof(line), "ACK:%lu,%lu,%lu,%lu\n",
+                       (unsigned long)probe->id, (unsigned long)probe->parse_us,
+                       (unsigned long)probe->state_us, (unsigned long)flush_us);
+    Serial.write((const uint8_t*)line, len);
+    probe->stage = PROBE_FREE;
+}
+
+void latency_probe_arm(uint32_t id) {
+    // A second SEQ before any command replaces the first
+    armed_id = id;
+    armed = true;
+}
+
+void latency_probe_applied(uint32_t post_us) {
+    if (!armed) return;
+    armed = false;
+
+    for (int i = 0; i < LATENCY_PROBE_PENDING; i++) {
+        probe_entry_t* probe = &probes[i];
+        if (probe->stage != PROBE_FREE) continue;
+
+        probe->id = armed_id;
+        probe->parse_us = post_us;
+        probe->state_us = micros() - post_us;
+        probe->stage = PROBE_APPLIED;
+        return;
+    }
+    // All slots busy: the host counts the missing ack as dropped
+}
+
+void latency_probe_rendered(bool redraw_pending) {
+    for (int i = 0; i < LATENCY_PROBE_PENDING; i++) {
+        probe_entry_t* probe = &probes[i];
+        if (probe->stage != PROBE_APPLIED) continue;
+
+        if (redraw_pending) {
+            probe->stage = PROBE_DRAWING;
+        } else {
+            sendAck(probe, 0);
+        }
+    }
+}
+
+void latency_probe_flushed() {
+    uint32_t now = micros();
+    for (int i = 0; i < LATENCY_PROBE_PENDING; i++) {
+        probe_entry_t* probe = &probes[i];
+        if (probe->stage == PROBE_DRAWING) sendAck(probe, now - probe->parse_us);
+    }
+}
+
+#endif // LATENCY_PROBE
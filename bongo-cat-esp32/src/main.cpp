@@ -3,9 +3,26 @@
 #include <lvgl.h>
 #include <TFT_eSPI.h>
 #include <WiFi.h>
-#include <EEPROM.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "Free_Fonts.h"
 #include "animations_sprites.h"
+#include "cat_compositor.h"
+#include "sprite_cache.h"
+#include "perf_profiler.h"
+#include "timer_scheduler.h"
+#include "power_manager.h"
+#include "settings_store.h"
+#include "stats_overlay.h"
+#include "mem_telemetry.h"
+#include "sensor_history.h"
+#include "latency_probe.h"
+#include "debug_log.h"
+#include "display_backend.h"
+#include "serial_command_parser.h"
+#include "serial_link.h"
+#include "binary_protocol.h"
+#include "event_queue.h"
 #include "touch_screen_lib.h"
 #include "AHT30.h"
 
@@ -14,24 +31,49 @@
 #define SCREEN_HEIGHT 320
 
 // Touch screen settings
-#define TOUCH_THRESHOLD 40
+#define TOUCH_BUS_TIMEOUT 20  // ms to wait for the SPI bus before skipping a touch sample
 
-// Configuration settings structure
-struct BongoCatSettings {
-    bool show_cpu = true;
-    bool show_ram = true;
-    bool show_wpm = true;
-    bool show_time = true;
-    bool time_format_24h = true;
-    int sleep_timeout_minutes = 5;
-    float animation_sensitivity = 1.0;
-    uint32_t checksum = 0;  // For validation
+// Task layout: the render task owns every lv_* call, the I/O task owns
+// serial, touch and the AHT30 and talks to it only through app_events
+#define RENDER_TASK_CORE 1
+#define RENDER_TASK_STACK 8192
+#define RENDER_TASK_PRIORITY 2
+#define IO_TASK_CORE 0
+#define IO_TASK_STACK 4096
+#define IO_TASK_PRIORITY 1
+
+// Scheduling: both tasks sleep until their next timer or a notification
+#define ANIMATION_MIN_PERIOD 25   // 40 FPS max for sprite updates while refreshes are slow
+#define LVGL_MIN_PERIOD 20        // 50 FPS max for LVGL while refreshes are slow
+#define FRAME_FAST_PERIOD 8       // Both caps come down to 125 FPS while refreshes are quick
+#define FRAME_BUDGET_PERCENT 50   // Share of a frame period one refresh may take
+#define LVGL_IDLE_PERIOD 250      // LVGL housekeeping while nothing is invalidated
+#define CLOCK_PERIOD 1000         // Time label refresh
+#define RENDER_MAX_SLEEP 1000
+#define LOW_POWER_FRAME_PERIOD 100      // 10 FPS cap for sprites and LVGL while asleep
+#define LOW_POWER_LVGL_IDLE_PERIOD 1000
+#define IO_MIN_PERIOD 2           // Shortest touch re-check (bus was busy)
+#define IO_MAX_SLEEP 1000
+#define IO_LOG_RETRY_PERIOD 5     // UART FIFO full: next try at writing log lines
+
+// Serial bytes that arrive during the boot stage wait in the UART driver
+#define BOOT_SERIAL_RX_BUFFER 1024
+
+enum {
+    RENDER_TIMER_ANIMATION = 0,   // sprite_manager_update + compositing
+    RENDER_TIMER_CLOCK,           // updateTimeDisplay
+    RENDER_TIMER_LVGL,            // lv_timer_handler
+    RENDER_TIMER_SETTINGS,        // Deferred settings commit
+    RENDER_TIMER_OVERLAY,         // Rate-limited stats label redraw
+    RENDER_TIMER_MEMORY,          // Memory low-water sample / periodic MEM line
+    RENDER_TIMER_SENSOR_DUMP      // SENSOR_DUMP lines left over
 };
 
-// EEPROM settings
-#define SETTINGS_ADDRESS 0
-#define SETTINGS_SIZE sizeof(BongoCatSettings)
-#define EEPROM_SIZE 512  // ESP32 EEPROM size
+enum {
+    IO_TIMER_TOUCH = 0,           // Next wantsBus() check
+    IO_TIMER_SENSOR,              // Next AHT30 start or poll
+    IO_TIMER_LOG                  // Queued log lines left over
+};
 
 // Global settings instance
 BongoCatSettings settings;
@@ -39,9 +81,22 @@ BongoCatSettings settings;
 // Forward declarations
 void resetSettings();
 void createBongoCat();
-const char* get_state_name(animation_state_t state);
 void initTouchScreen();
 void readTouchScreen();
+void readSensor();
+void renderTask(void* param);
+void ioTask(void* param);
+
+// I/O task -> render task events
+static event_queue_t app_events;
+TaskHandle_t render_task_handle = NULL;
+TaskHandle_t io_task_handle = NULL;
+
+// Staged boot: setup() draws the first frame with default settings, the I/O
+// task then loads the settings and brings up touch and the AHT30 before it
+// reads any serial input
+static BongoCatSettings boot_settings;  // Loaded by the I/O task, applied with APP_EVENT_BOOT
+static bool boot_complete = false;      // Render task
 
 TFT_eSPI tft = TFT_eSPI();
 
@@ -58,840 +113,652 @@ bool aht30_initialized = false;
 unsigned long last_sensor_read = 0;
 #define SENSOR_READ_INTERVAL 15000  // Read sensor every 15 seconds (avoid self-heating)
 
-// LVGL display buffer
-static lv_disp_draw_buf_t draw_buf;
-static lv_color_t buf[SCREEN_WIDTH * 10];
-
 // Animation system with sprites
 sprite_manager_t sprite_manager;
 lv_obj_t * cat_canvas = NULL;
-uint32_t last_frame_time = 0;
-bool animation_paused = false;
-
-// Enhanced animation control
-bool python_control_mode = true;  // Python controls idle progression
-uint32_t last_command_time = 0;   // Track when last command received
-#define TYPING_TIMEOUT_MS 2000    // Stop typing animation after 2 seconds of no commands
-#define PYTHON_TIMEOUT_MS 5000    // Fall back to auto mode after 5 seconds
-
-// Simplified animation performance (removed aggressive frame limiting)
-uint32_t frame_skip_counter = 0;
 
-// Cat positioning (restored to original working method)
-#define CAT_SIZE 64   // Base sprite size
-
-// System stats display
+// System stats display (labels live in stats_overlay)
 lv_obj_t * screen = NULL;
-lv_obj_t * cpu_label = NULL;
-lv_obj_t * ram_label = NULL;
-lv_obj_t * wpm_label = NULL;
-lv_obj_t * time_label = NULL;
 
-// Stats data
+// Stats data (last shown values; the single-stat commands change one of them)
 int cpu_usage = 0;
 int ram_usage = 0;
 int wpm_speed = 0;
-String current_time_str = "00:00";
+char current_time_str[6] = "00:00";  // HH:MM
 bool time_initialized = false;  // Track if we've received time from Python
 
-// Function to flush the display buffer
-void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
-    static bool first_flush = true;
-    if (first_flush) {
-        Serial.println("🖼️ First flush callback triggered!");
-        Serial.print("🖼️ Area: x1=");
-        Serial.print(area->x1);
-        Serial.print(" y1=");
-        Serial.print(area->y1);
-        Serial.print(" x2=");
-        Serial.print(area->x2);
-        Serial.print(" y2=");
-        Serial.println(area->y2);
-        first_flush = false;
-    }
-    
-    uint32_t w = (area->x2 - area->x1 + 1);
-    uint32_t h = (area->y2 - area->y1 + 1);
-
-    tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors((uint16_t*)color_p, w * h, true);
-    tft.endWrite();
-
-    lv_disp_flush_ready(disp);
-}
-
 // Update system stats display
 void updateSystemStats(int cpu, int ram, int wpm) {
     cpu_usage = cpu;
     ram_usage = ram;
     wpm_speed = wpm;
     
-    if (cpu_label) {
-        lv_label_set_text_fmt(cpu_label, "CPU: %d%%", cpu);
-    }
-    if (ram_label) {
-        lv_label_set_text_fmt(ram_label, "RAM: %d%%", ram);
-    }
-    if (wpm_label) {
-        lv_label_set_text_fmt(wpm_label, "WPM: %d", wpm);
-    }
+    // Unchanged values cost nothing, changed ones are redrawn at most once per field interval
+    stats_overlay_set_stats(cpu, ram, wpm, millis());
 }
 
 // Update time display  
 void updateTimeDisplay() {
-    if (time_label && current_time_str.length() > 0) {
-        String display_time = current_time_str;
+    if (current_time_str[0] != '\0') {
+        char display_time[12];
         
         // Convert to 12-hour format if needed
-        if (!settings.time_format_24h && current_time_str.length() == 5) {
-            int hour = current_time_str.substring(0, 2).toInt();
-            String minute = current_time_str.substring(3, 5);
-            String ampm = (hour >= 12) ? "PM" : "AM";
+        if (!settings.time_format_24h && strlen(current_time_str) == 5) {
+            int hour = serial_parse_int(current_time_str);
+            const char* ampm = (hour >= 12) ? "PM" : "AM";
             
             if (hour == 0) hour = 12;      // 00:xx -> 12:xx AM
             else if (hour > 12) hour -= 12; // 13:xx -> 1:xx PM
             
-            display_time = String(hour) + ":" + minute + " " + ampm;
+            snprintf(display_time, sizeof(display_time), "%d:%s %s", hour, &current_time_str[3], ampm);
+        } else {
+            snprintf(display_time, sizeof(display_time), "%s", current_time_str);
         }
         
-        lv_label_set_text(time_label, display_time.c_str());
+        // Called every second, but the label only changes once a minute
+        stats_overlay_set_time(display_time, millis());
         
         // Debug output for time updates
         if (!time_initialized) {
-            Serial.print("🕐 Time initialized: ");
-            Serial.println(display_time);
+            LOG_INFO("🕐 Time initialized: %s", display_time);
             time_initialized = true;
         }
     }
 }
 
 // Settings management functions
-uint32_t calculateChecksum(const BongoCatSettings* s) {
-    // Simple checksum calculation (excluding checksum field itself)
-    uint32_t sum = 0;
-    const uint8_t* data = (const uint8_t*)s;
-    size_t size = sizeof(BongoCatSettings) - sizeof(uint32_t); // Exclude checksum field
-    
-    for (size_t i = 0; i < size; i++) {
-        sum += data[i];
-    }
-    return sum;
+void saveSettings() {
+    // Staged: bursts of SAVE_SETTINGS end up in one NVS commit
+    settings_store_save(&settings, millis());
+    Serial.println("💾 Settings saved (NVS commit pending)");
 }
 
-bool validateSettings(const BongoCatSettings* s) {
-    // Check if settings are within valid ranges
-    if (s->sleep_timeout_minutes < 1 || s->sleep_timeout_minutes > 60) return false;
-    if (s->animation_sensitivity < 0.1 || s->animation_sensitivity > 5.0) return false;
-    
-    // Check if checksum matches
-    uint32_t expected_checksum = calculateChecksum(s);
-    return (s->checksum == expected_checksum);
+static void defaultSettings(BongoCatSettings* s) {
+    s->show_cpu = true;
+    s->show_ram = true;
+    s->show_wpm = true;
+    s->show_time = true;
+    s->time_format_24h = true;
+    s->sleep_timeout_minutes = 5;
+    s->animation_sensitivity = 1.0;
 }
 
-void saveSettings() {
-    settings.checksum = calculateChecksum(&settings);
-    EEPROM.put(SETTINGS_ADDRESS, settings);
-    EEPROM.commit();
-    Serial.println("💾 Settings saved to EEPROM");
+// Stored settings into *out, or the defaults (false) if there are none
+static bool readSettings(BongoCatSettings* out) {
+    BongoCatSettings temp_settings;
+    
+    if (settings_store_load(&temp_settings) && settings_valid(&temp_settings)) {
+        *out = temp_settings;
+        Serial.println("📂 Settings loaded from NVS");
+        return true;
+    }
+    Serial.println("⚠️ No valid stored settings, using defaults");
+    defaultSettings(out);
+    return false;
 }
 
 void loadSettings() {
-    BongoCatSettings temp_settings;
-    EEPROM.get(SETTINGS_ADDRESS, temp_settings);
-    
-    if (validateSettings(&temp_settings)) {
-        settings = temp_settings;
-        Serial.println("📂 Settings loaded from EEPROM");
-        // Note: updateDisplayVisibility() will be called after UI creation
-    } else {
-        Serial.println("⚠️ Invalid settings in EEPROM, using defaults");
+    if (!readSettings(&settings)) {
         resetSettings();
     }
 }
 
 void resetSettings() {
-    // Reset to default values
-    settings.show_cpu = true;
-    settings.show_ram = true;
-    settings.show_wpm = true;
-    settings.show_time = true;
-    settings.time_format_24h = true;
-    settings.sleep_timeout_minutes = 5;
-    settings.animation_sensitivity = 1.0;
-    settings.checksum = calculateChecksum(&settings);
+    defaultSettings(&settings);
     
     Serial.println("🔄 Settings reset to factory defaults");
     // Note: updateDisplayVisibility() will be called after UI creation if needed
 }
 
+// Print "label: ON/OFF"
+static void printOnOff(const char* label, bool on) {
+    Serial.print(label);
+    Serial.println(on ? "ON" : "OFF");
+}
+
 void updateDisplayVisibility() {
-    // Show/hide labels based on settings (only if UI is created)
-    if (cpu_label) {
-        if (settings.show_cpu) {
-            lv_obj_clear_flag(cpu_label, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(cpu_label, LV_OBJ_FLAG_HIDDEN);
-        }
-        Serial.println("🖥️ CPU visibility updated: " + String(settings.show_cpu ? "ON" : "OFF"));
-    }
+    // Show/hide labels based on settings (no-op until the UI is created)
+    stats_overlay_set_visible(STATS_FIELD_CPU, settings.show_cpu);
+    printOnOff("🖥️ CPU visibility updated: ", settings.show_cpu);
     
-    if (ram_label) {
-        if (settings.show_ram) {
-            lv_obj_clear_flag(ram_label, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(ram_label, LV_OBJ_FLAG_HIDDEN);
-        }
-        Serial.println("💾 RAM visibility updated: " + String(settings.show_ram ? "ON" : "OFF"));
-    }
+    stats_overlay_set_visible(STATS_FIELD_RAM, settings.show_ram);
+    printOnOff("💾 RAM visibility updated: ", settings.show_ram);
     
-    if (wpm_label) {
-        if (settings.show_wpm) {
-            lv_obj_clear_flag(wpm_label, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(wpm_label, LV_OBJ_FLAG_HIDDEN);
-        }
-        Serial.println("⌨️ WPM visibility updated: " + String(settings.show_wpm ? "ON" : "OFF"));
-    }
+    stats_overlay_set_visible(STATS_FIELD_WPM, settings.show_wpm);
+    printOnOff("⌨️ WPM visibility updated: ", settings.show_wpm);
     
-    if (time_label) {
-        if (settings.show_time) {
-            lv_obj_clear_flag(time_label, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(time_label, LV_OBJ_FLAG_HIDDEN);
-        }
-        Serial.println("🕐 Time visibility updated: " + String(settings.show_time ? "ON" : "OFF"));
-    }
+    stats_overlay_set_visible(STATS_FIELD_TIME, settings.show_time);
+    printOnOff("🕐 Time visibility updated: ", settings.show_time);
 }
 
-// Handle serial commands from Python script
-void handleSerialCommands() {
-    if (Serial.available()) {
-        String command = Serial.readStringUntil('\n');
-        command.trim();
-        
-        uint32_t current_time = millis();
-        last_command_time = current_time;  // Update command timestamp
-        python_control_mode = true;        // Ensure Python control is active
-        
-        if (command.startsWith("SPEED:")) {
-            // Handle speed commands with enhanced logic  
-            String speed_str = command.substring(6);
-            uint16_t speed = speed_str.toInt();
-            
-            // Updated thresholds to match Python script (2024 industry standards)
-            // Research shows: Average 40-45 WPM, Slow <20, Good 50-60, Professional 70+
-            animation_state_t new_state = sprite_manager.current_state;
-            
-            if (speed == 0) {
-                // Explicit stop command
-                sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE1, current_time);
-            } else if (speed < 80) {        // Slow threshold: <20 WPM -> speed 80+
-                new_state = ANIM_STATE_TYPING_SLOW;
-            } else if (speed < 150) {       // Normal threshold: 20-40 WPM -> speed 80-150
-                new_state = ANIM_STATE_TYPING_NORMAL;
-            } else {                        // Fast threshold: 40+ WPM -> speed 150+
-                new_state = ANIM_STATE_TYPING_FAST;
-            }
-            
-            // Always refresh state to prevent stuck animations (even if same state)
-            sprite_manager_set_state(&sprite_manager, new_state, current_time);
-            Serial.println("🔄 Animation state refreshed");
-            
-            // Check for significant speed changes that might cause stuck paws
-            uint16_t old_speed = sprite_manager.animation_speed_ms;
-            sprite_manager.animation_speed_ms = speed;
-            
-            // If speed changed significantly, reset paw timing to prevent stuck paws
-            if (sprite_manager.paw_animation_active && abs((int)speed - (int)old_speed) > 50) {
-                sprite_manager.paw_timer = current_time;  // Reset timing
-                Serial.println("🔄 Speed change - resetting paw timing");
-            }
+// Serial lines and, once the host negotiated PROTO:BIN, binary frames (I/O task)
+static serial_link_t serial_link;
+
+static bool binary_typing = false;  // Typing flag of the last STATS frame (render task)
+static bool key_redraw = false;     // A key strike skips the frame caps (render task)
+
+// Recent LVGL refresh time, render and flush (render task). Starts out at
+// what keeps the slow caps until the first refreshes are measured.
+static uint32_t refresh_cost_us = ANIMATION_MIN_PERIOD * 1000UL * FRAME_BUDGET_PERCENT / 100;
+
+// Frame cap: slow_period, or down to FRAME_FAST_PERIOD while the recent
+// refreshes fit FRAME_BUDGET_PERCENT of a shorter one
+static uint32_t framePeriod(uint32_t slow_period) {
+    uint32_t needed = (refresh_cost_us * 100 / FRAME_BUDGET_PERCENT + 999) / 1000;
+    if (needed < FRAME_FAST_PERIOD) return FRAME_FAST_PERIOD;
+    return needed < slow_period ? needed : slow_period;
+}
+
+static_assert(KEY_EVENT_RIGHT == BINARY_KEY_RIGHT && KEY_EVENT_GAP_MASK == BINARY_KEY_GAP_MASK, "key event encoding differs from BINARY_TYPE_KEYS");
+
+// Apply a DISPLAY_xxx:ON/OFF command
+static void setDisplayOption(bool* option, const char* label, const char* value) {
+    *option = (strcmp(value, "ON") == 0);
+    updateDisplayVisibility();
+    Serial.print(label);
+    Serial.println(value);
+}
+
+// CACHE:hits=..,misses=..,hit_rate=..,entries=..,bytes=..,budget=..,...
+static void printCacheStats() {
+    sprite_cache_stats_t stats;
+    sprite_cache_get_stats(&stats);
+    
+    uint32_t lookups = stats.hits + stats.misses;
+    char line[160];
+    snprintf(line, sizeof(line),
+             "CACHE:hits=%lu,misses=%lu,hit_rate=%lu,entries=%u,bytes=%lu,budget=%lu,promotions=%lu,evictions=%lu,rejected=%lu",
+             (unsigned long)stats.hits, (unsigned long)stats.misses,
+             (unsigned long)(lookups ? stats.hits * 100 / lookups : 0),
+             stats.entries, (unsigned long)stats.bytes_used, (unsigned long)stats.budget,
+             (unsigned long)stats.promotions, (unsigned long)stats.evictions, (unsigned long)stats.rejected);
+    Serial.println(line);
+}
+
+static void printPowerStats() {
+    power_stats_t stats;
+    power_manager_get_stats(&stats);
+    
+    char line[112];
+    snprintf(line, sizeof(line), "POWER:mode=%s,cpu_mhz=%lu,backlight=%u,light_sleep=%u,low_entries=%lu,low_s=%lu",
+             stats.mode == POWER_MODE_LOW ? "low" : "full", (unsigned long)stats.cpu_mhz, stats.backlight,
+             stats.light_sleep ? 1 : 0, (unsigned long)stats.low_entries, (unsigned long)(stats.low_ms / 1000));
+    Serial.println(line);
+}
+
+static void printDisplayStats() {
+    char line[160];
+    snprintf(line, sizeof(line), "DISPLAY:dma=%u,spi_hz=%lu,band_lines=%u,bursts=%lu,refresh_us=%lu,frame_ms=%lu,anim_skipped=%lu",
+             display_backend_dma_enabled() ? 1 : 0, (unsigned long)display_backend_spi_hz(),
+             DISPLAY_DRAW_BUF_LINES, (unsigned long)display_backend_burst_count(),
+             (unsigned long)refresh_cost_us, (unsigned long)framePeriod(ANIMATION_MIN_PERIOD),
+             (unsigned long)sprite_manager.sequence_skipped);
+    Serial.println(line);
+}
+
+static void printOverlayStats() {
+    stats_overlay_stats_t stats;
+    stats_overlay_get_stats(&stats);
+    
+    char line[112];
+    snprintf(line, sizeof(line), "OVERLAY:updates=%lu,unchanged=%lu,deferred=%lu,redraws=%lu,cells=%lu",
+             (unsigned long)stats.updates, (unsigned long)stats.unchanged,
+             (unsigned long)stats.deferred, (unsigned long)stats.redraws, (unsigned long)stats.cells);
+    Serial.println(line);
+}
+
+// MEM:lv_used=..,lv_peak=..,...,heap_free=..,heap_min=..,...,stack_render=..,stack_io=..
+static void printMemStats() {
+    mem_telemetry_t mem;
+    mem_telemetry_sample(&mem);
+    
+    char line[320];
+    snprintf(line, sizeof(line),
+             "MEM:lv_pool=%s,lv_total=%lu,lv_used=%lu,lv_peak=%lu,lv_free=%lu,lv_largest=%lu,lv_frag=%u,lv_blocks=%lu,lv_failed=%lu,"
+             "suggest_pool=%lu,heap_free=%lu,heap_min=%lu,heap_largest=%lu,heap_min_largest=%lu,dma_free=%lu,dma_largest=%lu,"
+             "stack_render=%lu,stack_io=%lu",
+             mem.lv_static_pool ? "static" : "heap", (unsigned long)mem.lv_total, (unsigned long)mem.lv_used,
+             (unsigned long)mem.lv_peak, (unsigned long)mem.lv_free, (unsigned long)mem.lv_largest_free,
+             mem.lv_frag_pct, (unsigned long)mem.lv_blocks, (unsigned long)mem.lv_failed,
+             (unsigned long)mem_telemetry_suggested_pool(&mem),
+             (unsigned long)mem.heap_free, (unsigned long)mem.heap_min_free, (unsigned long)mem.heap_largest_free,
+             (unsigned long)mem.heap_min_largest_free, (unsigned long)mem.dma_free, (unsigned long)mem.dma_largest_free,
+             // Unused stack bytes at the deepest point so far
+             (unsigned long)(render_task_handle ? uxTaskGetStackHighWaterMark(render_task_handle) : 0),
+             (unsigned long)(io_task_handle ? uxTaskGetStackHighWaterMark(io_task_handle) : 0));
+    Serial.println(line);
+}
+
+// Execute one command (render task)
+void processCommand(uint32_t verb_hash, const char* arg) {
+    uint32_t current_time = millis();
+    sprite_manager.last_command_time = current_time;  // Update command timestamp
+    sprite_manager.python_control_mode = true;        // Ensure Python control is active
+    
+    switch (verb_hash) {
+        case serial_hash("SPEED"):
+            sprite_manager_apply_speed(&sprite_manager, serial_parse_int(arg), current_time);
+            break;
             
-            // Reset Python control timeout
-            last_command_time = current_time;
-            python_control_mode = true;
-            sprite_manager.idle_progression_enabled = false;
-        } else if (command == "STOP") {
-            // Explicit stop command - better than IDLE
-            sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE1, current_time);
-            sprite_manager.idle_progression_enabled = false; // Keep disabled until IDLE_START
-            python_control_mode = true;
-            last_command_time = current_time;
-            Serial.println("🛑 Received STOP command");
+        case serial_hash("STOP"):
+            sprite_manager_stop(&sprite_manager, current_time);
+            break;
             
-        } else if (command == "IDLE_START") {
+        case serial_hash("IDLE_START"):
             // Enable idle progression when Python detects no typing
             sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE1, current_time);
             sprite_manager.idle_progression_enabled = true;  // Enable automatic progression
-            python_control_mode = false;  // Let Arduino handle idle progression
-            Serial.println("😴 Idle progression enabled");
+            sprite_manager.python_control_mode = false;  // Let Arduino handle idle progression
+            LOG_DEBUG("😴 Idle progression enabled");
+            break;
             
-        } else if (command == "IDLE") {
+        case serial_hash("IDLE"):
             // Compatibility with old command
             sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE1, current_time);
             Serial.println("PONG");
+            break;
             
-        } else if (command == "HEARTBEAT") {
+        case serial_hash("HEARTBEAT"):
             // Connection keepalive - just reset timeout
-            last_command_time = current_time;
-            python_control_mode = true;
-        } else if (command == "STREAK_ON") {
+            sprite_manager.last_command_time = current_time;
+            sprite_manager.python_control_mode = true;
+            break;
+            
+        case serial_hash("STREAK_ON"):
             // Enable streak mode (happy face)
             sprite_manager.is_streak_mode = true;
-            Serial.println("😊 Streak mode enabled - happy face!");
-        } else if (command == "STREAK_OFF") {
+            LOG_DEBUG("😊 Streak mode enabled - happy face!");
+            break;
+            
+        case serial_hash("STREAK_OFF"):
             // Disable streak mode
             sprite_manager.is_streak_mode = false;
-            Serial.println("😐 Streak mode disabled - normal face");
-        } else if (command.startsWith("STATS:")) {
-            // Parse stats: STATS:CPU:45,RAM:67,WPM:23
-            String stats = command.substring(6);
-            
-            int cpuStart = stats.indexOf("CPU:") + 4;
-            int cpuEnd = stats.indexOf(",", cpuStart);
-            int cpu = stats.substring(cpuStart, cpuEnd).toInt();
-            
-            int ramStart = stats.indexOf("RAM:") + 4;
-            int ramEnd = stats.indexOf(",", ramStart);
-            int ram = stats.substring(ramStart, ramEnd).toInt();
-            
-            int wpmStart = stats.indexOf("WPM:") + 4;
-            int wpm = stats.substring(wpmStart).toInt();
+            LOG_DEBUG("😐 Streak mode disabled - normal face");
+            break;
             
-            updateSystemStats(cpu, ram, wpm);
+        case serial_hash("STATS"): {
+            // Parse stats: STATS:CPU:45,RAM:67,WPM:23
+            const char* cpu = serial_find_field(arg, "CPU");
+            const char* ram = serial_find_field(arg, "RAM");
+            const char* wpm = serial_find_field(arg, "WPM");
             
-        } else if (command.startsWith("TIME:")) {
-            // Handle time updates from Python script
-            String time_str = command.substring(5);
-            if (time_str.length() == 5 && time_str.charAt(2) == ':') {
-                current_time_str = time_str;
+            updateSystemStats(cpu ? serial_parse_int(cpu) : 0,
+                              ram ? serial_parse_int(ram) : 0,
+                              wpm ? serial_parse_int(wpm) : 0);
+            break;
+        }
+        
+        case serial_hash("TIME"):
+            // Handle time updates from Python script (TIME:HH:MM)
+            if (strlen(arg) == 5 && arg[2] == ':') {
+                memcpy(current_time_str, arg, sizeof(current_time_str));
             }
+            break;
             
-        } else if (command.startsWith("CPU:")) {
+        case serial_hash("CPU"):
             // Handle CPU usage updates
-            cpu_usage = command.substring(4).toInt();
+            updateSystemStats(serial_parse_int(arg), ram_usage, wpm_speed);
+            break;
             
-        } else if (command.startsWith("RAM:")) {
+        case serial_hash("RAM"):
             // Handle RAM usage updates  
-            ram_usage = command.substring(4).toInt();
+            updateSystemStats(cpu_usage, serial_parse_int(arg), wpm_speed);
+            break;
             
-        } else if (command.startsWith("WPM:")) {
+        case serial_hash("WPM"):
             // Handle WPM display updates
-            wpm_speed = command.substring(4).toInt();
+            updateSystemStats(cpu_usage, ram_usage, serial_parse_int(arg));
+            break;
             
-        } else if (command == "PING") {
+        case serial_hash("PING"):
             Serial.println("PONG");
+            break;
             
-        } else if (command.startsWith("ANIM:")) {
+        case serial_hash("ANIM"):
             // Handle specific animation commands from tester
-            String anim = command.substring(5);
-            if (anim == "IDLE_1") {
+            if (strcmp(arg, "IDLE_1") == 0) {
                 sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE1, current_time);
-            } else if (anim == "IDLE_2") {
+            } else if (strcmp(arg, "IDLE_2") == 0) {
                 sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE2, current_time);
-            } else if (anim == "IDLE_3") {
+            } else if (strcmp(arg, "IDLE_3") == 0) {
                 sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE3, current_time);
-            } else if (anim == "IDLE_4") {
+            } else if (strcmp(arg, "IDLE_4") == 0) {
                 sprite_manager_set_state(&sprite_manager, ANIM_STATE_IDLE_STAGE4, current_time);
-            } else if (anim == "BLINK") {
+            } else if (strcmp(arg, "BLINK") == 0) {
                 sprite_manager_set_state(&sprite_manager, ANIM_STATE_BLINKING, current_time);
-            } else if (anim == "EAR_TWITCH") {
+            } else if (strcmp(arg, "EAR_TWITCH") == 0) {
                 sprite_manager_set_state(&sprite_manager, ANIM_STATE_EAR_TWITCH, current_time);
             }
             Serial.println("PONG");
+            break;
             
         // NEW CONFIGURATION COMMANDS
-        } else if (command.startsWith("DISPLAY_CPU:")) {
-            String value = command.substring(12);
-            settings.show_cpu = (value == "ON");
-            updateDisplayVisibility();
-            Serial.println("🖥️ CPU display: " + value);
+        case serial_hash("DISPLAY_CPU"):
+            setDisplayOption(&settings.show_cpu, "🖥️ CPU display: ", arg);
+            break;
             
-        } else if (command.startsWith("DISPLAY_RAM:")) {
-            String value = command.substring(12);
-            settings.show_ram = (value == "ON");
-            updateDisplayVisibility();
-            Serial.println("💾 RAM display: " + value);
+        case serial_hash("DISPLAY_RAM"):
+            setDisplayOption(&settings.show_ram, "💾 RAM display: ", arg);
+            break;
             
-        } else if (command.startsWith("DISPLAY_WPM:")) {
-            String value = command.substring(12);
-            settings.show_wpm = (value == "ON");
-            updateDisplayVisibility();
-            Serial.println("⌨️ WPM display: " + value);
+        case serial_hash("DISPLAY_WPM"):
+            setDisplayOption(&settings.show_wpm, "⌨️ WPM display: ", arg);
+            break;
             
-        } else if (command.startsWith("DISPLAY_TIME:")) {
-            String value = command.substring(13);
-            settings.show_time = (value == "ON");
-            updateDisplayVisibility();
-            Serial.println("🕐 Time display: " + value);
+        case serial_hash("DISPLAY_TIME"):
+            setDisplayOption(&settings.show_time, "🕐 Time display: ", arg);
+            break;
             
-        } else if (command.startsWith("TIME_FORMAT:")) {
-            String format = command.substring(12);
-            settings.time_format_24h = (format == "24");
-            Serial.println("🕐 Time format: " + format + " hour");
+        case serial_hash("TIME_FORMAT"):
+            settings.time_format_24h = (strcmp(arg, "24") == 0);
+            Serial.print("🕐 Time format: ");
+            Serial.print(arg);
+            Serial.println(" hour");
+            break;
             
-        } else if (command.startsWith("SLEEP_TIMEOUT:")) {
-            int timeout = command.substring(14).toInt();
+        case serial_hash("SLEEP_TIMEOUT"): {
+            int timeout = serial_parse_int(arg);
             if (timeout >= 1 && timeout <= 60) {
                 settings.sleep_timeout_minutes = timeout;
-                Serial.println("😴 Sleep timeout: " + String(timeout) + " minutes");
+                Serial.print("😴 Sleep timeout: ");
+                Serial.print(timeout);
+                Serial.println(" minutes");
             } else {
                 Serial.println("❌ Invalid sleep timeout (1-60 minutes)");
             }
-            
-        } else if (command.startsWith("SENSITIVITY:")) {
-            float sensitivity = command.substring(12).toFloat();
+            break;
+        }
+        
+        case serial_hash("SENSITIVITY"): {
+            float sensitivity = strtof(arg, NULL);
             if (sensitivity >= 0.1 && sensitivity <= 5.0) {
                 settings.animation_sensitivity = sensitivity;
-                Serial.println("🎚️ Animation sensitivity: " + String(sensitivity));
+                Serial.print("🎚️ Animation sensitivity: ");
+                Serial.println(sensitivity);
             } else {
                 Serial.println("❌ Invalid sensitivity (0.1-5.0)");
             }
-            
-        } else if (command == "SAVE_SETTINGS") {
+            break;
+        }
+        
+        case serial_hash("SAVE_SETTINGS"):
             saveSettings();
+            break;
             
-        } else if (command == "LOAD_SETTINGS") {
+        case serial_hash("LOAD_SETTINGS"):
             loadSettings();
             updateDisplayVisibility();  // Apply the loaded settings immediately
+            break;
             
-        } else if (command == "RESET_SETTINGS") {
+        case serial_hash("CACHE_STATS"):
+            if (strcmp(arg, "RESET") == 0) {
+                sprite_cache_reset_counters();
+                Serial.println("🔄 Sprite cache counters reset");
+            } else {
+                printCacheStats();
+            }
+            break;
+            
+        case serial_hash("PERF"):
+            if (strcmp(arg, "RESET") == 0) {
+                perf_reset();
+                Serial.println("🔄 Profiler reset");
+            } else {
+                perf_dump();
+            }
+            break;
+            
+        case serial_hash("POWER"):
+            printPowerStats();
+            break;
+            
+        case serial_hash("DISPLAY"):
+            printDisplayStats();
+            break;
+            
+        case serial_hash("OVERLAY"):
+            if (strcmp(arg, "RESET") == 0) {
+                stats_overlay_reset_stats();
+                Serial.println("🔄 Overlay counters reset");
+            } else {
+                printOverlayStats();
+            }
+            break;
+            
+        case serial_hash("SENSOR_DUMP"):
+            // Streamed from the render loop while the UART has room
+            sensor_history_dump_begin(millis());
+            break;
+            
+        case serial_hash("MEM"):
+            if (strcmp(arg, "RESET") == 0) {
+                mem_telemetry_reset_peaks();
+                Serial.println("🔄 Memory peaks reset");
+            } else {
+                printMemStats();
+            }
+            break;
+            
+        case serial_hash("RESET_SETTINGS"):
             resetSettings();
             updateDisplayVisibility();  // Apply the reset settings immediately
-            saveSettings();  // Save defaults to EEPROM
+            saveSettings();  // Save defaults to NVS
             Serial.println("🔄 Settings reset and saved");
-        }
+            break;
+            
+        default:
+            break;  // Unknown command
     }
 }
 
-// Sprite management functions
-void sprite_manager_init(sprite_manager_t* manager) {
-    // Initialize all layers to basic state
-    manager->current_sprites[LAYER_BODY] = &standardbody1;
-    manager->current_sprites[LAYER_FACE] = &stock_face;
-    manager->current_sprites[LAYER_TABLE] = &table1;
-    manager->current_sprites[LAYER_PAWS] = &twopawsup;  // Default paws up
-    manager->current_sprites[LAYER_EFFECTS] = NULL;
-    
-    manager->current_state = ANIM_STATE_IDLE_STAGE1;
-    manager->state_start_time = millis();
-    manager->blink_timer = millis() + random(3000, 8000);
-    manager->ear_twitch_timer = millis() + random(10000, 30000);
-    manager->effect_timer = 0;
-    manager->effect_frame = 0;
-    manager->paw_animation_active = false;
-    manager->paw_frame = 0;
-    manager->paw_timer = 0;
-    manager->animation_speed_ms = 200;  // Default speed
-    manager->click_effect_left = false;
-    
-    // Enhanced animation control
-    manager->idle_progression_enabled = false;  // Start with Python control
-    manager->last_typing_time = 0;
-    manager->is_streak_mode = false;             // Start without streak mode
-    
-    // Initialize animation state variables
-    manager->blink_start_time = 0;
-    manager->blinking = false;
-    manager->ear_twitch_start_time = 0;
-    manager->ear_twitching = false;
-    
-    Serial.println("🐱 Sprite manager initialized");
-}
-
-// Calculate adaptive sleep stage timing based on user's timeout setting
-void calculateSleepStageTiming(int timeout_minutes, unsigned long* stage1_ms, unsigned long* stage2_ms, unsigned long* stage3_ms) {
-    unsigned long total_ms = (unsigned long)timeout_minutes * 60 * 1000;
-    
-    // Define minimums and maximums for each stage
-    unsigned long min_stage2 = 5000;   // 5 seconds minimum
-    unsigned long max_stage2 = 60000;  // 1 minute maximum
-    unsigned long min_stage3 = 3000;   // 3 seconds minimum  
-    unsigned long max_stage3 = 30000;  // 30 seconds maximum
+// Apply a binary STATS frame: one frame replaces STATS, SPEED and STREAK lines (render task)
+void processBinaryFrame(const binary_frame_t* frame) {
+    uint32_t current_time = millis();
     
-    // Calculate based on timeout range for optimal user experience
-    if (timeout_minutes <= 3) {
-        // Short timeouts: quick but visible progression
-        *stage2_ms = max(min_stage2, min(max_stage2, (unsigned long)(total_ms * 0.25)));
-        *stage3_ms = max(min_stage3, min(max_stage3, (unsigned long)(total_ms * 0.15)));
-    } else if (timeout_minutes <= 10) {
-        // Medium timeouts: balanced progression
-        *stage2_ms = max(min_stage2, min(max_stage2, (unsigned long)(total_ms * 0.20)));
-        *stage3_ms = max(min_stage3, min(max_stage3, (unsigned long)(total_ms * 0.10)));
-    } else {
-        // Long timeouts: mostly normal, quick sleep transition
-        *stage2_ms = max(min_stage2, min(max_stage2, (unsigned long)(total_ms * 0.15)));
-        *stage3_ms = max(min_stage3, min(max_stage3, (unsigned long)(total_ms * 0.05)));
+    binary_keys_t keys;
+    if (binary_decode_keys(frame, &keys)) {
+        // A paw per key-down; STATS frames keep choosing the state (and the
+        // rate-based paws take over again when the keys stop coming)
+        sprite_manager.last_command_time = current_time;
+        sprite_manager.python_control_mode = true;
+        sprite_manager_key_events(&sprite_manager, keys.events, keys.count, current_time);
+        key_redraw = true;
+        return;
     }
     
-    // Stage 1 gets the remainder to ensure total equals user setting
-    *stage1_ms = total_ms - *stage2_ms - *stage3_ms;
-}
-
-void sprite_manager_update(sprite_manager_t* manager, uint32_t current_time) {
-    // Check for typing timeout (Arduino-side safety)
-    if (manager->paw_animation_active && manager->last_typing_time > 0) {
-        if (current_time - manager->last_typing_time > TYPING_TIMEOUT_MS) {
-            // Stop typing animation due to timeout
-            manager->paw_animation_active = false;
-            manager->current_sprites[LAYER_EFFECTS] = NULL;
-            Serial.println("🛑 Typing timeout - stopping animation");
-        }
-    }
+    binary_stats_t stats;
+    if (!binary_decode_stats(frame, &stats)) return;  // Unknown frame type
     
-    // Check if Python control has timed out
-    if (python_control_mode && current_time - last_command_time > PYTHON_TIMEOUT_MS) {
-        python_control_mode = false;
-        manager->idle_progression_enabled = true;
-        Serial.println("⚠️ Python timeout - enabling auto mode");
-    }
+    sprite_manager.last_command_time = current_time;
+    sprite_manager.python_control_mode = true;
     
-    // Handle automatic idle progression only if enabled
-    if (manager->idle_progression_enabled || !python_control_mode) {
-        // Calculate adaptive timing based on current sleep timeout setting
-        unsigned long stage1_duration, stage2_duration, stage3_duration;
-        calculateSleepStageTiming(settings.sleep_timeout_minutes, &stage1_duration, &stage2_duration, &stage3_duration);
-        
-        if (manager->current_state == ANIM_STATE_IDLE_STAGE1) {
-            if (current_time - manager->state_start_time > stage1_duration) {
-                sprite_manager_set_state(manager, ANIM_STATE_IDLE_STAGE2, current_time);
-            }
-        } else if (manager->current_state == ANIM_STATE_IDLE_STAGE2) {
-            if (current_time - manager->state_start_time > stage2_duration) {
-                sprite_manager_set_state(manager, ANIM_STATE_IDLE_STAGE3, current_time);
-            }
-        } else if (manager->current_state == ANIM_STATE_IDLE_STAGE3) {
-            if (current_time - manager->state_start_time > stage3_duration) {
-                sprite_manager_set_state(manager, ANIM_STATE_IDLE_STAGE4, current_time);
-            }
-        }
-    }
+    updateSystemStats(stats.cpu, stats.ram, stats.wpm);
     
-    // Handle paw animations - 4-step pattern: left_down → both_up → right_down → both_up
-    if (manager->paw_animation_active) {
-        // Trust Python's speed calculations - no additional rate limiting
-        if (current_time - manager->paw_timer >= manager->animation_speed_ms) {
-            manager->paw_frame = (manager->paw_frame + 1) % 4;  // 4-step pattern
-            
-            // 4-step typing pattern with effects synchronized to paw strikes
-            switch (manager->paw_frame) {
-                case 0:  // Left paw down
-                    manager->current_sprites[LAYER_PAWS] = &leftpawdown;
-                    // Show left click effect for fast typing
-                    if (manager->current_state == ANIM_STATE_TYPING_FAST || 
-                        manager->current_state == ANIM_STATE_TYPING_STREAK) {
-                        manager->current_sprites[LAYER_EFFECTS] = &left_click_effect;
-                    } else {
-                        manager->current_sprites[LAYER_EFFECTS] = NULL;
-                    }
-                    break;
-                    
-                case 1:  // Both paws up (rest position)
-                    manager->current_sprites[LAYER_PAWS] = &twopawsup;
-                    manager->current_sprites[LAYER_EFFECTS] = NULL;  // No effects during rest
-                    break;
-                    
-                case 2:  // Right paw down  
-                    manager->current_sprites[LAYER_PAWS] = &rightpawdown;
-                    // Show right click effect for fast typing
-                    if (manager->current_state == ANIM_STATE_TYPING_FAST || 
-                        manager->current_state == ANIM_STATE_TYPING_STREAK) {
-                        manager->current_sprites[LAYER_EFFECTS] = &right_click_effect;
-                    } else {
-                        manager->current_sprites[LAYER_EFFECTS] = NULL;
-                    }
-                    break;
-                    
-                case 3:  // Both paws up (rest position)
-                    manager->current_sprites[LAYER_PAWS] = &twopawsup;
-                    manager->current_sprites[LAYER_EFFECTS] = NULL;  // No effects during rest
-                    break;
-            }
-            manager->paw_timer = current_time;
-        }
-    } else {
-        // When not typing, ensure paws are in the correct idle position based on state
-        if (manager->current_state == ANIM_STATE_IDLE_STAGE1) {
-            manager->current_sprites[LAYER_PAWS] = &twopawsup;  // Visible paws for stage 1
-        } else if (manager->current_state >= ANIM_STATE_IDLE_STAGE2 && 
-                   manager->current_state <= ANIM_STATE_IDLE_STAGE4) {
-            manager->current_sprites[LAYER_PAWS] = NULL;  // Hidden paws for stages 2-4
-        }
-        
-        // Only clear effects if NOT in IDLE_STAGE4 (which needs sleepy effects)
-        if (manager->current_state != ANIM_STATE_IDLE_STAGE4) {
-            manager->current_sprites[LAYER_EFFECTS] = NULL;  // Clear typing effects
-        }
+    // Streak first so a new typing state already picks the right face
+    bool streak = (stats.flags & BINARY_FLAG_STREAK) != 0;
+    if (streak != sprite_manager.is_streak_mode) {
+        sprite_manager.is_streak_mode = streak;
+        LOG_DEBUG("%s", streak ? "😊 Streak mode enabled - happy face!" : "😐 Streak mode disabled - normal face");
     }
     
-    // Handle sleepy effects animation (for IDLE_STAGE4)
-    if (manager->current_state == ANIM_STATE_IDLE_STAGE4) {
-        if (current_time - manager->effect_timer > 1000) { // Change effect every second
-            manager->effect_frame = (manager->effect_frame + 1) % 3;
-            switch (manager->effect_frame) {
-                case 0: manager->current_sprites[LAYER_EFFECTS] = &sleepy1; break;
-                case 1: manager->current_sprites[LAYER_EFFECTS] = &sleepy2; break;
-                case 2: manager->current_sprites[LAYER_EFFECTS] = &sleepy3; break;
-            }
-            manager->effect_timer = current_time;
-        }
+    bool typing = (stats.flags & BINARY_FLAG_TYPING) && stats.speed > 0;
+    if (typing) {
+        sprite_manager_apply_speed(&sprite_manager, stats.speed, current_time);
+    } else if (binary_typing) {
+        // Only stop on the typing -> idle edge, like the single STOP line the
+        // host sends, so idle progression is not reset by every frame
+        sprite_manager_stop(&sprite_manager, current_time);
     }
+    binary_typing = typing;
+}
+
+// Transport commands are answered by the I/O task itself, since they
+// change how it splits the incoming stream
+static bool handleTransportCommand(const serial_command_t* cmd) {
+    if (cmd->verb_hash != serial_hash("PROTO")) return false;
     
-    // Handle automatic blinking (only when awake, not during sleep)
-    // Only blink when not sleeping (stages 3 and 4 have sleepy face, no blinking)
-    bool can_blink = (manager->current_state != ANIM_STATE_IDLE_STAGE3 && 
-                      manager->current_state != ANIM_STATE_IDLE_STAGE4);
-    
-    if (!manager->blinking && current_time >= manager->blink_timer && can_blink) {
-        // Start blink
-        manager->blinking = true;
-        manager->blink_start_time = current_time;
-        manager->current_sprites[LAYER_FACE] = &blink_face;
-    } else if (manager->blinking && current_time - manager->blink_start_time > 200) {
-        // End blink after 200ms
-        manager->blinking = false;
-        // Restore normal face after blink based on current state and streak mode
-        if (manager->current_state == ANIM_STATE_IDLE_STAGE3 || 
-            manager->current_state == ANIM_STATE_IDLE_STAGE4) {
-            manager->current_sprites[LAYER_FACE] = &sleepy_face;
-        } else if (manager->is_streak_mode && manager->paw_animation_active) {
-            manager->current_sprites[LAYER_FACE] = &happy_face;  // Happy face during any typing streak
-        } else {
-            manager->current_sprites[LAYER_FACE] = &stock_face;  // Default face
-        }
-        // Set next blink time (only if can still blink)
-        if (can_blink) {
-            manager->blink_timer = current_time + random(3000, 8000);
-        } else {
-            // When entering sleep, set longer blink timer for when waking up
-            manager->blink_timer = current_time + random(5000, 10000);
-        }
+    // Host asks for binary STATS frames (PROTO:BIN) or plain text (PROTO:TEXT)
+    if (strcmp(cmd->arg, "BIN") == 0) {
+        serial_link_set_binary(&serial_link, true);
+        Serial.println("PROTO:BIN_OK");
+    } else if (strcmp(cmd->arg, "TEXT") == 0) {
+        serial_link_set_binary(&serial_link, false);
+        Serial.println("PROTO:TEXT_OK");
+    } else if (strcmp(cmd->arg, "KEYS") == 0 && serial_link.binary_mode) {
+        // KEYS frames are always understood; this tells the host it may send them
+        Serial.println("PROTO:KEYS_OK");
     }
-    
-    // Handle ear twitch
-    if (!manager->ear_twitching && current_time >= manager->ear_twitch_timer) {
-        // Start ear twitch
-        manager->ear_twitching = true;
-        manager->ear_twitch_start_time = current_time;
-        manager->current_sprites[LAYER_BODY] = &bodyeartwitch;
-    } else if (manager->ear_twitching && current_time - manager->ear_twitch_start_time > 500) {
-        // End ear twitch after 500ms
-        manager->ear_twitching = false;
-        manager->current_sprites[LAYER_BODY] = &standardbody1;
-        // Set next ear twitch time
-        manager->ear_twitch_timer = current_time + random(10000, 30000);
+    return true;
+}
+
+// Queue an event for the render task and wake it up (I/O task)
+static void postEvent(app_event_t* event) {
+    event->time_us = micros();
+    event_queue_push(&app_events, event);
+    if (render_task_handle) {
+        xTaskNotifyGive(render_task_handle);
     }
 }
 
-void sprite_manager_set_state(sprite_manager_t* manager, animation_state_t new_state, uint32_t current_time) {
-    Serial.print("🔄 Animation state: ");
-    Serial.print(get_state_name(manager->current_state));
-    Serial.print(" → ");
-    Serial.println(get_state_name(new_state));
+// Each complete text line becomes a command event (I/O task)
+static void onSerialCommand(const serial_command_t* cmd, void* ctx) {
+    if (handleTransportCommand(cmd)) return;
     
-    manager->current_state = new_state;
-    manager->state_start_time = current_time;
+    app_event_t event;
+    event.type = APP_EVENT_COMMAND;
+    event.command.verb_hash = cmd->verb_hash;
+    strncpy(event.command.arg, cmd->arg, APP_EVENT_ARG_MAX);
+    event.command.arg[APP_EVENT_ARG_MAX] = '\0';
+    postEvent(&event);
+}
+
+static void onSerialFrame(const binary_frame_t* frame, void* ctx) {
+    app_event_t event;
+    event.type = APP_EVENT_FRAME;
+    event.frame = *frame;
+    postEvent(&event);
+}
+
+// Handle serial commands from Python script (I/O task)
+void handleSerialCommands() {
+    // Take only what has already arrived - a partial line simply waits in
+    // the parser for the next call instead of blocking the loop
+    uint8_t chunk[64];
+    int available;
     
-    // Update typing timing for timeout tracking
-    if (new_state == ANIM_STATE_TYPING_SLOW || 
-        new_state == ANIM_STATE_TYPING_NORMAL || 
-        new_state == ANIM_STATE_TYPING_FAST) {
-        manager->last_typing_time = current_time;
+    while ((available = Serial.available()) > 0) {
+        size_t n = Serial.readBytes(chunk, (size_t)available < sizeof(chunk) ? (size_t)available : sizeof(chunk));
+        serial_link_feed(&serial_link, chunk, n);
     }
-    
-    // Set appropriate sprites based on state - always ensure base layers are set
-    // Base layers that should always be present
-    manager->current_sprites[LAYER_BODY] = &standardbody1;
-    manager->current_sprites[LAYER_TABLE] = &table1;
-    
-    switch (new_state) {
-        case ANIM_STATE_IDLE_STAGE1:
-            // Stage 1: Stock face with paws up (hands visible above table)
-            manager->current_sprites[LAYER_PAWS] = &twopawsup;  // Both paws visible above table
-            manager->current_sprites[LAYER_EFFECTS] = NULL;
-            manager->current_sprites[LAYER_FACE] = &stock_face;
-            manager->paw_animation_active = false;
-            Serial.println("😐 Stage 1: Stock face, paws up");
-            break;
-            
-        case ANIM_STATE_IDLE_STAGE2:
-            // Stage 2: Stock face + hands gone (underneath table)
-            manager->current_sprites[LAYER_PAWS] = NULL;  // No paws visible (hands underneath table)
-            manager->current_sprites[LAYER_EFFECTS] = NULL;
-            manager->current_sprites[LAYER_FACE] = &stock_face;  // Still stock face
-            manager->paw_animation_active = false;
-            Serial.println("😐 Stage 2: Stock face, hands hidden");
-            break;
-            
-        case ANIM_STATE_IDLE_STAGE3:
-            // Stage 3: Hands gone + sleepy face (prepare for effects)
-            manager->current_sprites[LAYER_PAWS] = NULL;  // No paws visible
-            manager->current_sprites[LAYER_EFFECTS] = NULL;
-            manager->current_sprites[LAYER_FACE] = &sleepy_face;
-            manager->paw_animation_active = false;
-            Serial.println("😴 Stage 3: Deep sleep preparation, hands hidden");
+}
+
+// Apply one event from the I/O task (render task)
+void processEvent(const app_event_t* event) {
+    switch (event->type) {
+        case APP_EVENT_COMMAND:
+            if (event->command.verb_hash == serial_hash("SEQ")) {
+                // Latency probe: stamps the next command or frame, is not one itself
+                latency_probe_arm(strtoul(event->command.arg, NULL, 10));
+                return;
+            }
+            processCommand(event->command.verb_hash, event->command.arg);
+            sprite_manager.sleep_timeout_minutes = settings.sleep_timeout_minutes;  // SLEEP_TIMEOUT, LOAD/RESET_SETTINGS
+            latency_probe_applied(event->time_us);
             break;
             
-        case ANIM_STATE_IDLE_STAGE4:
-            // Stage 4: Hands gone + sleepy face + cycling sleepy effects
-            manager->current_sprites[LAYER_PAWS] = NULL;  // No paws visible
-            manager->current_sprites[LAYER_FACE] = &sleepy_face;
-            manager->paw_animation_active = false;
-            manager->effect_timer = current_time;  // Initialize effect timer for cycling
-            // Effects will cycle in main update loop
-            Serial.println("😴 Stage 4: Deep sleep with cycling effects, hands hidden");
+        case APP_EVENT_FRAME:
+            processBinaryFrame(&event->frame);
+            latency_probe_applied(event->time_us);
             break;
             
-        case ANIM_STATE_TYPING_SLOW:
-            // Slow typing: 4-step paw pattern, no effects
-            manager->current_sprites[LAYER_FACE] = manager->is_streak_mode ? &happy_face : &stock_face;
-            manager->current_sprites[LAYER_EFFECTS] = NULL;
-            manager->current_sprites[LAYER_PAWS] = &leftpawdown;  // Start with left paw (frame 0)
-            manager->paw_animation_active = true;
-            manager->paw_frame = 0;  // Reset paw frame to prevent stuck paws
-            manager->paw_timer = current_time;
-            Serial.println(manager->is_streak_mode ? "👐😊 Slow typing with happy face" : "👐 Slow typing");
-            break;
+        case APP_EVENT_TOUCH:
+            // 输出触摸坐标到串口
+            if (event->touch.phase == TOUCH_EVENT_DOWN) {
+                LOG_DEBUG("🔘 Touch: X=%u, Y=%u", event->touch.x, event->touch.y);
+            }
             
-        case ANIM_STATE_TYPING_NORMAL:
-            // Normal typing: 4-step paw pattern, no effects
-            manager->current_sprites[LAYER_FACE] = manager->is_streak_mode ? &happy_face : &stock_face;
-            manager->current_sprites[LAYER_EFFECTS] = NULL;
-            manager->current_sprites[LAYER_PAWS] = &leftpawdown;  // Start with left paw (frame 0)
-            manager->paw_animation_active = true;
-            manager->paw_frame = 0;  // Reset paw frame to prevent stuck paws
-            manager->paw_timer = current_time;
-            Serial.println(manager->is_streak_mode ? "👐😊 Normal typing with happy face" : "👐 Normal typing");
+            // 可以在这里添加触摸事件处理逻辑
+            // 例如：检查触摸位置，执行相应操作
             break;
             
-        case ANIM_STATE_TYPING_FAST:
-            // Fast typing: 4-step paw pattern + click effects
-            manager->current_sprites[LAYER_FACE] = manager->is_streak_mode ? &happy_face : &stock_face;
-            manager->current_sprites[LAYER_PAWS] = &leftpawdown;  // Start with left paw (frame 0)
-            manager->paw_animation_active = true;
-            manager->paw_frame = 0;  // Reset paw frame to prevent stuck paws
-            manager->paw_timer = current_time;
-            Serial.println(manager->is_streak_mode ? "👐⚡😊 Fast typing with happy face and effects" : "👐⚡ Fast typing with click effects");
+        case APP_EVENT_SENSOR:
+            if (event->sensor.ok) {
+                temperature = event->sensor.temperature;
+                humidity = event->sensor.humidity;
+                sensor_history_add(millis(), temperature, humidity);
+            }
             break;
             
-        case ANIM_STATE_TYPING_STREAK:
-            // Legacy streak state - treat as fast typing with happy face
-            manager->current_sprites[LAYER_FACE] = &happy_face;
-            manager->current_sprites[LAYER_PAWS] = &leftpawdown;  // Start with left paw (frame 0)
-            manager->paw_animation_active = true;
-            manager->paw_frame = 0;  // Reset paw frame to prevent stuck paws
-            manager->paw_timer = current_time;
-            Serial.println("👐⚡😊 Legacy streak mode - fast typing with happy face");
+        case APP_EVENT_BOOT:
+            // The queue orders this after the I/O task's write of boot_settings
+            settings = boot_settings;
+            sprite_manager.sleep_timeout_minutes = settings.sleep_timeout_minutes;
+            updateDisplayVisibility();
+            boot_complete = true;
+            Serial.println("✅ Bongo Cat Ready! (" + String(millis()) + " ms)");
             break;
     }
-    
-    // Reset idle progression when entering any typing state
-    if (new_state == ANIM_STATE_TYPING_SLOW || 
-        new_state == ANIM_STATE_TYPING_NORMAL || 
-        new_state == ANIM_STATE_TYPING_FAST) {
-        manager->idle_progression_enabled = false;  // Stop auto idle progression
-        Serial.println("🚫 Auto idle progression disabled");
-    }
-}
-
-void sprite_render_layers(sprite_manager_t* manager, lv_obj_t* canvas, uint32_t current_time) {
-    // Clear canvas with minimal operations
-    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_TRANSP);
-    
-    // Render layers in order (back to front) with optimized drawing
-    lv_draw_img_dsc_t img_dsc;
-    lv_draw_img_dsc_init(&img_dsc);  // Initialize once outside loop
-    
-    for (int layer = 0; layer < NUM_LAYERS; layer++) {
-        const lv_img_dsc_t* sprite = manager->current_sprites[layer];
-        if (sprite) {
-            // Draw sprite at origin (0,0) - canvas will be zoomed to 4x size
-            // Using single draw call per sprite to minimize operations
-            lv_canvas_draw_img(canvas, 0, 0, sprite, &img_dsc);
-        }
-    }
-}
-
-// Helper function to get state name for debugging
-const char* get_state_name(animation_state_t state) {
-    switch (state) {
-        case ANIM_STATE_IDLE_STAGE1: return "IDLE_STAGE1";
-        case ANIM_STATE_IDLE_STAGE2: return "IDLE_STAGE2"; 
-        case ANIM_STATE_IDLE_STAGE3: return "IDLE_STAGE3";
-        case ANIM_STATE_IDLE_STAGE4: return "IDLE_STAGE4";
-        case ANIM_STATE_TYPING_SLOW: return "TYPING_SLOW";
-        case ANIM_STATE_TYPING_NORMAL: return "TYPING_NORMAL";
-        case ANIM_STATE_TYPING_FAST: return "TYPING_FAST";
-        case ANIM_STATE_TYPING_STREAK: return "TYPING_STREAK";  // Keep for compatibility but unused
-        default: return "UNKNOWN";
-    }
 }
 
 void setup() {
+    // Room for what the host sends while the boot stage runs
+    Serial.setRxBufferSize(BOOT_SERIAL_RX_BUFFER);
     Serial.begin(115200);
     Serial.println("🐱 Bongo Cat with Sprites Starting...");
     
-    // Initialize EEPROM for settings persistence
-    EEPROM.begin(EEPROM_SIZE);
-    
-    // Load settings from EEPROM (will use defaults if invalid)
-    loadSettings();
+    // Cycle-counter timings for the PERF command
+    perf_init();
     
     // Initialize random seed for animations
     randomSeed(analogRead(0));
     
-    // Initialize backlight pin
+    Serial.println("📺 Initializing TFT display...");
+    tft.init();
+    
+    // PWM backlight and CPU clock (after tft.init, which may claim TFT_BL as a GPIO)
+    power_manager_init();
     #ifdef TFT_BL
-    pinMode(TFT_BL, OUTPUT);
-    digitalWrite(TFT_BL, HIGH); // Turn on backlight
-    Serial.println("🔦 Backlight initialized on pin " + String(TFT_BL));
+    Serial.println("🔦 Backlight PWM on pin " + String(TFT_BL));
     #else
     Serial.println("⚠️ TFT_BL not defined!");
     #endif
-    
-    Serial.println("📺 Initializing TFT display...");
-    tft.init();
     Serial.println("📺 TFT initialized, setting rotation...");
     tft.setRotation(0);
-    Serial.println("📺 Filling screen white...");
-    tft.fillScreen(TFT_WHITE);  // White background
-    Serial.println("📺 Screen filled!");
+    
+    // Fastest stable write clock, before initDMA() picks it up
+    display_backend_probe_spi(&tft);
     
     Serial.println("🎨 Initializing LVGL...");
     lv_init();
     
-    lv_disp_draw_buf_init(&draw_buf, buf, NULL, SCREEN_WIDTH * 10);
-    
-    static lv_disp_drv_t disp_drv;
-    lv_disp_drv_init(&disp_drv);
-    disp_drv.hor_res = SCREEN_WIDTH;
-    disp_drv.ver_res = SCREEN_HEIGHT;
-    disp_drv.flush_cb = my_disp_flush;
-    disp_drv.draw_buf = &draw_buf;
-    lv_disp_drv_register(&disp_drv);
+    // Double-buffered DMA flush (falls back to blocking pushColors)
+    display_backend_init(&tft, SCREEN_WIDTH, SCREEN_HEIGHT);
     
-    // Initialize sprite manager
+    // The first frame uses the defaults; the stored settings follow with APP_EVENT_BOOT
+    defaultSettings(&settings);
     sprite_manager_init(&sprite_manager);
+    sprite_manager.sleep_timeout_minutes = settings.sleep_timeout_minutes;
     
-    // Initialize touch screen
-    initTouchScreen();
+    createBongoCat();
     
-    // Initialize AHT30 sensor
-    Serial.println("🌡️ Initializing AHT30 sensor...");
-    if (aht30.begin()) {
-        aht30_initialized = true;
-        Serial.println("✅ AHT30 sensor initialized successfully!");
-    } else {
-        Serial.println("❌ AHT30 sensor initialization failed!");
+    // Cat only until the stored settings say which labels to show
+    for (uint8_t field = 0; field < STATS_FIELD_COUNT; field++) {
+        stats_overlay_set_visible((stats_field_t)field, false);
     }
     
-    createBongoCat();
+    // First frame right away, as one burst that also covers the whole panel
+    // (no fillScreen beforehand)
+    display_backend_begin_frame();
+    lv_refr_now(NULL);
+    display_backend_wait_idle();
+    Serial.println("🖼️ First frame at " + String(millis()) + " ms");
     
-    // Apply loaded settings to display visibility now that UI is created
-    updateDisplayVisibility();
-    
-    Serial.println("✅ Bongo Cat Ready!");
+    // From here on only renderTask touches LVGL; ioTask finishes the boot
+    event_queue_init(&app_events);
+    static const serial_link_handlers_t serial_handlers = {onSerialCommand, onSerialFrame, NULL};
+    serial_link_init(&serial_link, &serial_handlers);
+    xTaskCreatePinnedToCore(renderTask, "render", RENDER_TASK_STACK, NULL, RENDER_TASK_PRIORITY, &render_task_handle, RENDER_TASK_CORE);
+    xTaskCreatePinnedToCore(ioTask, "io", IO_TASK_STACK, NULL, IO_TASK_PRIORITY, &io_task_handle, IO_TASK_CORE);
 }
 
 void createBongoCat() {
@@ -902,47 +769,26 @@ void createBongoCat() {
     Serial.println("🎨 Setting background color...");
     lv_obj_set_style_bg_color(screen, lv_color_white(), 0);
     
-    // Create cat canvas with proper sizing
-    cat_canvas = lv_canvas_create(screen);
-    
-    // Use 64x64 base sprite size for the canvas buffer
-    static lv_color_t canvas_buf[CAT_SIZE * CAT_SIZE];  // 64x64 buffer
-    lv_canvas_set_buffer(cat_canvas, canvas_buf, CAT_SIZE, CAT_SIZE, LV_IMG_CF_TRUE_COLOR);
+    // Create the cat: 64x64 sprites composited and drawn as 256x256 (4x) blocks
+    cat_canvas = cat_compositor_create(screen, lv_color_white());
     
-    // Apply 4x zoom to make 64x64 sprites appear as 256x256 on screen
-    lv_img_set_zoom(cat_canvas, 1024);  // 4x zoom: 64x64 -> 256x256 pixels
-    lv_img_set_antialias(cat_canvas, false);  // Keep pixels crisp and blocky
+    // Precompute opaque bounding boxes so sprite swaps only redraw what they touch
+    static const lv_img_dsc_t* const all_sprites[] = {
+        &standardbody1, &bodyeartwitch,
+        &stock_face, &happy_face, &blink_face, &sleepy_face,
+        &leftpawdown, &rightpawdown, &twopawsup,
+        &table1,
+        &left_click_effect, &right_click_effect, &sleepy1, &sleepy2, &sleepy3
+    };
+    cat_compositor_register_sprites(all_sprites, sizeof(all_sprites) / sizeof(all_sprites[0]));
+    sprite_cache_init(SPRITE_CACHE_BUDGET);
     
     // Position cat: original alignment method + 3 cat pixels right + a bit lower
     lv_obj_align(cat_canvas, LV_ALIGN_CENTER, 12, 50);  // 12px right (3 cat pixels), 50px lower
     
-    // Create system stats labels (top left) with pixelated font
+    // Create system stats labels (top left) and time (top right) with pixelated font
     Serial.println("🎨 Creating labels...");
-    cpu_label = lv_label_create(screen);
-    lv_label_set_text(cpu_label, "CPU: 0%");
-    lv_obj_set_style_text_font(cpu_label, &lv_font_unscii_16, 0);
-    lv_obj_set_style_text_color(cpu_label, lv_color_black(), 0);
-    lv_obj_align(cpu_label, LV_ALIGN_TOP_LEFT, 5, 5);
-    Serial.println("🎨 CPU label created");
-    
-    ram_label = lv_label_create(screen);
-    lv_label_set_text(ram_label, "RAM: 0%");
-    lv_obj_set_style_text_font(ram_label, &lv_font_unscii_16, 0);
-    lv_obj_set_style_text_color(ram_label, lv_color_black(), 0);
-    lv_obj_align(ram_label, LV_ALIGN_TOP_LEFT, 5, 25);
-    
-    wpm_label = lv_label_create(screen);
-    lv_label_set_text(wpm_label, "WPM: 0");
-    lv_obj_set_style_text_font(wpm_label, &lv_font_unscii_16, 0);
-    lv_obj_set_style_text_color(wpm_label, lv_color_black(), 0);
-    lv_obj_align(wpm_label, LV_ALIGN_TOP_LEFT, 5, 45);
-    
-    // Create time label (top right) - bigger pixelated font
-    time_label = lv_label_create(screen);
-    lv_label_set_text(time_label, "00:00");
-    lv_obj_set_style_text_font(time_label, &lv_font_unscii_16, 0);
-    lv_obj_set_style_text_color(time_label, lv_color_black(), 0);
-    lv_obj_align(time_label, LV_ALIGN_TOP_RIGHT, -5, 5);
+    stats_overlay_create(screen);
     
     // Initial render
     Serial.println("🎨 Rendering initial sprite...");
@@ -950,66 +796,291 @@ void createBongoCat() {
     Serial.println("🎨 UI creation complete!");
 }
 
-void loop() {
-    handleSerialCommands();
-    
-    // Read touch screen input
-    readTouchScreen();
+// True while LVGL has invalidated areas waiting for a refresh
+static bool lvglRedrawPending() {
+    lv_disp_t* disp = lv_disp_get_default();
+    return disp && disp->inv_p > 0;
+}
+
+// Render task (core 1): owns LVGL, the sprite manager and all app state
+void renderTask(void* param) {
+    scheduler_t timers;
+    scheduler_init(&timers);
     
-    uint32_t current_time = millis();
+    uint32_t last_animation_update = millis();
+    uint32_t last_lvgl_update = last_animation_update;
+    scheduler_set(&timers, RENDER_TIMER_ANIMATION, last_animation_update);
+    scheduler_set(&timers, RENDER_TIMER_CLOCK, last_animation_update);
+    scheduler_set(&timers, RENDER_TIMER_LVGL, last_animation_update);
+    scheduler_set(&timers, RENDER_TIMER_MEMORY, last_animation_update + MEM_TELEMETRY_SAMPLE_MS);
+    uint32_t last_mem_report = last_animation_update;
     
-    // Update animations - removed fixed frame rate to prevent conflicts
-    static uint32_t last_animation_update = 0;
-    if (current_time - last_animation_update >= 25) {  // 40 FPS max (more responsive)
-        sprite_manager_update(&sprite_manager, current_time);
+    for (;;) {
+        PERF_START(frame_start);
+        
+        // Apply everything the I/O task has posted
+        app_event_t event;
+        bool had_events = false;
+        while (event_queue_pop(&app_events, &event)) {
+            processEvent(&event);
+            had_events = true;
+        }
         
-        // Only render if sprites actually changed to reduce canvas operations
-        static uint32_t last_sprite_hash = 0;
-        uint32_t current_sprite_hash = 0;
+        uint32_t current_time = millis();
+        
+        // SAVE_SETTINGS moves the commit back; it runs once the burst is over
+        // (the I/O task owns the store until the boot stage is done)
+        uint32_t settings_deadline;
+        if (boot_complete && settings_store_pending(&settings_deadline)) {
+            scheduler_set(&timers, RENDER_TIMER_SETTINGS, settings_deadline);
+        }
         
-        // Calculate simple hash of current sprites to detect changes (optimized)
-        for (int i = 0; i < NUM_LAYERS; i++) {
-            current_sprite_hash += (uint32_t)sprite_manager.current_sprites[i];
+        // A SENSOR_DUMP came in
+        if (sensor_history_dump_pending() && !scheduler_is_armed(&timers, RENDER_TIMER_SENSOR_DUMP)) {
+            scheduler_set(&timers, RENDER_TIMER_SENSOR_DUMP, current_time);
+        }
+        
+        // A stats value that came in too soon after the last redraw of its label
+        uint32_t overlay_deadline;
+        if (stats_overlay_pending(&overlay_deadline)) {
+            scheduler_set(&timers, RENDER_TIMER_OVERLAY, overlay_deadline);
+        }
+        
+        // Commands can change the animation state: update as soon as the frame cap allows
+        // (a key strike goes out right away, key-to-photon is what it is for)
+        if (key_redraw) {
+            scheduler_set(&timers, RENDER_TIMER_ANIMATION, current_time);
+        } else if (had_events) {
+            scheduler_set_earlier(&timers, RENDER_TIMER_ANIMATION, last_animation_update + framePeriod(ANIMATION_MIN_PERIOD));
+        }
+        
+        uint8_t timer;
+        while (scheduler_pop_due(&timers, current_time, &timer)) {
+            bool low_power = power_manager_get_mode() == POWER_MODE_LOW;
+            switch (timer) {
+                case RENDER_TIMER_ANIMATION: {
+                    {
+                        PERF_SCOPE(PERF_ANIM_UPDATE);
+                        sprite_manager_update(&sprite_manager, current_time);
+                    }
+                    
+                    // The compositor diffs the layers itself and only redraws the boxes that changed
+                    {
+                        PERF_SCOPE(PERF_RENDER_LAYERS);
+                        sprite_render_layers(&sprite_manager, cat_canvas, current_time);
+                    }
+                    
+                    last_animation_update = current_time;
+                    latency_probe_rendered(lvglRedrawPending());
+                    
+                    // Sleep until the next blink, paw step, timeout... but stay under the frame cap
+                    uint32_t next = sprite_manager_next_deadline(&sprite_manager, current_time);
+                    uint32_t earliest = current_time + (low_power ? LOW_POWER_FRAME_PERIOD : framePeriod(ANIMATION_MIN_PERIOD));
+                    scheduler_set(&timers, RENDER_TIMER_ANIMATION, scheduler_before(next, earliest) ? earliest : next);
+                    break;
+                }
+                
+                case RENDER_TIMER_SETTINGS:
+                    settings_store_commit();
+                    break;
+                    
+                case RENDER_TIMER_OVERLAY:
+                    stats_overlay_flush(current_time);
+                    break;
+                    
+                case RENDER_TIMER_MEMORY: {
+                    // Catch the smallest largest-free-block between MEM commands
+                    mem_telemetry_t mem;
+                    mem_telemetry_sample(&mem);
+                    if (MEM_TELEMETRY_REPORT_MS > 0 && current_time - last_mem_report >= MEM_TELEMETRY_REPORT_MS) {
+                        printMemStats();
+                        last_mem_report = current_time;
+                    }
+                    scheduler_set(&timers, RENDER_TIMER_MEMORY, current_time + MEM_TELEMETRY_SAMPLE_MS);
+                    break;
+                }
+                    
+                case RENDER_TIMER_SENSOR_DUMP:
+                    if (sensor_history_dump_poll()) {
+                        scheduler_set(&timers, RENDER_TIMER_SENSOR_DUMP, current_time + SENSOR_HISTORY_DUMP_RETRY_MS);
+                    }
+                    break;
+                    
+                case RENDER_TIMER_CLOCK:
+                    updateTimeDisplay();
+                    scheduler_set(&timers, RENDER_TIMER_CLOCK, current_time + CLOCK_PERIOD);
+                    break;
+                    
+                case RENDER_TIMER_LVGL: {
+                    // Hold the SPI bus until the last DMA band is out, then let touch in
+                    display_backend_lock_bus(UINT32_MAX);
+                    {
+                        PERF_SCOPE(PERF_LVGL);
+                        display_backend_begin_frame();  // Burst buffers for full-screen redraws
+                        
+                        // This slot is already paced by the frame caps, so a pending
+                        // redraw goes out now rather than at LVGL's own refresh period
+                        uint32_t refresh_start = micros();
+                        bool refreshed = lvglRedrawPending();
+                        if (refreshed) {
+                            lv_refr_now(NULL);
+                        }
+                        lv_timer_handler();
+                        display_backend_wait_idle();
+                        
+                        // Average over about four refreshes: one full-screen
+                        // frame slows the caps down for a few frames, not for good
+                        if (refreshed) {
+                            refresh_cost_us = (refresh_cost_us * 3 + (micros() - refresh_start)) / 4;
+                            latency_probe_flushed();
+                        }
+                    }
+                    display_backend_unlock_bus();
+                    last_lvgl_update = current_time;
+                    scheduler_set(&timers, RENDER_TIMER_LVGL, current_time + (low_power ? LOW_POWER_LVGL_IDLE_PERIOD : LVGL_IDLE_PERIOD));
+                    PERF_STOP(PERF_FRAME, frame_start);
+                    break;
+                }
+            }
         }
         
-        // Only re-render if sprites changed or it's been too long (forced refresh)
-        if (current_sprite_hash != last_sprite_hash || (current_time - last_animation_update) > 200) {
-            sprite_render_layers(&sprite_manager, cat_canvas, current_time);
-            last_sprite_hash = current_sprite_hash;
+        // Anything invalidated above is flushed in the next LVGL slot
+        if (lvglRedrawPending()) {
+            bool low_power = power_manager_get_mode() == POWER_MODE_LOW;
+            uint32_t earliest = key_redraw ? current_time : last_lvgl_update + (low_power ? LOW_POWER_FRAME_PERIOD : framePeriod(LVGL_MIN_PERIOD));
+            scheduler_set_earlier(&timers, RENDER_TIMER_LVGL, earliest);
         }
+        key_redraw = false;
         
-        last_animation_update = current_time;
+        // Sleep until the earliest deadline or until postEvent() wakes us
+        uint32_t wait_ms = scheduler_wait_ms(&timers, millis(), RENDER_MAX_SLEEP);
+        if (wait_ms > 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+        }
+    }
+}
+
+// Incoming serial bytes wake the I/O task (runs in the UART event task)
+static void onSerialReceive() {
+    if (io_task_handle) {
+        xTaskNotifyGive(io_task_handle);
     }
+}
+
+// Boot stage (I/O task): everything the first frame does not need. The
+// render task already animates; serial input waits in the UART buffer.
+static void bootPeripherals() {
+    // Settings live in NVS (imported from the old EEPROM record on first boot)
+    settings_store_begin();
+    readSettings(&boot_settings);
+    
+    // Initialize touch screen
+    initTouchScreen();
     
-    // Update time display every second
-    static uint32_t last_time_update = 0;
-    if (current_time - last_time_update >= 1000) {
-        updateTimeDisplay();
-        last_time_update = current_time;
+    // Initialize AHT30 sensor
+    Serial.println("🌡️ Initializing AHT30 sensor...");
+    if (aht30.begin()) {
+        aht30_initialized = true;
+        Serial.println("✅ AHT30 sensor initialized successfully!");
+    } else {
+        Serial.println("❌ AHT30 sensor initialization failed!");
     }
     
-    // Read AHT30 sensor data periodically (every 15 seconds to avoid self-heating)
-    if (aht30_initialized && (current_time - last_sensor_read >= SENSOR_READ_INTERVAL)) {
-        if (aht30.readTemperatureAndHumidity(&temperature, &humidity)) {
-            Serial.print("🌡️ Temperature: ");
-            Serial.print(temperature, 1);
-            Serial.print("°C, Humidity: ");
-            Serial.print(humidity, 1);
-            Serial.println("% (15s interval)");
-        } else {
-            Serial.println("❌ Failed to read AHT30 sensor data");
-        }
-        last_sensor_read = current_time;
+    app_event_t event;
+    event.type = APP_EVENT_BOOT;
+    postEvent(&event);
+}
+
+// A log line was queued: the I/O task writes it out (any task)
+static void onLogQueued() {
+    if (io_task_handle) {
+        xTaskNotifyGive(io_task_handle);
     }
+}
+
+// I/O task (core 0): serial, touch and sensor; never touches LVGL
+void ioTask(void* param) {
+    bootPeripherals();
+    
+    scheduler_t timers;
+    scheduler_init(&timers);
     
-    // Reduce LVGL timer handler frequency to prevent system overload
-    static uint32_t last_lvgl_update = 0;
-    if (current_time - last_lvgl_update >= 20) {  // 50 FPS max for LVGL (was every 5ms)
-        lv_timer_handler();
-        last_lvgl_update = current_time;
+    scheduler_set(&timers, IO_TIMER_TOUCH, millis());
+    if (aht30_initialized) {
+        // First reading one interval after boot (avoid self-heating)
+        scheduler_set(&timers, IO_TIMER_SENSOR, last_sensor_read + SENSOR_READ_INTERVAL);
     }
     
-    delay(2);  // Reduced from 5ms for better responsiveness
+    Serial.onReceive(onSerialReceive);
+    debug_log_set_wakeup(onLogQueued);
+    
+    for (;;) {
+        // Serial is drained on every wake: bytes, touch and sensor timers all end up here
+        {
+            PERF_SCOPE(PERF_SERIAL);
+            handleSerialCommands();
+        }
+        
+        uint32_t current_time = millis();
+        uint8_t timer;
+        
+        while (scheduler_pop_due(&timers, current_time, &timer)) {
+            switch (timer) {
+                case IO_TIMER_TOUCH: {
+                    // Read touch screen input (the library rate-limits itself)
+                    {
+                        PERF_SCOPE(PERF_TOUCH);
+                        readTouchScreen();
+                    }
+                    uint32_t delay_ms = touchScreen.nextPollDelay();
+                    scheduler_set(&timers, IO_TIMER_TOUCH, current_time + max(delay_ms, (uint32_t)IO_MIN_PERIOD));
+                    break;
+                }
+                
+                case IO_TIMER_SENSOR:
+                    if (!aht30.isMeasuring()) {
+                        // Start an AHT30 measurement periodically (every 15 seconds to avoid self-heating)
+                        aht30.startMeasurement();
+                        last_sensor_read = current_time;
+                    } else {
+                        // Collect it once the sensor is done, without waiting the 80ms conversion
+                        // (only the poll that actually reads the result is profiled)
+                        PERF_START(sensor_start);
+                        if (aht30.poll()) {
+                            readSensor();
+                            PERF_STOP(PERF_SENSOR, sensor_start);
+                        }
+                    }
+                    if (!aht30.isMeasuring()) {
+                        scheduler_set(&timers, IO_TIMER_SENSOR, last_sensor_read + SENSOR_READ_INTERVAL);
+                    } else if (current_time - last_sensor_read < AHT30_MEASUREMENT_DELAY) {
+                        // Nothing to read before the conversion time is up
+                        scheduler_set(&timers, IO_TIMER_SENSOR, last_sensor_read + AHT30_MEASUREMENT_DELAY);
+                    } else {
+                        scheduler_set(&timers, IO_TIMER_SENSOR, current_time + AHT30_POLL_INTERVAL);
+                    }
+                    break;
+                    
+                case IO_TIMER_LOG:
+                    break;  // Only here to wake us for the flush below
+            }
+        }
+        
+        // Deferred log lines, as far as the UART FIFO takes them without blocking
+        if (debug_log_flush()) {
+            scheduler_set(&timers, IO_TIMER_LOG, current_time + IO_LOG_RETRY_PERIOD);
+        }
+        
+        uint32_t wait_ms = scheduler_wait_ms(&timers, millis(), IO_MAX_SLEEP);
+        if (wait_ms > 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+        }
+    }
+}
+
+void loop() {
+    // All work happens in renderTask and ioTask
+    vTaskDelete(NULL);
 }
 
 // Touch screen functions
@@ -1024,9 +1095,6 @@ void initTouchScreen() {
         uint16_t calData[5] = { 328, 3443, 365, 3499, 3 };
         touchScreen.setCalibration(calData);
         
-        // 启用调试输出
-        touchScreen.setDebugOutput(true);
-        
         Serial.println("🔘 Touch screen ready for use!");
     } else {
         Serial.println("❌ Touch screen initialization failed!");
@@ -1034,19 +1102,38 @@ void initTouchScreen() {
 }
 
 void readTouchScreen() {
-    uint16_t x, y, pressure;
+    // Idle with no PENIRQ / presence check due: stay off the SPI bus entirely
+    if (!touchScreen.wantsBus()) return;
     
-    // 读取触摸坐标
-    if (touchScreen.readTouch(&x, &y, &pressure)) {
-        // 输出触摸坐标到串口
-        Serial.print("🔘 Touch: X=");
-        Serial.print(x);
-        Serial.print(", Y=");
-        Serial.print(y);
-        Serial.print(", Pressure: ");
-        Serial.println(pressure);
-        
-        // 可以在这里添加触摸事件处理逻辑
-        // 例如：检查触摸位置，执行相应操作
+    // Touch shares the SPI bus with the display, skip this sample if it is busy
+    if (!display_backend_lock_bus(TOUCH_BUS_TIMEOUT)) return;
+    
+    // 读取触摸事件 (down / move / up, debounced)
+    TouchEvent touch;
+    bool has_event = touchScreen.update(&touch);
+    display_backend_unlock_bus();
+    
+    if (has_event) {
+        app_event_t event;
+        event.type = APP_EVENT_TOUCH;
+        event.touch.phase = touch.type;
+        event.touch.x = touch.x;
+        event.touch.y = touch.y;
+        postEvent(&event);
+    }
+}
+
+// Pick up a finished AHT30 measurement and post it
+void readSensor() {
+    app_event_t event;
+    event.type = APP_EVENT_SENSOR;
+    event.sensor.ok = aht30.getMeasurement(&event.sensor.temperature, &event.sensor.humidity);
+    
+    if (event.sensor.ok) {
+        LOG_INFO("🌡️ Temperature: %.1f°C, Humidity: %.1f%% (15s interval)", event.sensor.temperature, event.sensor.humidity);
+    } else {
+        LOG_WARN("❌ Failed to read AHT30 sensor data");
     }
-} 
\ No newline at end of file
+    
+    postEvent(&event);
+}
@@ -0,0 +1,123 @@
+#include "mem_telemetry.h"
+#include <lvgl.h>
+#include <esp_heap_caps.h>
+#include <stdlib.h>
+
+// Size header in front of every LVGL block (8 bytes keeps the alignment)
+typedef union {
+    size_t size;
+    uint64_t align;
+} lv_block_header_t;
+
+static uint32_t lv_used = 0;
+static uint32_t lv_peak = 0;
+static uint32_t lv_blocks = 0;
+static uint32_t lv_failed = 0;
+static uint32_t heap_min_largest_free = UINT32_MAX;
+static bool peak_reset = false;
+
+static void count_alloc(size_t size) {
+    lv_used += size;
+    lv_blocks++;
+    if (lv_used > lv_peak) lv_peak = lv_used;
+}
+
+extern "C" void* mem_telemetry_lv_alloc(size_t size) {
+    lv_block_header_t* block = (lv_block_header_t*)malloc(sizeof(lv_block_header_t) + size);
+    if (!block) {
+        lv_failed++;
+        return NULL;
+    }
+    block->size = size;
+    count_alloc(size);
+    return block + 1;
+}
+
+extern "C" void mem_telemetry_lv_free(void* ptr) {
+    if (!ptr) return;
+    lv_block_header_t* block = (lv_block_header_t*)ptr - 1;
+    lv_used -= block->size;
+    lv_blocks--;
+    free(block);
+}
+
+extern "C" void* mem_telemetry_lv_realloc(void* ptr, size_t size) {
+    if (!ptr) return mem_telemetry_lv_alloc(size);
+
+    lv_block_header_t* old_block = (lv_block_header_t*)ptr - 1;
+    size_t old_size = old_block->size;
+    lv_block_header_t* block = (lv_block_header_t*)realloc(old_block, sizeof(lv_block_header_t) + size);
+    if (!block) {
+        lv_failed++;
+        return NULL;  // The old block is still valid and still counted
+    }
+
+    lv_used -= old_size;
+    lv_blocks--;
+    block->size = size;
+    count_alloc(size);
+    return block + 1;
+}
+
+void mem_telemetry_sample(mem_telemetry_t* out) {
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+
+    out->lv_static_pool = true;
+    out->lv_total = monitor.total_size;
+    out->lv_used = monitor.total_size - monitor.free_size;
+    // LVGL's max_used is exact but cannot be reset; after a reset the peak
+    // is only as good as the samples
+    if (!peak_reset) {
+        lv_peak = monitor.max_used;
+    } else if (out->lv_used > lv_peak) {
+        lv_peak = out->lv_used;
+    }
+    out->lv_peak = lv_peak;
+    out->lv_free = monitor.free_size;
+    out->lv_largest_free = monitor.free_biggest_size;
+    out->lv_frag_pct = monitor.frag_pct;
+    out->lv_blocks = monitor.used_cnt;
+    out->lv_failed = 0;
+#else
+    out->lv_static_pool = false;
+    out->lv_total = 0;
+    out->lv_used = lv_used;
+    out->lv_peak = lv_peak;
+    out->lv_free = 0;
+    out->lv_largest_free = 0;
+    out->lv_frag_pct = 0;
+    out->lv_blocks = lv_blocks;
+    out->lv_failed = lv_failed;
+#endif
+
+    out->heap_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    out->heap_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    out->heap_largest_free = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (out->heap_largest_free < heap_min_largest_free) heap_min_largest_free = out->heap_largest_free;
+    out->heap_min_largest_free = heap_min_largest_free;
+
+    out->dma_free = heap_caps_get_free_size(MALLOC_CAP_DMA);
+    out->dma_largest_free = heap_caps_get_largest_free_block(MALLOC_CAP_DMA);
+}
+
+uint32_t mem_telemetry_suggested_pool(const mem_telemetry_t* mem) {
+    // The built-in pool also needs room for its own block headers, which
+    // the custom-allocator peak does not include: the margin covers both
+    uint32_t bytes = mem->lv_peak + mem->lv_peak * MEM_TELEMETRY_POOL_MARGIN / 100;
+    bytes = (bytes + 1023) & ~1023u;   // Whole KB
+    return bytes < 2048 ? 2048 : bytes;  // LVGL's minimum pool
+}
+
+void mem_telemetry_reset_peaks() {
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    lv_peak = monitor.total_size - monitor.free_size;
+    peak_reset = true;
+#else
+    lv_peak = lv_used;
+#endif
+    heap_min_largest_free = UINT32_MAX;
+}
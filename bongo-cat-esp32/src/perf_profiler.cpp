@@ -0,0 +1,112 @@
+#include "perf_profiler.h"
+
+#if PERF_PROFILER
+
+#include <algorithm>
+
+#define RING_MASK (PERF_RING_SIZE - 1)
+
+static_assert((PERF_RING_SIZE & RING_MASK) == 0, "PERF_RING_SIZE must be a power of two");
+
+typedef struct {
+    uint16_t ring[PERF_RING_SIZE];   // Last samples in us (clamped to 65535)
+    uint32_t count;                  // Samples since reset
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t epoch;                  // reset_epoch this section was last cleared for
+} perf_stats_t;
+
+static const char* const section_names[PERF_SECTION_COUNT] = {
+    "frame", "serial", "touch", "anim", "layers", "lvgl", "flush", "sensor"
+};
+
+static perf_stats_t sections[PERF_SECTION_COUNT];
+static volatile uint32_t reset_epoch = 0;
+static uint32_t cycles_per_us = 240;
+
+static void clear_section(perf_stats_t* s, uint32_t epoch) {
+    s->count = 0;
+    s->min_us = UINT32_MAX;
+    s->max_us = 0;
+    s->total_us = 0;
+    s->epoch = epoch;
+}
+
+void perf_init() {
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    cycles_per_us = mhz ? mhz : 240;
+    for (uint8_t i = 0; i < PERF_SECTION_COUNT; i++) {
+        clear_section(&sections[i], reset_epoch);
+    }
+}
+
+void perf_record(perf_section_t section, uint32_t start_cycles) {
+    uint32_t us = (perf_now() - start_cycles) / cycles_per_us;
+    perf_stats_t* s = &sections[section];
+
+    // Only the writer clears its section, so a reset never races a sample
+    uint32_t epoch = reset_epoch;
+    if (s->epoch != epoch) {
+        clear_section(s, epoch);
+    }
+
+    s->ring[s->count & RING_MASK] = (uint16_t)(us > UINT16_MAX ? UINT16_MAX : us);
+    s->count++;
+    s->total_us += us;
+    if (us < s->min_us) s->min_us = us;
+    if (us > s->max_us) s->max_us = us;
+}
+
+void perf_dump() {
+    static uint16_t window[PERF_RING_SIZE];
+    char line[96];
+
+    snprintf(line, sizeof(line), "PERF:unit=us,window=%u,cpu_mhz=%lu", PERF_RING_SIZE, (unsigned long)cycles_per_us);
+    Serial.println(line);
+
+    for (uint8_t i = 0; i < PERF_SECTION_COUNT; i++) {
+        const perf_stats_t* s = &sections[i];
+        uint32_t count = (s->epoch == reset_epoch) ? s->count : 0;
+
+        if (count == 0) {
+            snprintf(line, sizeof(line), "PERF:%s,n=0", section_names[i]);
+            Serial.println(line);
+            continue;
+        }
+
+        // p99 over the most recent samples
+        uint32_t n = std::min<uint32_t>(count, PERF_RING_SIZE);
+        memcpy(window, s->ring, n * sizeof(window[0]));
+        uint32_t rank = (n * 99 + 99) / 100 - 1;
+        std::nth_element(window, window + rank, window + n);
+
+        snprintf(line, sizeof(line), "PERF:%s,n=%lu,min=%lu,avg=%lu,p99=%u,max=%lu",
+                 section_names[i], (unsigned long)count, (unsigned long)s->min_us,
+                 (unsigned long)(s->total_us / count), window[rank], (unsigned long)s->max_us);
+        Serial.println(line);
+    }
+}
+
+void perf_reset() {
+    reset_epoch = reset_epoch + 1;
+}
+
+void perf_set_cpu_mhz(uint32_t mhz) {
+    // Samples that straddle the change are off by the ratio, nothing worse
+    if (mhz) cycles_per_us = mhz;
+}
+
+#else
+
+void perf_init() {}
+
+void perf_dump() {
+    Serial.println("PERF:disabled");
+}
+
+void perf_reset() {}
+
+void perf_set_cpu_mhz(uint32_t) {}
+
+#endif // PERF_PROFILER
@@ -0,0 +1,83 @@
+#include "power_manager.h"
+#include "perf_profiler.h"
+#include "debug_log.h"
+
+#if POWER_LIGHT_SLEEP
+#include <esp_pm.h>
+#endif
+
+static power_mode_t mode = POWER_MODE_FULL;
+static uint8_t backlight = 0;
+static bool light_sleep = false;
+static uint32_t low_entries = 0;
+static uint32_t low_ms = 0;
+static uint32_t low_since = 0;
+
+static void set_backlight(uint8_t duty) {
+#ifdef TFT_BL
+    ledcWrite(POWER_BACKLIGHT_CHANNEL, duty);
+#endif
+    backlight = duty;
+}
+
+static void set_cpu(uint32_t mhz, bool allow_light_sleep) {
+#if POWER_LIGHT_SLEEP
+    // With power management compiled in, the PM driver owns the clock
+    esp_pm_config_esp32_t config = {};
+    config.max_freq_mhz = mhz;
+    config.min_freq_mhz = mhz;
+    config.light_sleep_enable = allow_light_sleep;
+    if (esp_pm_configure(&config) == ESP_OK) {
+        light_sleep = allow_light_sleep;
+        perf_set_cpu_mhz(mhz);
+        return;
+    }
+#endif
+    light_sleep = false;
+    setCpuFrequencyMhz(mhz);
+    perf_set_cpu_mhz(getCpuFrequencyMhz());
+}
+
+void power_manager_init() {
+#ifdef TFT_BL
+    ledcSetup(POWER_BACKLIGHT_CHANNEL, POWER_BACKLIGHT_FREQ, POWER_BACKLIGHT_BITS);
+    ledcAttachPin(TFT_BL, POWER_BACKLIGHT_CHANNEL);
+#endif
+    mode = POWER_MODE_FULL;
+    set_backlight(POWER_FULL_BACKLIGHT);
+    set_cpu(POWER_FULL_CPU_MHZ, false);
+}
+
+void power_manager_set_mode(power_mode_t new_mode) {
+    if (new_mode == mode) return;
+
+    uint32_t now = millis();
+    mode = new_mode;
+
+    if (mode == POWER_MODE_LOW) {
+        low_entries++;
+        low_since = now;
+        set_backlight(POWER_LOW_BACKLIGHT);
+        set_cpu(POWER_LOW_CPU_MHZ, true);
+        LOG_INFO("🔋 Low power mode");
+    } else {
+        low_ms += now - low_since;
+        // Clock first, so whatever woke us is handled at full speed
+        set_cpu(POWER_FULL_CPU_MHZ, false);
+        set_backlight(POWER_FULL_BACKLIGHT);
+        LOG_INFO("⚡ Full power mode");
+    }
+}
+
+power_mode_t power_manager_get_mode() {
+    return mode;
+}
+
+void power_manager_get_stats(power_stats_t* stats) {
+    stats->mode = mode;
+    stats->cpu_mhz = getCpuFrequencyMhz();
+    stats->backlight = backlight;
+    stats->light_sleep = light_sleep;
+    stats->low_entries = low_entries;
+    stats->low_ms = low_ms + (mode == POWER_MODE_LOW ? millis() - low_since : 0);
+}
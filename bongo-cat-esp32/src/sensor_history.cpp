@@ -0,0 +1,353 @@
+#include "sensor_history.h"
+#include "binary_protocol.h"
+#include <Arduino.h>
+#include <math.h>
+#include <string.h>
+
+static_assert(SENSOR_HISTORY_RAW <= 255 && SENSOR_HISTORY_MINUTES <= 255 && SENSOR_HISTORY_HOURS <= 255,
+              "tier sizes go out as one byte");
+
+// Longest dump line: "SENSOR_DATA:" + base64 of 57 bytes + newline, fits the UART FIFO
+#define DUMP_CHUNK_MAX 57
+#define DUMP_LINE_MAX (12 + DUMP_CHUNK_MAX / 3 * 4 + 1)
+
+typedef struct {
+    uint32_t time_s;
+    int16_t temp;
+    uint16_t hum;
+} raw_sample_t;
+
+typedef struct {
+    uint32_t start_s;
+    uint16_t count;
+    int16_t temp_min, temp_max, temp_mean;
+    uint16_t hum_min, hum_max, hum_mean;
+} bucket_t;
+
+// Open bucket: sums instead of means, so hours average the readings exactly
+typedef struct {
+    uint32_t start_s;
+    uint16_t count;
+    int16_t temp_min, temp_max;
+    uint16_t hum_min, hum_max;
+    int32_t temp_sum;
+    uint32_t hum_sum;
+} accumulator_t;
+
+typedef struct {
+    bucket_t* buckets;
+    uint8_t capacity;
+    uint8_t next;       // Slot the next bucket goes to
+    uint8_t count;
+} bucket_ring_t;
+
+static raw_sample_t raw_samples[SENSOR_HISTORY_RAW];
+static uint8_t raw_next = 0;
+static uint8_t raw_count = 0;
+
+static bucket_t minute_buckets[SENSOR_HISTORY_MINUTES];
+static bucket_t hour_buckets[SENSOR_HISTORY_HOURS];
+static bucket_ring_t minutes = {minute_buckets, SENSOR_HISTORY_MINUTES, 0, 0};
+static bucket_ring_t hours = {hour_buckets, SENSOR_HISTORY_HOURS, 0, 0};
+
+static accumulator_t minute_acc = {};
+static accumulator_t hour_acc = {};
+
+// Dump in progress: what goes out next, and the counts taken at the start
+typedef enum {
+    DUMP_IDLE = 0,
+    DUMP_BEGIN,
+    DUMP_DATA,
+    DUMP_END
+} dump_state_t;
+
+typedef enum {
+    SECTION_HEADER = 0,
+    SECTION_RAW,
+    SECTION_MINUTES,
+    SECTION_HOURS,
+    SECTION_DONE
+} dump_section_t;
+
+static dump_state_t dump_state = DUMP_IDLE;
+static dump_section_t dump_section;
+static uint8_t dump_index;
+static uint8_t dump_counts[3];  // Raw, minute and hour entries in the blob
+static uint32_t dump_uptime_s;
+static uint16_t dump_crc;
+
+// Newest reading that came in during a dump
+static bool held_valid = false;
+static uint32_t held_ms;
+static float held_temperature;
+static float held_humidity;
+
+static int16_t to_centi_temp(float temperature) {
+    long value = lroundf(temperature * 100.0f);
+    if (value < INT16_MIN) return INT16_MIN;
+    if (value > INT16_MAX) return INT16_MAX;
+    return (int16_t)value;
+}
+
+static uint16_t to_centi_hum(float humidity) {
+    long value = lroundf(humidity * 100.0f);
+    if (value < 0) return 0;
+    if (value > 10000) return 10000;
+    return (uint16_t)value;
+}
+
+static void accumulator_start(accumulator_t* acc, uint32_t start_s) {
+    acc->start_s = start_s;
+    acc->count = 0;
+    acc->temp_min = INT16_MAX;
+    acc->temp_max = INT16_MIN;
+    acc->hum_min = UINT16_MAX;
+    acc->hum_max = 0;
+    acc->temp_sum = 0;
+    acc->hum_sum = 0;
+}
+
+static void accumulator_add(accumulator_t* acc, int16_t temp, uint16_t hum) {
+    if (temp < acc->temp_min) acc->temp_min = temp;
+    if (temp > acc->temp_max) acc->temp_max = temp;
+    if (hum < acc->hum_min) acc->hum_min = hum;
+    if (hum > acc->hum_max) acc->hum_max = hum;
+    acc->temp_sum += temp;
+    acc->hum_sum += hum;
+    acc->count++;
+}
+
+static void accumulator_merge(accumulator_t* acc, const accumulator_t* from) {
+    if (from->temp_min < acc->temp_min) acc->temp_min = from->temp_min;
+    if (from->temp_max > acc->temp_max) acc->temp_max = from->temp_max;
+    if (from->hum_min < acc->hum_min) acc->hum_min = from->hum_min;
+    if (from->hum_max > acc->hum_max) acc->hum_max = from->hum_max;
+    acc->temp_sum += from->temp_sum;
+    acc->hum_sum += from->hum_sum;
+    acc->count += from->count;
+}
+
+// Close an accumulator into the next slot of a ring
+static void ring_push(bucket_ring_t* ring, const accumulator_t* acc) {
+    int32_t half = acc->count / 2;
+    bucket_t* bucket = &ring->buckets[ring->next];
+    bucket->start_s = acc->start_s;
+    bucket->count = acc->count;
+    bucket->temp_min = acc->temp_min;
+    bucket->temp_max = acc->temp_max;
+    bucket->temp_mean = (int16_t)((acc->temp_sum + (acc->temp_sum < 0 ? -half : half)) / acc->count);
+    bucket->hum_min = acc->hum_min;
+    bucket->hum_max = acc->hum_max;
+    bucket->hum_mean = (uint16_t)((acc->hum_sum + half) / acc->count);
+
+    ring->next = (ring->next + 1) % ring->capacity;
+    if (ring->count < ring->capacity) ring->count++;
+}
+
+// The open minute is over: store it and fold it into its hour
+static void close_minute() {
+    ring_push(&minutes, &minute_acc);
+
+    uint32_t hour_start = minute_acc.start_s - minute_acc.start_s % 3600;
+    if (hour_acc.count > 0 && hour_acc.start_s != hour_start) {
+        ring_push(&hours, &hour_acc);
+        hour_acc.count = 0;
+    }
+    if (hour_acc.count == 0) accumulator_start(&hour_acc, hour_start);
+    accumulator_merge(&hour_acc, &minute_acc);
+
+    minute_acc.count = 0;
+}
+
+void sensor_history_add(uint32_t now_ms, float temperature, float humidity) {
+    if (dump_state != DUMP_IDLE) {
+        // Keep the blob the way the BEGIN line announced it
+        held_valid = true;
+        held_ms = now_ms;
+        held_temperature = temperature;
+        held_humidity = humidity;
+        return;
+    }
+
+    uint32_t now_s = now_ms / 1000;
+    int16_t temp = to_centi_temp(temperature);
+    uint16_t hum = to_centi_hum(humidity);
+
+    raw_sample_t* sample = &raw_samples[raw_next];
+    sample->time_s = now_s;
+    sample->temp = temp;
+    sample->hum = hum;
+    raw_next = (raw_next + 1) % SENSOR_HISTORY_RAW;
+    if (raw_count < SENSOR_HISTORY_RAW) raw_count++;
+
+    uint32_t minute_start = now_s - now_s % 60;
+    if (minute_acc.count > 0 && minute_acc.start_s != minute_start) close_minute();
+    if (minute_acc.count == 0) accumulator_start(&minute_acc, minute_start);
+    accumulator_add(&minute_acc, temp, hum);
+}
+
+static uint8_t* put16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t* put32(uint8_t* p, uint32_t value) {
+    p = put16(p, (uint16_t)value);
+    return put16(p, (uint16_t)(value >> 16));
+}
+
+// Size of the record the cursor points at (0: nothing left)
+static uint8_t next_record_size() {
+    switch (dump_section) {
+        case SECTION_HEADER: return SENSOR_HISTORY_HEADER_SIZE;
+        case SECTION_RAW: return SENSOR_HISTORY_RAW_SIZE;
+        case SECTION_MINUTES:
+        case SECTION_HOURS: return SENSOR_HISTORY_BUCKET_SIZE;
+        default: return 0;
+    }
+}
+
+// Move the cursor past empty and finished sections
+static void skip_finished_sections() {
+    while (dump_section == SECTION_RAW || dump_section == SECTION_MINUTES || dump_section == SECTION_HOURS) {
+        if (dump_index < dump_counts[dump_section - SECTION_RAW]) return;
+        dump_section = (dump_section_t)(dump_section + 1);
+        dump_index = 0;
+    }
+}
+
+// Oldest-first entry i of a ring holding count entries, next slot at next
+static uint8_t ring_slot(uint8_t next, uint8_t count, uint8_t capacity, uint8_t i) {
+    return (uint8_t)((next + capacity - count + i) % capacity);
+}
+
+static uint8_t* encode_bucket(uint8_t* p, const bucket_t* bucket) {
+    p = put32(p, bucket->start_s);
+    p = put16(p, bucket->count);
+    p = put16(p, (uint16_t)bucket->temp_min);
+    p = put16(p, (uint16_t)bucket->temp_max);
+    p = put16(p, (uint16_t)bucket->temp_mean);
+    p = put16(p, bucket->hum_min);
+    p = put16(p, bucket->hum_max);
+    return put16(p, bucket->hum_mean);
+}
+
+// Encode the record at the cursor and step past it
+static uint8_t* encode_next_record(uint8_t* p) {
+    switch (dump_section) {
+        case SECTION_HEADER:
+            *p++ = SENSOR_HISTORY_MAGIC;
+            *p++ = SENSOR_HISTORY_VERSION;
+            p = put32(p, dump_uptime_s);
+            *p++ = dump_counts[0];
+            *p++ = dump_counts[1];
+            *p++ = dump_counts[2];
+            dump_section = SECTION_RAW;
+            dump_index = 0;
+            break;
+
+        case SECTION_RAW: {
+            const raw_sample_t* sample = &raw_samples[ring_slot(raw_next, raw_count, SENSOR_HISTORY_RAW, dump_index++)];
+            p = put32(p, sample->time_s);
+            p = put16(p, (uint16_t)sample->temp);
+            p = put16(p, sample->hum);
+            break;
+        }
+
+        case SECTION_MINUTES:
+        case SECTION_HOURS: {
+            const bucket_ring_t* ring = dump_section == SECTION_MINUTES ? &minutes : &hours;
+            p = encode_bucket(p, &ring->buckets[ring_slot(ring->next, ring->count, ring->capacity, dump_index++)]);
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    skip_finished_sections();
+    return p;
+}
+
+static char* base64_encode(char* out, const uint8_t* data, size_t len) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t n = (uint32_t)data[i] << 16;
+        if (i + 1 < len) n |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < len) n |= data[i + 2];
+        *out++ = alphabet[(n >> 18) & 0x3F];
+        *out++ = alphabet[(n >> 12) & 0x3F];
+        *out++ = i + 1 < len ? alphabet[(n >> 6) & 0x3F] : '=';
+        *out++ = i + 2 < len ? alphabet[n & 0x3F] : '=';
+    }
+    return out;
+}
+
+void sensor_history_dump_begin(uint32_t now_ms) {
+    dump_state = DUMP_BEGIN;
+    dump_section = SECTION_HEADER;
+    dump_index = 0;
+    dump_counts[0] = raw_count;
+    dump_counts[1] = minutes.count;
+    dump_counts[2] = hours.count;
+    dump_uptime_s = now_ms / 1000;
+    dump_crc = 0xFFFF;
+}
+
+bool sensor_history_dump_pending() {
+    return dump_state != DUMP_IDLE;
+}
+
+bool sensor_history_dump_poll() {
+    char line[DUMP_LINE_MAX + 1];
+
+    while (dump_state != DUMP_IDLE) {
+        if ((uint32_t)Serial.availableForWrite() < DUMP_LINE_MAX) return true;
+
+        int len = 0;
+        switch (dump_state) {
+            case DUMP_BEGIN: {
+                uint32_t bytes = SENSOR_HISTORY_HEADER_SIZE + dump_counts[0] * SENSOR_HISTORY_RAW_SIZE +
+                                 (dump_counts[1] + dump_counts[2]) * SENSOR_HISTORY_BUCKET_SIZE;
+                len = snprintf(line, sizeof(line), "SENSOR_DUMP:BEGIN,bytes=%lu\n", (unsigned long)bytes);
+                dump_state = DUMP_DATA;
+                break;
+            }
+
+            case DUMP_DATA: {
+                // Whole records per line, the host just joins the decoded bytes
+                uint8_t chunk[DUMP_CHUNK_MAX];
+                uint8_t* p = chunk;
+                while (next_record_size() > 0 && p + next_record_size() <= chunk + sizeof(chunk)) {
+                    p = encode_next_record(p);
+                }
+                dump_crc = binary_crc16(dump_crc, chunk, p - chunk);
+
+                memcpy(line, "SENSOR_DATA:", 12);
+                char* end = base64_encode(line + 12, chunk, p - chunk);
+                *end++ = '\n';
+                len = end - line;
+                if (dump_section == SECTION_DONE) dump_state = DUMP_END;
+                break;
+            }
+
+            case DUMP_END:
+                len = snprintf(line, sizeof(line), "SENSOR_DUMP:END,crc=%04X\n", dump_crc);
+                dump_state = DUMP_IDLE;
+                break;
+
+            default:
+                break;
+        }
+
+        // One write per line, like debug_log_flush(), so log lines land between them
+        Serial.write((const uint8_t*)line, len);
+    }
+
+    if (held_valid) {
+        held_valid = false;
+        sensor_history_add(held_ms, held_temperature, held_humidity);
+    }
+    return false;
+}
@@ -0,0 +1,126 @@
+#include "serial_command_parser.h"
+#include <string.h>
+
+#define RING_MASK (SERIAL_PARSER_RING_SIZE - 1)
+
+static_assert((SERIAL_PARSER_RING_SIZE & RING_MASK) == 0, "SERIAL_PARSER_RING_SIZE must be a power of two");
+static_assert(SERIAL_PARSER_RING_SIZE <= 32768, "SERIAL_PARSER_RING_SIZE must fit the uint16_t indices");
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+void serial_parser_init(serial_parser_t* parser) {
+    memset(parser, 0, sizeof(*parser));
+}
+
+size_t serial_parser_space(const serial_parser_t* parser) {
+    // One slot stays free to tell a full ring from an empty one
+    return RING_MASK - ((parser->head - parser->tail) & RING_MASK);
+}
+
+size_t serial_parser_feed(serial_parser_t* parser, const uint8_t* data, size_t len) {
+    size_t space = serial_parser_space(parser);
+    size_t n = (len < space) ? len : space;
+
+    for (size_t i = 0; i < n; i++) {
+        parser->ring[parser->head] = data[i];
+        parser->head = (parser->head + 1) & RING_MASK;
+    }
+
+    parser->dropped_bytes += (uint32_t)(len - n);
+    return n;
+}
+
+// Trim and split the finished line in place
+static bool tokenize(serial_parser_t* parser, serial_command_t* cmd) {
+    char* start = parser->line;
+    char* end = parser->line + parser->line_len;
+
+    while (start < end && is_space(*start)) start++;
+    while (end > start && is_space(end[-1])) end--;
+    *end = '\0';
+
+    if (start == end) return false;  // Blank line
+
+    char* colon = strchr(start, ':');
+    if (colon) {
+        *colon = '\0';
+        cmd->arg = colon + 1;
+        cmd->has_arg = true;
+    } else {
+        cmd->arg = end;  // Empty string
+        cmd->has_arg = false;
+    }
+
+    cmd->verb = start;
+    cmd->verb_hash = serial_hash(start);
+    return true;
+}
+
+bool serial_parser_next(serial_parser_t* parser, serial_command_t* cmd) {
+    while (parser->tail != parser->head) {
+        char c = (char)parser->ring[parser->tail];
+        parser->tail = (parser->tail + 1) & RING_MASK;
+
+        if (c == '\n') {
+            bool was_discarding = parser->discarding;
+            parser->discarding = false;
+
+            if (was_discarding) {
+                parser->line_len = 0;
+                continue;
+            }
+
+            bool ok = tokenize(parser, cmd);
+            parser->line_len = 0;
+            if (ok) return true;
+            continue;
+        }
+
+        if (parser->discarding) continue;
+
+        if (parser->line_len >= SERIAL_PARSER_LINE_MAX) {
+            // Too long to be a valid command: drop the rest of this line
+            parser->discarding = true;
+            parser->dropped_lines++;
+            continue;
+        }
+
+        parser->line[parser->line_len++] = c;
+    }
+
+    return false;
+}
+
+int32_t serial_parse_int(const char* s) {
+    while (is_space(*s)) s++;
+
+    bool negative = false;
+    if (*s == '-' || *s == '+') {
+        negative = (*s == '-');
+        s++;
+    }
+
+    int32_t value = 0;
+    while (*s >= '0' && *s <= '9') {
+        value = value * 10 + (*s - '0');
+        s++;
+    }
+    return negative ? -value : value;
+}
+
+const char* serial_find_field(const char* list, const char* key) {
+    size_t key_len = strlen(key);
+    const char* p = list;
+
+    while (*p) {
+        if (strncmp(p, key, key_len) == 0 && p[key_len] == ':') {
+            return p + key_len + 1;
+        }
+        const char* comma = strchr(p, ',');
+        if (!comma) break;
+        p = comma + 1;
+    }
+    return NULL;
+}
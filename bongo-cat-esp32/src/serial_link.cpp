@@ -0,0 +1,51 @@
+#include "serial_link.h"
+
+void serial_link_init(serial_link_t* link, const serial_link_handlers_t* handlers) {
+    serial_parser_init(&link->parser);
+    binary_decoder_init(&link->decoder);
+    link->binary_mode = false;
+    link->handlers = *handlers;
+}
+
+void serial_link_set_binary(serial_link_t* link, bool binary) {
+    if (binary) {
+        binary_decoder_init(&link->decoder);
+    }
+    link->binary_mode = binary;
+}
+
+// Hand out every complete line the parser holds
+static void drain_commands(serial_link_t* link) {
+    serial_command_t cmd;
+    while (serial_parser_next(&link->parser, &cmd)) {
+        link->handlers.command(&cmd, link->handlers.ctx);
+    }
+}
+
+void serial_link_feed(serial_link_t* link, uint8_t* data, size_t len) {
+    if (!link->binary_mode) {
+        serial_parser_feed(&link->parser, data, len);
+        drain_commands(link);
+        return;
+    }
+
+    // Split frames out of the stream, compacting text bytes in place
+    size_t text_len = 0;
+    for (size_t i = 0; i < len; i++) {
+        binary_frame_t frame;
+        binary_result_t result = binary_decoder_feed(&link->decoder, data[i], &frame);
+
+        if (result == BINARY_PASS) {
+            data[text_len++] = data[i];
+        } else if (result == BINARY_FRAME) {
+            // Keep ordering: text received before the frame goes first
+            serial_parser_feed(&link->parser, data, text_len);
+            text_len = 0;
+            drain_commands(link);
+            link->handlers.frame(&frame, link->handlers.ctx);
+        }
+    }
+
+    serial_parser_feed(&link->parser, data, text_len);
+    drain_commands(link);
+}
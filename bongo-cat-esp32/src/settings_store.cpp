@@ -0,0 +1,219 @@
+#include "settings_store.h"
+#include <Preferences.h>
+#include <EEPROM.h>
+#include <stddef.h>
+#include <string.h>
+
+#define NVS_NAMESPACE "bongocat"
+#define KEY_VERSION "ver"
+#define KEY_CRC "crc"
+#define STORE_VERSION 1
+
+// Pre-NVS EEPROM record (old BongoCatSettings with its byte-sum checksum)
+#define LEGACY_EEPROM_SIZE 512
+#define LEGACY_ADDRESS 0
+
+typedef struct {
+    bool show_cpu;
+    bool show_ram;
+    bool show_wpm;
+    bool show_time;
+    bool time_format_24h;
+    int sleep_timeout_minutes;
+    float animation_sensitivity;
+    uint32_t checksum;
+} legacy_settings_t;
+
+// One NVS key per field (keys are at most 15 characters)
+typedef struct {
+    const char* key;
+    uint8_t offset;
+    uint8_t size;
+} settings_field_t;
+
+#define FIELD(name, key) {key, offsetof(BongoCatSettings, name), sizeof(((BongoCatSettings*)0)->name)}
+
+static const settings_field_t fields[] = {
+    FIELD(show_cpu, "show_cpu"),
+    FIELD(show_ram, "show_ram"),
+    FIELD(show_wpm, "show_wpm"),
+    FIELD(show_time, "show_time"),
+    FIELD(time_format_24h, "time_24h"),
+    FIELD(sleep_timeout_minutes, "sleep_min"),
+    FIELD(animation_sensitivity, "sensitivity"),
+};
+
+#define FIELD_COUNT (sizeof(fields) / sizeof(fields[0]))
+
+static Preferences prefs;
+static bool opened = false;
+static BongoCatSettings stored;     // What NVS holds
+static bool stored_valid = false;
+static BongoCatSettings staged;     // Waiting for the deferred commit
+static bool pending = false;
+static uint32_t commit_deadline = 0;
+
+uint32_t settings_crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static const uint8_t* field_ptr(const BongoCatSettings* s, const settings_field_t* field) {
+    return (const uint8_t*)s + field->offset;
+}
+
+// CRC over the fields only (struct padding never reaches flash)
+static uint32_t settings_crc(const BongoCatSettings* s) {
+    uint32_t crc = 0;
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        crc = settings_crc32(crc, field_ptr(s, &fields[i]), fields[i].size);
+    }
+    return crc;
+}
+
+static uint8_t write_fields(const BongoCatSettings* s, bool only_changed) {
+    uint8_t written = 0;
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        const settings_field_t* field = &fields[i];
+        if (only_changed && memcmp(field_ptr(s, field), field_ptr(&stored, field), field->size) == 0) {
+            continue;
+        }
+        prefs.putBytes(field->key, field_ptr(s, field), field->size);
+        written++;
+    }
+
+    // Last, so a reset in the middle of the fields shows up as a CRC mismatch
+    if (written > 0 || !stored_valid) {
+        prefs.putUInt(KEY_CRC, settings_crc(s));
+    }
+
+    stored = *s;
+    stored_valid = true;
+    return written;
+}
+
+static bool read_fields(BongoCatSettings* out) {
+    BongoCatSettings temp;
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        const settings_field_t* field = &fields[i];
+        if (prefs.getBytes(field->key, (uint8_t*)&temp + field->offset, field->size) != field->size) {
+            return false;
+        }
+    }
+
+    if (!prefs.isKey(KEY_CRC) || prefs.getUInt(KEY_CRC) != settings_crc(&temp)) {
+        Serial.println("⚠️ Stored settings fail their CRC32");
+        return false;
+    }
+
+    *out = temp;
+    return true;
+}
+
+bool settings_valid(const BongoCatSettings* s) {
+    // Check if settings are within valid ranges
+    if (s->sleep_timeout_minutes < 1 || s->sleep_timeout_minutes > 60) return false;
+    if (s->animation_sensitivity < 0.1 || s->animation_sensitivity > 5.0) return false;
+    return true;
+}
+
+// Import the pre-NVS EEPROM record once
+static void migrate_from_eeprom() {
+    legacy_settings_t legacy;
+
+    EEPROM.begin(LEGACY_EEPROM_SIZE);
+    EEPROM.get(LEGACY_ADDRESS, legacy);
+    EEPROM.end();
+
+    // A zeroed record sums to its zero checksum, so it needs its own check
+    uint32_t sum = 0;
+    bool erased = legacy.checksum == 0;
+    const uint8_t* data = (const uint8_t*)&legacy;
+    for (size_t i = 0; i < sizeof(legacy) - sizeof(uint32_t); i++) {
+        sum += data[i];
+        if (data[i] != 0) erased = false;
+    }
+
+    BongoCatSettings imported;
+    bool valid = !erased && sum == legacy.checksum;
+    if (valid) {
+        imported.show_cpu = legacy.show_cpu;
+        imported.show_ram = legacy.show_ram;
+        imported.show_wpm = legacy.show_wpm;
+        imported.show_time = legacy.show_time;
+        imported.time_format_24h = legacy.time_format_24h;
+        imported.sleep_timeout_minutes = legacy.sleep_timeout_minutes;
+        imported.animation_sensitivity = legacy.animation_sensitivity;
+        valid = settings_valid(&imported);  // Same ranges the load is checked against
+    }
+
+    if (valid) {
+        write_fields(&imported, false);
+        Serial.println("📦 Settings migrated from EEPROM to NVS");
+    } else {
+        Serial.println("📦 No valid EEPROM settings to migrate");
+    }
+
+    prefs.putUChar(KEY_VERSION, STORE_VERSION);
+}
+
+void settings_store_begin() {
+    if (opened) return;
+
+    opened = prefs.begin(NVS_NAMESPACE, false);
+    if (!opened) {
+        Serial.println("❌ NVS settings namespace unavailable");
+        return;
+    }
+
+    if (prefs.getUChar(KEY_VERSION, 0) != STORE_VERSION) {
+        migrate_from_eeprom();
+    }
+
+    stored_valid = read_fields(&stored);
+}
+
+bool settings_store_load(BongoCatSettings* out) {
+    if (pending) {
+        *out = staged;
+        return true;
+    }
+    if (!stored_valid) return false;
+
+    *out = stored;
+    return true;
+}
+
+void settings_store_save(const BongoCatSettings* settings, uint32_t current_time) {
+    staged = *settings;
+    pending = true;
+    commit_deadline = current_time + SETTINGS_COMMIT_DELAY_MS;
+}
+
+bool settings_store_pending(uint32_t* deadline) {
+    if (pending && deadline) *deadline = commit_deadline;
+    return pending;
+}
+
+uint8_t settings_store_commit() {
+    if (!pending) return 0;
+    pending = false;
+
+    if (!opened) {
+        Serial.println("❌ Settings not saved: NVS unavailable");
+        return 0;
+    }
+
+    uint8_t written = write_fields(&staged, stored_valid);
+
+    Serial.print("💾 Settings committed to NVS (");
+    Serial.print(written);
+    Serial.println(" fields changed)");
+    return written;
+}
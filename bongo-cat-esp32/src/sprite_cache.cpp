@@ -0,0 +1,105 @@
+#include "sprite_cache.h"
+#include <esp_heap_caps.h>
+#include <string.h>
+
+typedef struct {
+    const lv_img_dsc_t* source;   // Flash descriptor (identity)
+    lv_img_dsc_t copy;            // Same header, data in internal RAM
+} cache_entry_t;
+
+static cache_entry_t entries[SPRITE_CACHE_MAX_ENTRIES];
+static uint8_t entry_count = 0;
+static uint32_t bytes_used = 0;
+static uint32_t budget = SPRITE_CACHE_BUDGET;
+
+static uint32_t hits = 0;
+static uint32_t misses = 0;
+static uint32_t promotions = 0;
+static uint32_t evictions = 0;
+static uint32_t rejected = 0;
+
+static cache_entry_t* find_entry(const lv_img_dsc_t* sprite) {
+    for (uint8_t i = 0; i < entry_count; i++) {
+        if (entries[i].source == sprite) return &entries[i];
+    }
+    return NULL;
+}
+
+void sprite_cache_init(uint32_t budget_bytes) {
+    sprite_cache_evict_all();
+    budget = budget_bytes;
+    sprite_cache_reset_counters();
+    evictions = 0;
+}
+
+bool sprite_cache_promote(const lv_img_dsc_t* sprite) {
+    if (!sprite) return false;
+    if (find_entry(sprite)) return true;
+
+    uint32_t size = sprite->data_size;
+    if (entry_count >= SPRITE_CACHE_MAX_ENTRIES || bytes_used + size > budget) {
+        rejected++;
+        return false;
+    }
+
+    uint8_t* data = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!data) {
+        rejected++;
+        return false;
+    }
+    memcpy(data, sprite->data, size);
+
+    cache_entry_t* entry = &entries[entry_count++];
+    entry->source = sprite;
+    entry->copy = *sprite;
+    entry->copy.data = data;
+    bytes_used += size;
+    promotions++;
+    return true;
+}
+
+uint8_t sprite_cache_promote_set(const lv_img_dsc_t* const* sprites, uint8_t count) {
+    uint8_t resident = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (sprite_cache_promote(sprites[i])) resident++;
+    }
+    return resident;
+}
+
+void sprite_cache_evict_all() {
+    for (uint8_t i = 0; i < entry_count; i++) {
+        heap_caps_free((void*)entries[i].copy.data);
+        entries[i].source = NULL;
+        evictions++;
+    }
+    entry_count = 0;
+    bytes_used = 0;
+}
+
+const lv_img_dsc_t* sprite_cache_get(const lv_img_dsc_t* sprite) {
+    cache_entry_t* entry = find_entry(sprite);
+    if (entry) {
+        hits++;
+        return &entry->copy;
+    }
+    misses++;
+    return sprite;
+}
+
+void sprite_cache_get_stats(sprite_cache_stats_t* stats) {
+    stats->hits = hits;
+    stats->misses = misses;
+    stats->promotions = promotions;
+    stats->evictions = evictions;
+    stats->rejected = rejected;
+    stats->bytes_used = bytes_used;
+    stats->budget = budget;
+    stats->entries = entry_count;
+}
+
+void sprite_cache_reset_counters() {
+    hits = 0;
+    misses = 0;
+    promotions = 0;
+    rejected = 0;
+}
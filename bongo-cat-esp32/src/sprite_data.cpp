@@ -0,0 +1,3 @@
+// The one translation unit that holds the sprite data (see animations_sprites.h)
+#define ANIMATIONS_SPRITES_DATA
+#include "animations_sprites.h"
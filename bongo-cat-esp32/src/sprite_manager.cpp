@@ -0,0 +1,427 @@
+#include "animations_sprites.h"
+#include "animation_table.h"
+#include "sprite_cache.h"
+#include "power_manager.h"
+#include "timer_scheduler.h"
+#include "cat_compositor.h"
+#include "debug_log.h"
+#include <Arduino.h>
+
+// Frames the typing loop keeps swapping, kept in internal RAM while typing
+// (most important first, in case the cache budget runs out)
+static const lv_img_dsc_t* const typing_sprites[] = {
+    &leftpawdown, &rightpawdown, &twopawsup, &left_click_effect, &right_click_effect
+};
+
+void sprite_manager_apply_speed(sprite_manager_t* manager, uint16_t speed, uint32_t current_time) {
+    // Updated thresholds to match Python script (2024 industry standards)
+    // Research shows: Average 40-45 WPM, Slow <20, Good 50-60, Professional 70+
+    animation_state_t new_state = manager->current_state;
+    
+    if (speed == 0) {
+        // Explicit stop command
+        sprite_manager_set_state(manager, ANIM_STATE_IDLE_STAGE1, current_time);
+    } else if (speed < 80) {        // Slow threshold: <20 WPM -> speed 80+
+        new_state = ANIM_STATE_TYPING_SLOW;
+    } else if (speed < 150) {       // Normal threshold: 20-40 WPM -> speed 80-150
+        new_state = ANIM_STATE_TYPING_NORMAL;
+    } else {                        // Fast threshold: 40+ WPM -> speed 150+
+        new_state = ANIM_STATE_TYPING_FAST;
+    }
+    
+    // Always refresh state to prevent stuck animations (even if same state)
+    sprite_manager_set_state(manager, new_state, current_time);
+    LOG_DEBUG("🔄 Animation state refreshed");
+    
+    // Check for significant speed changes that might cause stuck paws
+    uint16_t old_speed = manager->animation_speed_ms;
+    manager->animation_speed_ms = speed;
+    
+    // If speed changed significantly, reset paw timing to prevent stuck paws
+    if (manager->sequence_active && abs((int)speed - (int)old_speed) > 50) {
+        manager->sequence_timer = current_time;  // Reset timing
+        LOG_DEBUG("🔄 Speed change - resetting paw timing");
+    }
+    
+    // Reset Python control timeout
+    manager->last_command_time = current_time;
+    manager->python_control_mode = true;
+    manager->idle_progression_enabled = false;
+}
+
+void sprite_manager_stop(sprite_manager_t* manager, uint32_t current_time) {
+    // Explicit stop command - better than IDLE
+    sprite_manager_set_state(manager, ANIM_STATE_IDLE_STAGE1, current_time);
+    manager->idle_progression_enabled = false; // Keep disabled until IDLE_START
+    manager->python_control_mode = true;
+    manager->last_command_time = current_time;
+    LOG_DEBUG("🛑 Received STOP command");
+}
+
+// Write the layers a frame sets, keep the others
+static void applyFrame(sprite_manager_t* manager, const anim_frame_t* frame) {
+    for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+        if (frame->set_mask & LAYER_BIT(layer)) {
+            manager->current_sprites[layer] = frame->sprites[layer];
+        }
+    }
+}
+
+// Sprite a layer shows in the current state when no overlay covers it
+static const lv_img_dsc_t* restingSprite(const sprite_manager_t* manager, uint8_t layer) {
+    const anim_state_desc_t* desc = &anim_states[manager->current_state];
+    if (layer == LAYER_FACE && desc->streak_face && manager->is_streak_mode && manager->sequence_active) {
+        return desc->streak_face;
+    }
+    return desc->enter.sprites[layer];
+}
+
+// Key events are steering the paws (the rate-based sequence waits)
+static bool keyDriven(const sprite_manager_t* manager, uint32_t current_time) {
+    return manager->last_key_time != 0 && current_time - manager->last_key_time < KEY_DRIVEN_HOLD_MS;
+}
+
+// Layouts and sequence of new_state, without bookkeeping or logging
+static void enterState(sprite_manager_t* manager, animation_state_t new_state, uint32_t current_time) {
+    const anim_state_desc_t* desc = &anim_states[new_state];
+    
+    // SPEED re-enters the typing state on every stats tick: a running
+    // sequence keeps its clock instead of restarting the paw cycle each time
+    bool keep_phase = manager->sequence_active && manager->current_state == new_state;
+    
+    manager->current_state = new_state;
+    manager->state_start_time = current_time;
+    
+    applyFrame(manager, &desc->enter);
+    
+    if (desc->sequence) {
+        manager->sequence_active = true;
+        if (!keep_phase) {
+            manager->sequence_frame = 0;
+            manager->sequence_timer = current_time;
+        }
+        if (!keyDriven(manager, current_time)) {
+            applyFrame(manager, &desc->sequence->frames[manager->sequence_frame]);
+        }
+        manager->current_sprites[LAYER_FACE] = restingSprite(manager, LAYER_FACE);
+    } else {
+        manager->sequence_active = false;
+        applyFrame(manager, &desc->rest);
+    }
+}
+
+void sprite_manager_init(sprite_manager_t* manager) {
+    uint32_t now = millis();
+    
+    for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+        manager->current_sprites[layer] = NULL;
+    }
+    
+    manager->animation_speed_ms = 200;  // Default speed
+    manager->sequence_active = false;
+    manager->sequence_frame = 0;
+    manager->sequence_skipped = 0;
+    
+    // Enhanced animation control
+    manager->idle_progression_enabled = false;  // Start with Python control
+    manager->python_control_mode = true;
+    manager->last_command_time = 0;
+    manager->sleep_timeout_minutes = 5;         // Settings default, synced by the caller
+    manager->last_typing_time = 0;
+    manager->is_streak_mode = false;             // Start without streak mode
+    
+    manager->last_key_time = 0;
+    manager->strike_active = false;
+    manager->strike_time = 0;
+    manager->key_queue_head = 0;
+    manager->key_queue_count = 0;
+    manager->key_next_time = 0;
+    
+    for (uint8_t i = 0; i < ANIM_OVERLAY_COUNT; i++) {
+        manager->overlay_active[i] = false;
+        manager->overlay_start[i] = 0;
+        manager->overlay_next[i] = now + random(anim_overlays[i].interval_min_ms, anim_overlays[i].interval_max_ms);
+    }
+    
+    enterState(manager, ANIM_STATE_IDLE_STAGE1, now);
+    
+    Serial.println("🐱 Sprite manager initialized");
+}
+
+// Calculate adaptive sleep stage timing based on user's timeout setting
+static void calculateSleepStageTiming(int timeout_minutes, unsigned long* stage1_ms, unsigned long* stage2_ms, unsigned long* stage3_ms) {
+    unsigned long total_ms = (unsigned long)timeout_minutes * 60 * 1000;
+    
+    // Define minimums and maximums for each stage
+    unsigned long min_stage2 = 5000;   // 5 seconds minimum
+    unsigned long max_stage2 = 60000;  // 1 minute maximum
+    unsigned long min_stage3 = 3000;   // 3 seconds minimum  
+    unsigned long max_stage3 = 30000;  // 30 seconds maximum
+    
+    // Calculate based on timeout range for optimal user experience
+    if (timeout_minutes <= 3) {
+        // Short timeouts: quick but visible progression
+        *stage2_ms = max(min_stage2, min(max_stage2, (unsigned long)(total_ms * 0.25)));
+        *stage3_ms = max(min_stage3, min(max_stage3, (unsigned long)(total_ms * 0.15)));
+    } else if (timeout_minutes <= 10) {
+        // Medium timeouts: balanced progression
+        *stage2_ms = max(min_stage2, min(max_stage2, (unsigned long)(total_ms * 0.20)));
+        *stage3_ms = max(min_stage3, min(max_stage3, (unsigned long)(total_ms * 0.10)));
+    } else {
+        // Long timeouts: mostly normal, quick sleep transition
+        *stage2_ms = max(min_stage2, min(max_stage2, (unsigned long)(total_ms * 0.15)));
+        *stage3_ms = max(min_stage3, min(max_stage3, (unsigned long)(total_ms * 0.05)));
+    }
+    
+    // Stage 1 gets the remainder to ensure total equals user setting
+    *stage1_ms = total_ms - *stage2_ms - *stage3_ms;
+}
+
+// One key-down: put a paw down now and release it KEY_STRIKE_MS later
+static void strikePaw(sprite_manager_t* manager, bool right, uint32_t current_time) {
+    if (!(anim_states[manager->current_state].flags & ANIM_FLAG_PAWS)) {
+        sprite_manager_set_state(manager, KEY_WAKE_STATE, current_time);
+    }
+    const anim_state_desc_t* desc = &anim_states[manager->current_state];
+    
+    manager->last_key_time = current_time;
+    manager->last_typing_time = current_time;  // Keys hold off the typing timeout too
+    manager->sequence_active = true;
+    manager->sequence_timer = current_time + KEY_DRIVEN_HOLD_MS;  // Rate-based paws resume a period after the hold
+    
+    applyFrame(manager, &desc->sequence->frames[right ? ANIM_PAW_RIGHT_FRAME : ANIM_PAW_LEFT_FRAME]);
+    manager->strike_active = true;
+    manager->strike_time = current_time;
+}
+
+// Sleep stage duration an idle state waits before moving on (0: it stays)
+static unsigned long idleStageDuration(const sprite_manager_t* manager, const anim_state_desc_t* desc) {
+    if (desc->idle_stage == 0) return 0;
+    
+    unsigned long durations[3];
+    calculateSleepStageTiming(manager->sleep_timeout_minutes, &durations[0], &durations[1], &durations[2]);
+    return durations[desc->idle_stage - 1];
+}
+
+static uint32_t sequencePeriod(const sprite_manager_t* manager) {
+    const anim_state_desc_t* desc = &anim_states[manager->current_state];
+    // Trust Python's speed calculations for the paws - no additional rate limiting
+    uint32_t period = (desc->flags & ANIM_FLAG_PAWS) ? manager->animation_speed_ms : desc->sequence->period_ms;
+    return period > 0 ? period : 1;
+}
+
+void sprite_manager_update(sprite_manager_t* manager, uint32_t current_time) {
+    const anim_state_desc_t* desc = &anim_states[manager->current_state];
+    
+    // Check for typing timeout (Arduino-side safety)
+    if (manager->sequence_active && (desc->flags & ANIM_FLAG_PAWS) && manager->last_typing_time > 0) {
+        if (current_time - manager->last_typing_time > TYPING_TIMEOUT_MS) {
+            // Stop typing animation due to timeout
+            manager->sequence_active = false;
+            applyFrame(manager, &desc->rest);
+            LOG_INFO("🛑 Typing timeout - stopping animation");
+        }
+    }
+    
+    // Check if Python control has timed out
+    if (manager->python_control_mode && current_time - manager->last_command_time > PYTHON_TIMEOUT_MS) {
+        manager->python_control_mode = false;
+        manager->idle_progression_enabled = true;
+        LOG_WARN("⚠️ Python timeout - enabling auto mode");
+    }
+    
+    // Handle automatic idle progression only if enabled
+    if ((manager->idle_progression_enabled || !manager->python_control_mode) && desc->idle_stage) {
+        if (current_time - manager->state_start_time > idleStageDuration(manager, desc)) {
+            sprite_manager_set_state(manager, desc->idle_next, current_time);
+            desc = &anim_states[manager->current_state];
+        }
+    }
+    
+    // Later keys of the last batch, then the paw release
+    if (manager->key_queue_count > 0 && !scheduler_before(current_time, manager->key_next_time)) {
+        uint8_t event = manager->key_queue[manager->key_queue_head];
+        manager->key_queue_head = (manager->key_queue_head + 1) % KEY_QUEUE_SIZE;
+        manager->key_queue_count--;
+        strikePaw(manager, (event & KEY_EVENT_RIGHT) != 0, current_time);
+        if (manager->key_queue_count > 0) {
+            manager->key_next_time = current_time + (manager->key_queue[manager->key_queue_head] & KEY_EVENT_GAP_MASK);
+        }
+        desc = &anim_states[manager->current_state];
+    }
+    
+    if (manager->strike_active && current_time - manager->strike_time >= KEY_STRIKE_MS) {
+        manager->strike_active = false;
+        if (desc->flags & ANIM_FLAG_PAWS) {
+            applyFrame(manager, &desc->sequence->frames[ANIM_PAW_REST_FRAME]);
+        }
+    }
+    
+    // Step the state's frame sequence (paused while key events drive the paws).
+    // Frame n is due at sequence_timer + n periods however late the update
+    // runs, so the cadence neither drifts nor rounds up to the frame cap; an
+    // update that comes more than a period late plays the frames it missed
+    // (their layers stack) and shows the one due now.
+    if (manager->sequence_active && !keyDriven(manager, current_time)) {
+        uint32_t period = sequencePeriod(manager);
+        uint32_t steps = (current_time - manager->sequence_timer) / period;
+        
+        if (steps > 0) {
+            const anim_sequence_t* seq = desc->sequence;
+            manager->sequence_timer += steps * period;
+            manager->sequence_skipped += steps - 1;
+            
+            // Whole loops are no-ops: leave one pass through the sequence at most
+            uint8_t loop_len = seq->count - seq->loop_to;
+            if (steps > seq->count) {
+                steps = seq->count + (steps - seq->count) % loop_len;
+            }
+            while (steps-- > 0) {
+                manager->sequence_frame++;
+                if (manager->sequence_frame >= seq->count) {
+                    manager->sequence_frame = seq->loop_to;
+                }
+                applyFrame(manager, &seq->frames[manager->sequence_frame]);
+            }
+        }
+    }
+    
+    // Blinks and ear twitches
+    for (uint8_t i = 0; i < ANIM_OVERLAY_COUNT; i++) {
+        const anim_overlay_t* overlay = &anim_overlays[i];
+        bool allowed = !overlay->required_flag || (desc->flags & overlay->required_flag);
+        
+        if (!manager->overlay_active[i]) {
+            if (allowed && !scheduler_before(current_time, manager->overlay_next[i])) {
+                manager->overlay_active[i] = true;
+                manager->overlay_start[i] = current_time;
+                manager->current_sprites[overlay->layer] = overlay->sprite;
+            }
+        } else if (current_time - manager->overlay_start[i] > overlay->duration_ms) {
+            manager->overlay_active[i] = false;
+            manager->current_sprites[overlay->layer] = restingSprite(manager, overlay->layer);
+            // A state that forbids it (going to sleep) waits longer for the next one
+            if (allowed) {
+                manager->overlay_next[i] = current_time + random(overlay->interval_min_ms, overlay->interval_max_ms);
+            } else {
+                manager->overlay_next[i] = current_time + random(overlay->blocked_min_ms, overlay->blocked_max_ms);
+            }
+        }
+    }
+}
+
+static void keepEarliest(uint32_t* next, uint32_t deadline) {
+    if (scheduler_before(deadline, *next)) *next = deadline;
+}
+
+// When sprite_manager_update() next has something to do. Mirrors its checks;
+// the "> duration" comparisons there fire one ms after the deadline.
+uint32_t sprite_manager_next_deadline(const sprite_manager_t* manager, uint32_t current_time) {
+    const anim_state_desc_t* desc = &anim_states[manager->current_state];
+    uint32_t next = current_time + SPRITE_MANAGER_MAX_WAIT_MS;
+    
+    if (manager->strike_active) {
+        keepEarliest(&next, manager->strike_time + KEY_STRIKE_MS);
+    }
+    if (manager->key_queue_count > 0) {
+        keepEarliest(&next, manager->key_next_time);
+    }
+    
+    if (manager->sequence_active) {
+        if (keyDriven(manager, current_time)) {
+            keepEarliest(&next, manager->last_key_time + KEY_DRIVEN_HOLD_MS);
+        } else {
+            keepEarliest(&next, manager->sequence_timer + sequencePeriod(manager));
+        }
+        if ((desc->flags & ANIM_FLAG_PAWS) && manager->last_typing_time > 0) {
+            keepEarliest(&next, manager->last_typing_time + TYPING_TIMEOUT_MS + 1);
+        }
+    }
+    
+    if (manager->python_control_mode) {
+        keepEarliest(&next, manager->last_command_time + PYTHON_TIMEOUT_MS + 1);
+    }
+    
+    // Automatic idle progression
+    if ((manager->idle_progression_enabled || !manager->python_control_mode) && desc->idle_stage) {
+        keepEarliest(&next, manager->state_start_time + idleStageDuration(manager, desc) + 1);
+    }
+    
+    for (uint8_t i = 0; i < ANIM_OVERLAY_COUNT; i++) {
+        const anim_overlay_t* overlay = &anim_overlays[i];
+        if (manager->overlay_active[i]) {
+            keepEarliest(&next, manager->overlay_start[i] + overlay->duration_ms + 1);
+        } else if (!overlay->required_flag || (desc->flags & overlay->required_flag)) {
+            keepEarliest(&next, manager->overlay_next[i]);
+        }
+    }
+    
+    return next;
+}
+
+void sprite_manager_set_state(sprite_manager_t* manager, animation_state_t new_state, uint32_t current_time) {
+    if (new_state >= ANIM_STATE_COUNT) return;
+    
+    const anim_state_desc_t* desc = &anim_states[new_state];
+    bool had_paws = anim_states[manager->current_state].flags & ANIM_FLAG_PAWS;
+    
+    LOG_INFO("🔄 Animation state: %s → %s", get_state_name(manager->current_state), get_state_name(new_state));
+    
+    enterState(manager, new_state, current_time);
+    
+    if (desc->description) {
+        LOG_DEBUG("%s%s", desc->description, desc->streak_face && manager->is_streak_mode ? " (happy face)" : "");
+    }
+    
+    // Update typing timing for timeout tracking, and stop auto idle progression
+    if (desc->flags & ANIM_FLAG_TYPING) {
+        manager->last_typing_time = current_time;
+        manager->idle_progression_enabled = false;
+        LOG_DEBUG("🚫 Auto idle progression disabled");
+    }
+    
+    // Sleep stages run slow and dim; anything else (a SPEED command first of all) wakes us
+    power_manager_set_mode((desc->flags & ANIM_FLAG_SLEEP) ? POWER_MODE_LOW : POWER_MODE_FULL);
+    
+    // Leftover key strikes only make sense on a typing cat
+    if (!(desc->flags & ANIM_FLAG_PAWS)) {
+        manager->last_key_time = 0;
+        manager->strike_active = false;
+        manager->key_queue_count = 0;
+    }
+    
+    // Typing frames live in internal RAM while typing, idle gives the RAM back.
+    // Promote on the way in only: SPEED / STATS re-enter the typing state on
+    // every tick and would retry (and count as rejected) what did not fit.
+    if ((desc->flags & ANIM_FLAG_PAWS) && !had_paws) {
+        sprite_cache_promote_set(typing_sprites, sizeof(typing_sprites) / sizeof(typing_sprites[0]));
+    } else if (desc->flags & ANIM_FLAG_IDLE) {
+        sprite_cache_evict_all();
+    }
+}
+
+void sprite_manager_key_events(sprite_manager_t* manager, const uint8_t* events, uint8_t count, uint32_t current_time) {
+    if (count == 0) return;
+    
+    // A new batch is newer than whatever is left of the previous one
+    manager->key_queue_head = 0;
+    manager->key_queue_count = 0;
+    for (uint8_t i = 1; i < count && manager->key_queue_count < KEY_QUEUE_SIZE; i++) {
+        manager->key_queue[manager->key_queue_count++] = events[i];
+    }
+    
+    strikePaw(manager, (events[0] & KEY_EVENT_RIGHT) != 0, current_time);
+    if (manager->key_queue_count > 0) {
+        manager->key_next_time = current_time + (manager->key_queue[0] & KEY_EVENT_GAP_MASK);
+    }
+}
+
+void sprite_render_layers(sprite_manager_t* manager, lv_obj_t* canvas, uint32_t current_time) {
+    // Blend changed layers (back to front) into the pre-scaled cat frame
+    cat_compositor_render(canvas, manager->current_sprites, NUM_LAYERS);
+}
+
+// Helper function to get state name for debugging
+const char* get_state_name(animation_state_t state) {
+    return state < ANIM_STATE_COUNT ? anim_states[state].name : "UNKNOWN";
+}
@@ -0,0 +1,63 @@
+#include "sprite_rle.h"
+#include "pixel_ops.h"
+
+#define HEADER_SIZE 6
+#define PALETTE_ENTRY_SIZE 3
+#define RUN_SIZE 3
+
+bool sprite_rle_is_encoded(const lv_img_dsc_t* sprite) {
+    return sprite->header.cf == SPRITE_RLE_CF &&
+           sprite->data_size >= HEADER_SIZE &&
+           sprite->data[0] == SPRITE_RLE_MAGIC;
+}
+
+bool sprite_rle_get_bounds(const lv_img_dsc_t* sprite, lv_area_t* box) {
+    const uint8_t* data = sprite->data;
+    lv_area_set(box, data[2], data[3], data[4], data[5]);
+    return data[2] <= data[4] && data[3] <= data[5];
+}
+
+void sprite_rle_blend(const lv_img_dsc_t* sprite, lv_color_t* frame, lv_coord_t frame_w, const lv_area_t* region) {
+    const uint8_t* data = sprite->data;
+    uint8_t palette_count = data[1];
+    lv_coord_t y1 = data[3];
+    lv_coord_t y2 = data[5];
+    if (data[2] > data[4] || y1 > y2) return;
+
+    // RGB565 palette in the byte order of the raw sprite arrays
+    lv_color_t colors[256];
+    uint8_t alphas[256];
+    const uint8_t* p = data + HEADER_SIZE;
+    for (uint16_t i = 0; i < palette_count; i++, p += PALETTE_ENTRY_SIZE) {
+        colors[i].full = (uint16_t)(p[0] | (p[1] << 8));
+        alphas[i] = p[2];
+    }
+
+    const uint8_t* end = data + sprite->data_size;
+    lv_coord_t last_row = LV_MIN(y2, region->y2);
+
+    for (lv_coord_t y = y1; y <= last_row && p < end; y++) {
+        uint8_t runs = *p++;
+        const uint8_t* run = p;
+        p += runs * RUN_SIZE;
+
+        // Rows above the region are only skipped over
+        if (y < region->y1) continue;
+
+        lv_color_t* dst = &frame[y * frame_w];
+        for (uint8_t r = 0; r < runs; r++, run += RUN_SIZE) {
+            lv_coord_t x1 = LV_MAX((lv_coord_t)run[0], region->x1);
+            lv_coord_t x2 = LV_MIN((lv_coord_t)(run[0] + run[1] - 1), region->x2);
+            if (x1 > x2) continue;
+
+            lv_color_t color = colors[run[2]];
+            uint8_t a = alphas[run[2]];
+
+            if (a == LV_OPA_COVER) {
+                pixel_fill(&dst[x1], color, x2 - x1 + 1);
+            } else if (a != LV_OPA_TRANSP) {
+                for (lv_coord_t x = x1; x <= x2; x++) dst[x] = lv_color_mix(color, dst[x], a);
+            }
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#include "stats_overlay.h"
+#include <Arduino.h>
+#include "timer_scheduler.h"
+#include "glyph_strip.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    lv_obj_t* label;                        // Glyph text object or lv_label
+    glyph_text_t glyphs;
+    char shown[STATS_OVERLAY_TEXT_MAX];     // On screen (displayed in place by a label)
+    char next[STATS_OVERLAY_TEXT_MAX];      // Newest text while deferred
+    bool pending;
+    uint32_t last_redraw;
+    uint16_t interval_ms;
+} overlay_field_t;
+
+static overlay_field_t fields[STATS_FIELD_COUNT];
+static stats_overlay_stats_t counters;
+static bool use_glyphs = false;
+
+static void create_field(lv_obj_t* screen, overlay_field_t* field, const char* text, uint8_t cells,
+                         lv_align_t align, lv_coord_t x, lv_coord_t y) {
+    snprintf(field->shown, sizeof(field->shown), "%s", text);
+
+    if (use_glyphs) {
+        // Right-aligned fields keep their text against the right edge, like a label would
+        glyph_text_create(&field->glyphs, screen, cells, align == LV_ALIGN_TOP_RIGHT);
+        glyph_text_set(&field->glyphs, field->shown);
+        field->label = field->glyphs.obj;
+    } else {
+        field->label = lv_label_create(screen);
+        lv_label_set_text_static(field->label, field->shown);
+        lv_obj_set_style_text_font(field->label, &lv_font_unscii_16, 0);
+        lv_obj_set_style_text_color(field->label, lv_color_black(), 0);
+    }
+    lv_obj_align(field->label, align, x, y);
+}
+
+static void redraw(overlay_field_t* field, const char* text, uint32_t current_time) {
+    snprintf(field->shown, sizeof(field->shown), "%s", text);
+    field->pending = false;
+    field->last_redraw = current_time;
+    if (use_glyphs) {
+        counters.cells += glyph_text_set(&field->glyphs, field->shown);
+    } else {
+        lv_label_set_text_static(field->label, field->shown);  // Same buffer: LVGL re-measures it
+    }
+    counters.redraws++;
+}
+
+static void update_field(stats_field_t id, const char* text, uint32_t current_time) {
+    overlay_field_t* field = &fields[id];
+    if (!field->label) return;
+
+    counters.updates++;
+    if (strcmp(text, field->shown) == 0) {
+        // Back to what is on screen before the interval ran out: nothing to draw
+        field->pending = false;
+        counters.unchanged++;
+        return;
+    }
+
+    if (field->interval_ms > 0 && current_time - field->last_redraw < field->interval_ms) {
+        // Latest value wins once the interval is over
+        snprintf(field->next, sizeof(field->next), "%s", text);
+        field->pending = true;
+        counters.deferred++;
+        return;
+    }
+
+    redraw(field, text, current_time);
+}
+
+void stats_overlay_create(lv_obj_t* screen) {
+    fields[STATS_FIELD_CPU].interval_ms = STATS_OVERLAY_LOAD_INTERVAL_MS;
+    fields[STATS_FIELD_RAM].interval_ms = STATS_OVERLAY_LOAD_INTERVAL_MS;
+    fields[STATS_FIELD_WPM].interval_ms = STATS_OVERLAY_WPM_INTERVAL_MS;
+    fields[STATS_FIELD_TIME].interval_ms = 0;
+
+#if STATS_OVERLAY_GLYPH_STRIP
+    // Black on the white screen background
+    use_glyphs = glyph_strip_init(&lv_font_unscii_16, lv_color_black(), lv_color_white());
+    if (!use_glyphs) {
+        Serial.println("⚠️ Font does not fit the glyph strip, using labels");
+    }
+#endif
+
+    // System stats top left, time top right
+    create_field(screen, &fields[STATS_FIELD_CPU], "CPU: 0%", STATS_OVERLAY_STATS_CELLS, LV_ALIGN_TOP_LEFT, 5, 5);
+    create_field(screen, &fields[STATS_FIELD_RAM], "RAM: 0%", STATS_OVERLAY_STATS_CELLS, LV_ALIGN_TOP_LEFT, 5, 25);
+    create_field(screen, &fields[STATS_FIELD_WPM], "WPM: 0", STATS_OVERLAY_STATS_CELLS, LV_ALIGN_TOP_LEFT, 5, 45);
+    create_field(screen, &fields[STATS_FIELD_TIME], "00:00", STATS_OVERLAY_TIME_CELLS, LV_ALIGN_TOP_RIGHT, -5, 5);
+}
+
+void stats_overlay_set_stats(int cpu, int ram, int wpm, uint32_t current_time) {
+    char text[STATS_OVERLAY_TEXT_MAX];
+
+    snprintf(text, sizeof(text), "CPU: %d%%", cpu);
+    update_field(STATS_FIELD_CPU, text, current_time);
+    snprintf(text, sizeof(text), "RAM: %d%%", ram);
+    update_field(STATS_FIELD_RAM, text, current_time);
+    snprintf(text, sizeof(text), "WPM: %d", wpm);
+    update_field(STATS_FIELD_WPM, text, current_time);
+}
+
+void stats_overlay_set_time(const char* text, uint32_t current_time) {
+    update_field(STATS_FIELD_TIME, text, current_time);
+}
+
+void stats_overlay_set_visible(stats_field_t field, bool visible) {
+    lv_obj_t* label = fields[field].label;
+    if (!label) return;
+
+    // Only flag changes invalidate the label area
+    if (visible && lv_obj_has_flag(label, LV_OBJ_FLAG_HIDDEN)) {
+        lv_obj_clear_flag(label, LV_OBJ_FLAG_HIDDEN);
+    } else if (!visible && !lv_obj_has_flag(label, LV_OBJ_FLAG_HIDDEN)) {
+        lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void stats_overlay_flush(uint32_t current_time) {
+    for (uint8_t i = 0; i < STATS_FIELD_COUNT; i++) {
+        overlay_field_t* field = &fields[i];
+        if (field->pending && current_time - field->last_redraw >= field->interval_ms) {
+            redraw(field, field->next, current_time);
+        }
+    }
+}
+
+bool stats_overlay_pending(uint32_t* deadline) {
+    bool any = false;
+    uint32_t earliest = 0;
+
+    for (uint8_t i = 0; i < STATS_FIELD_COUNT; i++) {
+        const overlay_field_t* field = &fields[i];
+        if (!field->pending) continue;
+
+        uint32_t due = field->last_redraw + field->interval_ms;
+        if (!any || scheduler_before(due, earliest)) {
+            earliest = due;
+        }
+        any = true;
+    }
+
+    if (any && deadline) *deadline = earliest;
+    return any;
+}
+
+void stats_overlay_get_stats(stats_overlay_stats_t* stats) {
+    *stats = counters;
+}
+
+void stats_overlay_reset_stats() {
+    memset(&counters, 0, sizeof(counters));
+}
@@ -0,0 +1,110 @@
+#include "timer_scheduler.h"
+
+static bool earlier(const scheduler_t* sched, uint8_t a, uint8_t b) {
+    return scheduler_before(sched->deadline[sched->heap[a]], sched->deadline[sched->heap[b]]);
+}
+
+static void swap_slots(scheduler_t* sched, uint8_t a, uint8_t b) {
+    uint8_t id = sched->heap[a];
+    sched->heap[a] = sched->heap[b];
+    sched->heap[b] = id;
+    sched->slot[sched->heap[a]] = a;
+    sched->slot[sched->heap[b]] = b;
+}
+
+static void sift_up(scheduler_t* sched, uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!earlier(sched, pos, parent)) break;
+        swap_slots(sched, pos, parent);
+        pos = parent;
+    }
+}
+
+static void sift_down(scheduler_t* sched, uint8_t pos) {
+    for (;;) {
+        uint8_t left = pos * 2 + 1;
+        uint8_t right = left + 1;
+        uint8_t best = pos;
+
+        if (left < sched->count && earlier(sched, left, best)) best = left;
+        if (right < sched->count && earlier(sched, right, best)) best = right;
+        if (best == pos) return;
+
+        swap_slots(sched, pos, best);
+        pos = best;
+    }
+}
+
+// Take the entry at pos out of the heap
+static void remove_at(scheduler_t* sched, uint8_t pos) {
+    uint8_t last = --sched->count;
+    sched->slot[sched->heap[pos]] = -1;
+
+    if (pos == last) return;
+
+    sched->heap[pos] = sched->heap[last];
+    sched->slot[sched->heap[pos]] = pos;
+    sift_down(sched, pos);
+    sift_up(sched, pos);
+}
+
+void scheduler_init(scheduler_t* sched) {
+    sched->count = 0;
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TIMERS; i++) {
+        sched->slot[i] = -1;
+        sched->deadline[i] = 0;
+    }
+}
+
+void scheduler_set(scheduler_t* sched, uint8_t id, uint32_t deadline) {
+    if (id >= SCHEDULER_MAX_TIMERS) return;
+
+    sched->deadline[id] = deadline;
+
+    if (sched->slot[id] < 0) {
+        uint8_t pos = sched->count++;
+        sched->heap[pos] = id;
+        sched->slot[id] = pos;
+        sift_up(sched, pos);
+    } else {
+        // Moved either way: restore the order around it
+        uint8_t pos = sched->slot[id];
+        sift_down(sched, pos);
+        sift_up(sched, sched->slot[id]);
+    }
+}
+
+void scheduler_set_earlier(scheduler_t* sched, uint8_t id, uint32_t deadline) {
+    if (id >= SCHEDULER_MAX_TIMERS) return;
+    if (sched->slot[id] >= 0 && !scheduler_before(deadline, sched->deadline[id])) return;
+    scheduler_set(sched, id, deadline);
+}
+
+void scheduler_cancel(scheduler_t* sched, uint8_t id) {
+    if (id >= SCHEDULER_MAX_TIMERS || sched->slot[id] < 0) return;
+    remove_at(sched, sched->slot[id]);
+}
+
+bool scheduler_is_armed(const scheduler_t* sched, uint8_t id) {
+    return id < SCHEDULER_MAX_TIMERS && sched->slot[id] >= 0;
+}
+
+bool scheduler_pop_due(scheduler_t* sched, uint32_t now, uint8_t* id) {
+    if (sched->count == 0) return false;
+    if (scheduler_before(now, sched->deadline[sched->heap[0]])) return false;
+
+    *id = sched->heap[0];
+    remove_at(sched, 0);
+    return true;
+}
+
+uint32_t scheduler_wait_ms(const scheduler_t* sched, uint32_t now, uint32_t max_ms) {
+    if (sched->count == 0) return max_ms;
+
+    uint32_t next = sched->deadline[sched->heap[0]];
+    if (!scheduler_before(now, next)) return 0;
+
+    uint32_t wait = next - now;
+    return wait < max_ms ? wait : max_ms;
+}
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+"""
+Latency Bench - Replay synthetic typing bursts and measure key-to-flush latency
+
+Stands in for the desktop app: every key (or SPEED update) is sent right
+after a SEQ:<id> line, which makes the firmware stamp it and answer, once
+its effect has gone out to the panel, with
+
+    ACK:<id>,<parse us>,<state us>,<flush us>
+
+(see bongo-cat-esp32/include/latency_probe.h). parse is the device clock
+when the command was parsed, state and flush are measured from there; flush
+is 0 when the command changed no pixels. The host side adds the round trip
+from sending the command to reading its ack.
+
+For each WPM level the script types bursts of keys at that rate (with some
+jitter and a pause between bursts) and reports percentiles of
+
+    rtt          host send -> ack read
+    parse>state  device: command parsed -> applied to the animation state
+    parse>flush  device: command parsed -> refresh flushed over SPI
+    key>flush    estimate: parse>flush + half the link time (rtt - parse>flush),
+                 i.e. assuming the up and down links take the same time
+
+plus commands that were never acked (dropped) and acks without a redraw.
+
+Usage:
+    python latency_bench.py                          # auto-detect, KEYS frames
+    python latency_bench.py /dev/ttyUSB0 --wpm 60,120,200 --keys 300
+    python latency_bench.py COM5 --mode speed        # SPEED lines instead
+"""
+import argparse
+import math
+import random
+import re
+import sys
+import threading
+import time
+
+import serial
+import serial.tools.list_ports
+
+BAUD_RATE = 115200
+
+# Binary framing (bongo-cat-esp32/include/binary_protocol.h)
+FRAME_START = 0xA5
+FRAME_TYPE_KEYS = 0x02
+KEY_RIGHT = 0x80
+
+ACK_RE = re.compile(r"^ACK:(\d+),(\d+),(\d+),(\d+)$")
+
+
+def find_esp32_port():
+    """Auto-detect an ESP32 serial port"""
+    print("🔍 Scanning for ESP32...")
+
+    esp32_ports = []
+    for port in serial.tools.list_ports.comports():
+        if any(keyword in port.description.lower() for keyword in
+               ['cp210', 'ch340', 'ch341', 'usb serial', 'usb-serial', 'uart', 'usb uart']):
+            esp32_ports.append(port.device)
+            print(f"  📍 Found: {port.device} ({port.description})")
+
+    if not esp32_ports:
+        print("❌ No ESP32 ports found!")
+        return None
+
+    if len(esp32_ports) > 1:
+        # A benchmark should not guess: name the port explicitly
+        print("❌ Multiple ports found, pass one as the first argument")
+        return None
+
+    print(f"✅ Auto-selected: {esp32_ports[0]}")
+    return esp32_ports[0]
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)"""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode_frame(frame_type, payload):
+    body = bytes([len(payload), frame_type]) + payload
+    crc = crc16(body)
+    return bytes([FRAME_START]) + body + bytes([crc & 0xFF, crc >> 8])
+
+
+def encode_key(right):
+    """KEYS frame with a single key-down"""
+    return encode_frame(FRAME_TYPE_KEYS, bytes([KEY_RIGHT if right else 0]))
+
+
+class AckReader(threading.Thread):
+    """Reads device lines, keeps ACKs with the host time they arrived"""
+
+    def __init__(self, port):
+        super().__init__(daemon=True)
+        self.port = port
+        self.acks = {}
+        self.lines = []
+        self.lock = threading.Lock()
+        self.running = True
+
+    def run(self):
+        buffer = b""
+        while self.running:
+            chunk = self.port.read(self.port.in_waiting or 1)
+            now = time.perf_counter()
+            if not chunk:
+                continue
+            buffer += chunk
+            while b"\n" in buffer:
+                raw, buffer = buffer.split(b"\n", 1)
+                line = raw.decode("utf-8", errors="replace").strip()
+                match = ACK_RE.match(line)
+                with self.lock:
+                    if match:
+                        seq, parse_us, state_us, flush_us = (int(v) for v in match.groups())
+                        self.acks[seq] = (now, parse_us, state_us, flush_us)
+                    else:
+                        self.lines.append(line)
+
+    def wait_for_line(self, text, timeout):
+        deadline = time.perf_counter() + timeout
+        while time.perf_counter() < deadline:
+            with self.lock:
+                if text in self.lines:
+                    return True
+            time.sleep(0.01)
+        return False
+
+
+def percentile(values, p):
+    """Nearest-rank percentile of a sorted list"""
+    if not values:
+        return float("nan")
+    rank = max(1, math.ceil(p / 100.0 * len(values)))
+    return values[min(rank, len(values)) - 1]
+
+
+def key_intervals(wpm, keys, rng, jitter, burst_min, burst_max, pause):
+    """Gaps before each key: bursts typed at wpm (5 keys per word), pauses between"""
+    mean = 60.0 / (wpm * 5)
+    gaps = []
+    left_in_burst = rng.randint(burst_min, burst_max)
+    for _ in range(keys):
+        if left_in_burst == 0:
+            gaps.append(rng.uniform(pause * 0.5, pause * 1.5))
+            left_in_burst = rng.randint(burst_min, burst_max)
+        else:
+            gaps.append(max(0.005, rng.gauss(mean, mean * jitter)))
+        left_in_burst -= 1
+    return gaps
+
+
+def run_level(port, reader, args, wpm, rng, first_seq):
+    gaps = key_intervals(wpm, args.keys, rng, args.jitter, args.burst_min, args.burst_max, args.pause)
+    sent = {}
+    seq = first_seq
+
+    next_send = time.perf_counter() + 0.2
+    for gap in gaps:
+        next_send += gap
+        while time.perf_counter() < next_send:
+            time.sleep(min(0.001, max(0.0, next_send - time.perf_counter())))
+
+        if args.mode == "keys":
+            command = encode_key(rng.random() < 0.5)
+        else:
+            command = f"SPEED:{wpm}\n".encode()
+
+        # One write, so the SEQ line and its command reach the device together
+        packet = f"SEQ:{seq}\n".encode() + command
+        sent[seq] = time.perf_counter()
+        port.write(packet)
+        seq += 1
+
+    # Give the last acks time to arrive
+    deadline = time.perf_counter() + args.timeout
+    while time.perf_counter() < deadline:
+        with reader.lock:
+            if all(s in reader.acks for s in sent):
+                break
+        time.sleep(0.01)
+
+    with reader.lock:
+        acks = {s: reader.acks[s] for s in sent if s in reader.acks}
+
+    rtt, state, flush, key_flush = [], [], [], []
+    no_redraw = 0
+    for s, (rx, _parse_us, state_us, flush_us) in acks.items():
+        round_trip = (rx - sent[s]) * 1000.0
+        rtt.append(round_trip)
+        state.append(state_us / 1000.0)
+        if flush_us == 0:
+            no_redraw += 1
+            continue
+        device = flush_us / 1000.0
+        flush.append(device)
+        key_flush.append(device + max(0.0, round_trip - device) / 2)
+
+    return {
+        "wpm": wpm,
+        "sent": len(sent),
+        "acked": len(acks),
+        "no_redraw": no_redraw,
+        "rtt": sorted(rtt),
+        "state": sorted(state),
+        "flush": sorted(flush),
+        "key_flush": sorted(key_flush),
+    }, seq
+
+
+def print_level(result):
+    dropped = result["sent"] - result["acked"]
+    rate = 100.0 * dropped / result["sent"] if result["sent"] else 0.0
+    print(f"\n⌨️  {result['wpm']} WPM: {result['sent']} sent, {dropped} dropped ({rate:.1f}%), "
+          f"{result['no_redraw']} without redraw")
+    print(f"   {'ms':<12}{'p50':>8}{'p90':>8}{'p99':>8}{'max':>8}")
+    for name, key in (("rtt", "rtt"), ("parse>state", "state"),
+                      ("parse>flush", "flush"), ("key>flush", "key_flush")):
+        values = result[key]
+        row = "".join(f"{percentile(values, p):8.2f}" for p in (50, 90, 99, 100))
+        print(f"   {name:<12}{row}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay typing bursts and report key-to-flush latency")
+    parser.add_argument("port", nargs="?", help="serial port (auto-detected if omitted)")
+    parser.add_argument("--baud", type=int, default=BAUD_RATE)
+    parser.add_argument("--wpm", default="40,80,120,160",
+                        help="comma-separated typing rates to replay (default: %(default)s)")
+    parser.add_argument("--keys", type=int, default=200, help="keys per WPM level (default: %(default)s)")
+    parser.add_argument("--mode", choices=("keys", "speed"), default="keys",
+                        help="send KEYS frames (needs PROTO:BIN) or SPEED lines (default: %(default)s)")
+    parser.add_argument("--jitter", type=float, default=0.3,
+                        help="spread of the key interval, relative to its mean (default: %(default)s)")
+    parser.add_argument("--burst-min", type=int, default=5, help="shortest burst in keys (default: %(default)s)")
+    parser.add_argument("--burst-max", type=int, default=25, help="longest burst in keys (default: %(default)s)")
+    parser.add_argument("--pause", type=float, default=0.8,
+                        help="mean pause between bursts in seconds (default: %(default)s)")
+    parser.add_argument("--timeout", type=float, default=1.0,
+                        help="seconds to wait for the last acks of a level (default: %(default)s)")
+    parser.add_argument("--seed", type=int, default=1, help="random seed, for repeatable runs")
+    args = parser.parse_args()
+
+    try:
+        levels = [int(v) for v in args.wpm.split(",") if v.strip()]
+    except ValueError:
+        parser.error("--wpm takes comma-separated integers")
+    if not levels or min(levels) <= 0:
+        parser.error("--wpm needs at least one rate above 0")
+    if args.burst_min < 1 or args.burst_max < args.burst_min:
+        parser.error("need 1 <= --burst-min <= --burst-max")
+
+    port_name = args.port or find_esp32_port()
+    if not port_name:
+        return 1
+
+    print(f"🔌 Connecting to {port_name} at {args.baud} baud...")
+    try:
+        port = serial.Serial(port_name, args.baud, timeout=0.05)
+    except serial.SerialException as e:
+        print(f"❌ Could not open {port_name}: {e}")
+        return 1
+
+    time.sleep(2)  # The ESP32 resets when the port opens
+    port.reset_input_buffer()
+
+    reader = AckReader(port)
+    reader.start()
+
+    try:
+        if args.mode == "keys":
+            port.write(b"PROTO:BIN\n")
+            if not reader.wait_for_line("PROTO:BIN_OK", 2.0):
+                print("❌ No PROTO:BIN_OK - is the firmware built with binary framing?")
+                return 1
+            port.write(b"PROTO:KEYS\n")
+            if not reader.wait_for_line("PROTO:KEYS_OK", 2.0):
+                print("❌ No PROTO:KEYS_OK - firmware does not take KEYS frames")
+                return 1
+
+        # Probe check: a SEQ'd PING must come back as an ack
+        port.write(b"SEQ:0\nPING\n")
+        if not reader.wait_for_line("PONG", 2.0):
+            print("⚠️  No PONG from the device")
+        deadline = time.perf_counter() + 1.0
+        while 0 not in reader.acks and time.perf_counter() < deadline:
+            time.sleep(0.01)
+        if 0 not in reader.acks:
+            print("❌ No ACK for SEQ:0 - firmware built with LATENCY_PROBE=0?")
+            return 1
+
+        rng = random.Random(args.seed)
+        seq = 1
+        results = []
+        for wpm in levels:
+            print(f"▶️  Replaying {args.keys} keys at {wpm} WPM...")
+            result, seq = run_level(port, reader, args, wpm, rng, seq)
+            results.append(result)
+            time.sleep(0.5)  # Let the cat settle between levels
+
+        print("\n📊 Latency (ms)")
+        print("=" * 48)
+        for result in results:
+            print_level(result)
+    except KeyboardInterrupt:
+        print("\n👋 Cancelled by user")
+    finally:
+        reader.running = False
+        if args.mode == "keys":
+            port.write(b"PROTO:TEXT\n")
+        reader.join(timeout=0.5)
+        port.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,327 @@
+#!/usr/bin/env python3
+"""
+Pack Sprites - Build the run-length encoded sprite atlas for the ESP32 firmware
+
+Reads the 64x64 indexed PNG frames exported from "Sprites/bongocat all.ase"
+(one file per sprite under Sprites/<layer>/) and writes
+animations/atlas/sprite_atlas.c, which defines the same lv_img_dsc_t symbols
+as the raw animations/*/*.c files but as LV_IMG_CF_USER_ENCODED_0 blobs.
+
+Blob layout (decoded by bongo-cat-esp32/src/sprite_rle.cpp):
+
+    [magic 'R'] [palette count N] [x1] [y1] [x2] [y2]
+    N x [color lo] [color hi] [alpha]          RGB565, same bytes as the raw .c
+    for every row y1..y2:
+        [run count R] R x [x] [length] [palette index]
+
+Only visible pixels are stored: transparent pixels are simply not covered by
+any run. A fully transparent sprite has x1 > x2 and no rows.
+
+Usage:
+    python pack_sprites.py            # write the atlas
+    python pack_sprites.py --verify   # also check it against animations/*/*.c
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+REPO_ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+SPRITES_DIR = os.path.join(REPO_ROOT, "Sprites")
+ANIMATIONS_DIR = os.path.join(REPO_ROOT, "animations")
+ATLAS_PATH = os.path.join(ANIMATIONS_DIR, "atlas", "sprite_atlas.c")
+
+SPRITE_SIZE = 64
+MAGIC = ord("R")
+MAX_PALETTE = 255
+
+# Sprites/<dir> -> animations/<dir>, in back-to-front layer order
+LAYER_DIRS = [
+    ("body", "body"),
+    ("face", "faces"),
+    ("table", "table"),
+    ("paws", "paws"),
+    ("effects", "effects"),
+]
+
+
+def read_png(path):
+    """Decode an 8-bit palette PNG into (width, height, rgba rows)"""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError(f"{path}: not a PNG file")
+
+    pos = 8
+    idat = b""
+    palette = []
+    trns = b""
+    width = height = 0
+
+    while pos < len(data):
+        length, tag = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+
+        if tag == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+            if depth != 8 or color_type != 3 or interlace != 0:
+                raise ValueError(f"{path}: expected a non-interlaced 8-bit indexed PNG "
+                                 "(export from Aseprite with Color Mode: Indexed)")
+        elif tag == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, length, 3)]
+        elif tag == b"tRNS":
+            trns = body
+        elif tag == b"IDAT":
+            idat += body
+
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(width)
+    offset = 0
+
+    for _ in range(height):
+        filter_type = raw[offset]
+        line = bytearray(raw[offset + 1:offset + 1 + width])
+        offset += 1 + width
+
+        # Undo the per-row PNG filter (1 byte per pixel)
+        for x in range(width):
+            left = line[x - 1] if x else 0
+            up = prev[x]
+            up_left = prev[x - 1] if x else 0
+            if filter_type == 1:
+                line[x] = (line[x] + left) & 0xFF
+            elif filter_type == 2:
+                line[x] = (line[x] + up) & 0xFF
+            elif filter_type == 3:
+                line[x] = (line[x] + (left + up) // 2) & 0xFF
+            elif filter_type == 4:
+                p = left + up - up_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+                pred = left if pa <= pb and pa <= pc else (up if pb <= pc else up_left)
+                line[x] = (line[x] + pred) & 0xFF
+
+        rows.append([palette[i] + (trns[i] if i < len(trns) else 255,) for i in line])
+        prev = line
+
+    return width, height, rows
+
+
+def rgb565(r, g, b):
+    """Round to RGB565 the same way the LVGL image converter does"""
+    r5 = min((r + 4) >> 3, 31)
+    g6 = min((g + 2) >> 2, 63)
+    b5 = min((b + 4) >> 3, 31)
+    return (r5 << 11) | (g6 << 5) | b5
+
+
+def to_pixels(rows):
+    """RGBA rows -> rows of (rgb565, alpha), transparent pixels as None"""
+    return [[(rgb565(r, g, b), a) if a else None for (r, g, b, a) in row] for row in rows]
+
+
+def encode_sprite(pixels):
+    """Encode one sprite as a palette + per-row runs blob"""
+    palette = []
+    index = {}
+    for row in pixels:
+        for px in row:
+            if px is not None and px not in index:
+                index[px] = len(palette)
+                palette.append(px)
+
+    if len(palette) > MAX_PALETTE:
+        raise ValueError(f"too many colors ({len(palette)} > {MAX_PALETTE})")
+
+    visible = [(x, y) for y, row in enumerate(pixels) for x, px in enumerate(row) if px is not None]
+    if visible:
+        x1 = min(x for x, _ in visible)
+        x2 = max(x for x, _ in visible)
+        y1 = min(y for _, y in visible)
+        y2 = max(y for _, y in visible)
+    else:
+        x1, y1, x2, y2 = 1, 1, 0, 0
+
+    blob = bytearray([MAGIC, len(palette), x1, y1, x2, y2])
+    for color, alpha in palette:
+        blob += bytes([color & 0xFF, color >> 8, alpha])
+
+    for y in range(y1, y2 + 1):
+        runs = []
+        x = x1
+        while x <= x2:
+            px = pixels[y][x]
+            if px is None:
+                x += 1
+                continue
+            start = x
+            while x <= x2 and pixels[y][x] == px:
+                x += 1
+            runs.append((start, x - start, index[px]))
+
+        blob.append(len(runs))
+        for run in runs:
+            blob += bytes(run)
+
+    return bytes(blob)
+
+
+def decode_sprite(blob):
+    """Reference decoder, mirrors sprite_rle.cpp (used by --verify)"""
+    pixels = [[None] * SPRITE_SIZE for _ in range(SPRITE_SIZE)]
+    count, x1, y1, x2, y2 = blob[1:6]
+    pos = 6
+    palette = []
+    for _ in range(count):
+        palette.append((blob[pos] | (blob[pos + 1] << 8), blob[pos + 2]))
+        pos += 3
+
+    if x1 > x2:
+        return pixels
+
+    for y in range(y1, y2 + 1):
+        runs = blob[pos]
+        pos += 1
+        for _ in range(runs):
+            x, length, i = blob[pos:pos + 3]
+            pos += 3
+            for n in range(length):
+                pixels[y][x + n] = palette[i]
+    return pixels
+
+
+def read_lvgl_c(path):
+    """Pixels of a raw LV_IMG_CF_RGB565A8 .c file, for verification"""
+    with open(path) as f:
+        text = f.read()
+    body = text.split("_map[] = {", 1)[1].split("};", 1)[0]
+    data = bytes(int(v, 16) for v in re.findall(r"0x([0-9a-fA-F]{2})", body))
+
+    plane = SPRITE_SIZE * SPRITE_SIZE
+    pixels = []
+    for y in range(SPRITE_SIZE):
+        row = []
+        for x in range(SPRITE_SIZE):
+            i = y * SPRITE_SIZE + x
+            alpha = data[plane * 2 + i]
+            row.append((data[2 * i] | (data[2 * i + 1] << 8), alpha) if alpha else None)
+        pixels.append(row)
+    return pixels
+
+
+def find_sprites():
+    """All exported sprite PNGs as (name, sprite dir, animations dir, path)"""
+    sprites = []
+    for sprite_dir, anim_dir in LAYER_DIRS:
+        folder = os.path.join(SPRITES_DIR, sprite_dir)
+        if not os.path.isdir(folder):
+            continue
+        for file in sorted(os.listdir(folder)):
+            if file.lower().endswith(".png"):
+                name = os.path.splitext(file)[0]
+                sprites.append((name, sprite_dir, anim_dir, os.path.join(folder, file)))
+    return sprites
+
+
+def format_blob(name, blob):
+    lines = []
+    for i in range(0, len(blob), 16):
+        lines.append("  " + ", ".join(f"0x{b:02x}" for b in blob[i:i + 16]) + ",")
+    attr = f"LV_ATTRIBUTE_IMG_{name.upper()}"
+    return (f"#ifndef {attr}\n#define {attr}\n#endif\n\n"
+            f"const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST {attr} uint8_t {name}_map[] = {{\n"
+            + "\n".join(lines) + "\n};\n\n"
+            f"const lv_img_dsc_t {name} = {{\n"
+            f"  {{LV_IMG_CF_USER_ENCODED_0, 0, 0, {SPRITE_SIZE}, {SPRITE_SIZE}}},  // header: {{cf, always_zero, reserved, w, h}}\n"
+            f"  {len(blob)},\n"
+            f"  {name}_map,\n"
+            "};\n")
+
+
+def write_atlas(entries):
+    header = ("// Generated by python_scripts/pack_sprites.py - do not edit.\n"
+              "// Run-length encoded sprites, decoded by bongo-cat-esp32/src/sprite_rle.cpp\n\n"
+              "#ifdef __has_include\n"
+              "    #if __has_include(\"lvgl.h\")\n"
+              "        #ifndef LV_LVGL_H_INCLUDE_SIMPLE\n"
+              "            #define LV_LVGL_H_INCLUDE_SIMPLE\n"
+              "        #endif\n"
+              "    #endif\n"
+              "#endif\n\n"
+              "#if defined(LV_LVGL_H_INCLUDE_SIMPLE)\n"
+              "    #include \"lvgl.h\"\n"
+              "#else\n"
+              "    #include \"lvgl/lvgl.h\"\n"
+              "#endif\n\n"
+              "#ifndef LV_ATTRIBUTE_MEM_ALIGN\n"
+              "#define LV_ATTRIBUTE_MEM_ALIGN\n"
+              "#endif\n\n")
+
+    os.makedirs(os.path.dirname(ATLAS_PATH), exist_ok=True)
+    with open(ATLAS_PATH, "w", newline="\n") as f:
+        f.write(header)
+        for name, blob in entries:
+            f.write(f"// {name}\n")
+            f.write(format_blob(name, blob))
+            f.write("\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack sprite PNGs into the firmware sprite atlas")
+    parser.add_argument("--verify", action="store_true",
+                        help="check every sprite against its raw animations/*/*.c data")
+    args = parser.parse_args()
+
+    sprites = find_sprites()
+    if not sprites:
+        print(f"❌ No sprite PNGs found under {SPRITES_DIR}")
+        return 1
+
+    print(f"🎨 Packing {len(sprites)} sprites...")
+    entries = []
+    raw_total = 0
+    packed_total = 0
+    failed = False
+
+    for name, sprite_dir, anim_dir, path in sprites:
+        width, height, rows = read_png(path)
+        if (width, height) != (SPRITE_SIZE, SPRITE_SIZE):
+            print(f"❌ {sprite_dir}/{name}: {width}x{height}, expected {SPRITE_SIZE}x{SPRITE_SIZE}")
+            return 1
+
+        pixels = to_pixels(rows)
+        blob = encode_sprite(pixels)
+
+        if decode_sprite(blob) != pixels:
+            print(f"❌ {sprite_dir}/{name}: round trip mismatch")
+            failed = True
+
+        if args.verify:
+            raw_path = os.path.join(ANIMATIONS_DIR, anim_dir, name + ".c")
+            if not os.path.exists(raw_path):
+                print(f"⚠️ {sprite_dir}/{name}: no raw {anim_dir}/{name}.c to verify against")
+            elif read_lvgl_c(raw_path) != pixels:
+                print(f"❌ {sprite_dir}/{name}: differs from {anim_dir}/{name}.c")
+                failed = True
+
+        raw_size = SPRITE_SIZE * SPRITE_SIZE * 3
+        raw_total += raw_size
+        packed_total += len(blob)
+        entries.append((name, blob))
+        print(f"   {sprite_dir}/{name}: {raw_size} -> {len(blob)} bytes")
+
+    if failed:
+        return 1
+
+    write_atlas(entries)
+    print(f"✅ {raw_total} -> {packed_total} bytes ({100.0 * packed_total / raw_total:.1f}%)")
+    print(f"📁 Wrote {os.path.relpath(ATLAS_PATH, REPO_ROOT)}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())